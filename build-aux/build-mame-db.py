@@ -0,0 +1,277 @@
+#!/usr/bin/env python3
+"""
+Utility script to compile mame_roms.json into the binary table read by MAMELoader.
+The layout is documented in src/main/loaders/MAMERomDatabase.h; both must be kept in sync.
+Games are sorted by name so the loader can binary search them straight out of the mapped
+file, and rom group attributes are sorted by key with their hex values pre-parsed.
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import struct
+import sys
+from dataclasses import dataclass, field
+from pathlib import Path
+
+MAGIC = b"VGMTMDB\0"
+VERSION = 1
+
+HEADER = struct.Struct("<8sIIQIIIIIII")
+STRING_REF = struct.Struct("<II")
+GAME = struct.Struct("<IIIIIIII")
+ROM_GROUP = struct.Struct("<IIIIBBHIIII")
+ATTRIBUTE = struct.Struct("<IIIIII")
+
+ATTRIBUTE_HAS_HEX = 1
+
+LOAD_METHODS = {
+    "append": 0,
+    "append_swap16": 1,
+    "deinterlace": 2,
+    "deinterlace_pairs": 3,
+}
+LOAD_ORDERS = {"normal": 0, "": 0, "reverse": 1}
+RESERVED_KEYS = {"type", "load_method", "load_order", "roms", "encryption", "attributes"}
+
+
+class DatabaseError(Exception):
+    pass
+
+
+@dataclass(slots=True)
+class RomGroup:
+    type: str
+    encryption: str
+    load_method: int
+    load_order: int
+    attributes: dict[str, str]
+    roms: list[str]
+
+
+@dataclass(slots=True)
+class Game:
+    name: str
+    format: str
+    fmt_version: str
+    rom_groups: list[RomGroup] = field(default_factory=list)
+
+
+def parse_argv() -> argparse.Namespace:
+    parser = argparse.ArgumentParser(
+        description="Compile the MAME ROM definition JSON into its binary form."
+    )
+    parser.add_argument(
+        "--input", required=True, type=Path, help="Path to mame_roms.json"
+    )
+    parser.add_argument(
+        "--output", required=True, type=Path, help="Path of the binary database to write"
+    )
+    return parser.parse_args()
+
+
+def fnv1a64(data: bytes) -> int:
+    value = 0xCBF29CE484222325
+    for byte in data:
+        value = ((value ^ byte) * 0x100000001B3) & 0xFFFFFFFFFFFFFFFF
+    return value
+
+
+def json_to_string(value: object) -> str:
+    if isinstance(value, str):
+        return value
+    if value is None:
+        return ""
+    return json.dumps(value, separators=(",", ":"), ensure_ascii=False)
+
+
+def parse_hex(text: str) -> int:
+    """Mirrors strtoul(text, nullptr, 16) truncated to 32 bits."""
+    text = text.lstrip(" \t\n\v\f\r")
+    negative = text.startswith("-")
+    if text and text[0] in "+-":
+        text = text[1:]
+    if text[:2].lower() == "0x" and len(text) > 2 and text[2] in "0123456789abcdefABCDEF":
+        text = text[2:]
+    digits = ""
+    for ch in text:
+        if ch not in "0123456789abcdefABCDEF":
+            break
+        digits += ch
+    value = min(int(digits, 16) if digits else 0, 0xFFFFFFFFFFFFFFFF)
+    if negative:
+        value = -value & 0xFFFFFFFFFFFFFFFF
+    return value & 0xFFFFFFFF
+
+
+def parse_rom_group(group: object, game_name: str) -> RomGroup:
+    def fail(reason: str) -> DatabaseError:
+        return DatabaseError(f"game '{game_name}': {reason}")
+
+    if not isinstance(group, dict):
+        raise fail("rom group is not an object")
+    if not isinstance(group.get("type"), str) or not isinstance(group.get("load_method"), str):
+        raise fail("rom group lacks a 'type' or 'load_method' string")
+    if group["load_method"] not in LOAD_METHODS:
+        raise fail(f"unknown load method '{group['load_method']}'")
+
+    load_order = group.get("load_order", "normal")
+    if not isinstance(load_order, str) or load_order not in LOAD_ORDERS:
+        raise fail(f"invalid load order {load_order!r}")
+
+    encryption = group.get("encryption", "")
+    if not isinstance(encryption, str):
+        raise fail("'encryption' is not a string")
+
+    attributes: dict[str, str] = {}
+    if isinstance(group.get("attributes"), dict):
+        for key, value in group["attributes"].items():
+            attributes[key] = json_to_string(value)
+    for key, value in group.items():
+        if key in RESERVED_KEYS or isinstance(value, (dict, list)):
+            continue
+        attributes[key] = json_to_string(value)
+
+    roms = group.get("roms")
+    if not isinstance(roms, list) or not roms or not all(isinstance(rom, str) for rom in roms):
+        raise fail("'roms' must be a non-empty array of strings")
+
+    return RomGroup(
+        type=group["type"],
+        encryption=encryption,
+        load_method=LOAD_METHODS[group["load_method"]],
+        load_order=LOAD_ORDERS[load_order],
+        attributes=attributes,
+        roms=roms,
+    )
+
+
+def parse_games(document: object) -> list[Game]:
+    games = document
+    if isinstance(document, dict):
+        games = document.get("games")
+    if not isinstance(games, list):
+        raise DatabaseError("the JSON does not contain a 'games' array")
+
+    by_name: dict[str, Game] = {}
+    for entry in games:
+        if not isinstance(entry, dict):
+            raise DatabaseError("game entry is not an object")
+        if not isinstance(entry.get("name"), str) or not isinstance(entry.get("format"), str):
+            raise DatabaseError("game entry lacks a 'name' or 'format' string")
+        fmt_version = entry.get("fmt_version")
+        game = Game(
+            name=entry["name"],
+            format=entry["format"],
+            fmt_version=fmt_version if isinstance(fmt_version, str) else "",
+        )
+        if not isinstance(entry.get("rom_groups"), list):
+            raise DatabaseError(f"game '{game.name}': 'rom_groups' must be an array")
+        game.rom_groups = [parse_rom_group(group, game.name) for group in entry["rom_groups"]]
+        # Later entries replace earlier ones with the same name, as they do in MAMELoader
+        by_name[game.name] = game
+
+    return sorted(by_name.values(), key=lambda game: game.name.encode())
+
+
+class StringPool:
+    def __init__(self) -> None:
+        self.data = bytearray()
+        self.offsets: dict[bytes, int] = {}
+
+    def add(self, text: str) -> tuple[int, int]:
+        encoded = text.encode()
+        offset = self.offsets.get(encoded)
+        if offset is None:
+            offset = len(self.data)
+            self.offsets[encoded] = offset
+            self.data += encoded
+        return offset, len(encoded)
+
+
+def build_database(games: list[Game], source: bytes) -> bytes:
+    strings = StringPool()
+    game_table = bytearray()
+    group_table = bytearray()
+    attribute_table = bytearray()
+    rom_table = bytearray()
+    group_count = attribute_count = rom_count = 0
+
+    for game in games:
+        game_table += GAME.pack(
+            *strings.add(game.name),
+            *strings.add(game.format),
+            *strings.add(game.fmt_version),
+            group_count,
+            len(game.rom_groups),
+        )
+        for group in game.rom_groups:
+            attributes = sorted(group.attributes.items(), key=lambda item: item[0].encode())
+            group_table += ROM_GROUP.pack(
+                *strings.add(group.type),
+                *strings.add(group.encryption),
+                group.load_method,
+                group.load_order,
+                0,
+                attribute_count,
+                len(attributes),
+                rom_count,
+                len(group.roms),
+            )
+            group_count += 1
+
+            for key, value in attributes:
+                flags = ATTRIBUTE_HAS_HEX if value else 0
+                hex_value = parse_hex(value) if value else 0
+                attribute_table += ATTRIBUTE.pack(
+                    *strings.add(key), *strings.add(value), hex_value, flags
+                )
+                attribute_count += 1
+
+            for rom in group.roms:
+                rom_table += STRING_REF.pack(*strings.add(rom))
+                rom_count += 1
+
+    games_offset = HEADER.size
+    groups_offset = games_offset + len(game_table)
+    attributes_offset = groups_offset + len(group_table)
+    roms_offset = attributes_offset + len(attribute_table)
+    strings_offset = roms_offset + len(rom_table)
+
+    header = HEADER.pack(
+        MAGIC,
+        VERSION,
+        len(source),
+        fnv1a64(source),
+        len(games),
+        games_offset,
+        groups_offset,
+        attributes_offset,
+        roms_offset,
+        strings_offset,
+        len(strings.data),
+    )
+    return header + game_table + group_table + attribute_table + rom_table + strings.data
+
+
+def main() -> int:
+    args = parse_argv()
+
+    source = args.input.read_bytes()
+    try:
+        games = parse_games(json.loads(source))
+    except (json.JSONDecodeError, DatabaseError) as error:
+        print(f"{args.input}: {error}", file=sys.stderr)
+        return 1
+
+    database = build_database(games, source)
+    args.output.parent.mkdir(parents=True, exist_ok=True)
+    temp_output = args.output.with_name(args.output.name + ".tmp")
+    temp_output.write_bytes(database)
+    temp_output.replace(args.output)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -11,6 +11,7 @@
 #include "Format.h"
 #include "Helper.h"
 #include "LoaderManager.h"
+#include "LogItem.h"
 #include "LogManager.h"
 #include "Matcher.h"
 #include "Scanner.h"
@@ -23,6 +24,7 @@
 #include "VGMSamp.h"
 #include "VGMSampColl.h"
 #include "VGMSeq.h"
+#include "util/Parallel.h"
 
 #include <cassert>
 #include <filesystem>
@@ -36,6 +38,21 @@
 
 VGMRoot *pRoot;
 
+// Everything a scanner handed to VGMRoot while running on a worker thread, in call order.
+// Replaying the entries on the loading thread reproduces the effects of a serial scan.
+struct VGMRoot::PendingScanResults {
+  struct VGMFileLoad {
+    std::unique_ptr<VGMFile> file;
+    bool useMatcher;
+  };
+  using Entry = std::variant<VGMFileLoad, std::unique_ptr<VGMColl>, std::unique_ptr<RawFile>, LogItem>;
+
+  std::vector<Entry> entries;
+};
+
+thread_local VGMRoot::PendingScanResults *VGMRoot::s_pendingScanResults = nullptr;
+thread_local std::vector<LogItem> *VGMRoot::s_logCapture = nullptr;
+
 VGMRoot::VGMRoot() = default;
 VGMRoot::~VGMRoot() = default;
 
@@ -89,6 +106,14 @@ bool VGMRoot::createVirtFile(const u8 *databuf, u32 fileSize, const std::string&
   return loadRawFile(std::make_unique<VirtFile>(databuf, fileSize, filename, parRawFileFullPath, tag));
 }
 
+/* Creates a new file that takes ownership of databuf */
+bool VGMRoot::createVirtFile(std::vector<u8>&& databuf, const std::string& filename,
+                             const std::filesystem::path &parRawFileFullPath, const VGMTag& tag) {
+  assert(!databuf.empty());
+
+  return loadRawFile(std::make_unique<VirtFile>(std::move(databuf), filename, parRawFileFullPath, tag));
+}
+
 // Applies loaders and scanners to a rawfile, loading any discovered files
 // returns true if files were discovered
 bool VGMRoot::loadRawFile(std::unique_ptr<RawFile> newRawFile) {
@@ -96,12 +121,17 @@ bool VGMRoot::loadRawFile(std::unique_ptr<RawFile> newRawFile) {
     return false;
   }
 
+  if (s_pendingScanResults) {
+    // Nested load from a scanner worker; it is loaded once the scan is committed
+    s_pendingScanResults->entries.emplace_back(std::move(newRawFile));
+    return false;
+  }
+
   RawFile* rawFile = newRawFile.get();
   pushLoadRawFile();
   if (rawFile->useLoaders()) {
     for (const auto &l : LoaderManager::get().loaders()) {
-      l->apply(rawFile);
-      auto res = l->results();
+      auto res = l->load(rawFile);
 
       /* If the loader extracted anything, we shouldn't have to scan */
       if (!res.empty()) {
@@ -122,19 +152,9 @@ bool VGMRoot::loadRawFile(std::unique_ptr<RawFile> newRawFile) {
     auto specific_scanners =
       ScannerManager::get().scannersWithExtension(rawFile->extension());
     if (!specific_scanners.empty()) {
-      for (const auto &scanner : specific_scanners) {
-        scanner->scan(rawFile);
-        if (auto matcher = scanner->format()->matcher.get()) {
-          matcher->onFinishedScan(rawFile);
-        }
-      }
+      runScanners(rawFile, specific_scanners);
     } else {
-      for (const auto &scanner : ScannerManager::get().scanners()) {
-        scanner->scan(rawFile);
-        if (auto matcher = scanner->format()->matcher.get()) {
-          matcher->onFinishedScan(rawFile);
-        }
-      }
+      runScanners(rawFile, ScannerManager::get().scanners());
     }
   }
 
@@ -149,6 +169,68 @@ bool VGMRoot::loadRawFile(std::unique_ptr<RawFile> newRawFile) {
   return foundFiles;
 }
 
+// Runs each scanner over the file and notifies its format's matcher afterwards. When scanning
+// with multiple threads, consecutive scanners that can scan concurrently are run as a batch
+// and their results committed in order; any other scanner runs alone on this thread.
+void VGMRoot::runScanners(RawFile *rawFile, std::span<const std::shared_ptr<VGMScanner>> scanners) {
+  auto finishScan = [rawFile](const VGMScanner &scanner) {
+    if (auto matcher = scanner.format()->matcher.get()) {
+      matcher->onFinishedScan(rawFile);
+    }
+  };
+
+  size_t batchStart = 0;
+  while (batchStart < scanners.size()) {
+    size_t batchEnd = batchStart;
+    if (m_scanThreadCount > 1) {
+      while (batchEnd < scanners.size() && scanners[batchEnd]->canScanConcurrently()) {
+        ++batchEnd;
+      }
+    }
+
+    if (batchEnd - batchStart < 2) {
+      const auto &scanner = scanners[batchStart++];
+      scanner->scan(rawFile);
+      finishScan(*scanner);
+      continue;
+    }
+
+    auto batch = scanners.subspan(batchStart, batchEnd - batchStart);
+    std::vector<PendingScanResults> results(batch.size());
+    vgmtrans::parallelFor(batch.size(), m_scanThreadCount, [&](size_t i) {
+      s_pendingScanResults = &results[i];
+      try {
+        batch[i]->scan(rawFile);
+      } catch (...) {
+        s_pendingScanResults = nullptr;
+        throw;
+      }
+      s_pendingScanResults = nullptr;
+    });
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+      commitScanResults(results[i]);
+      finishScan(*batch[i]);
+    }
+    batchStart = batchEnd;
+  }
+}
+
+void VGMRoot::commitScanResults(PendingScanResults &results) {
+  for (auto &entry : results.entries) {
+    if (auto load = std::get_if<PendingScanResults::VGMFileLoad>(&entry)) {
+      sinkVGMFile(std::move(load->file), load->useMatcher);
+    } else if (auto coll = std::get_if<std::unique_ptr<VGMColl>>(&entry)) {
+      sinkVGMColl(std::move(*coll));
+    } else if (auto rawFile = std::get_if<std::unique_ptr<RawFile>>(&entry)) {
+      loadRawFile(std::move(*rawFile));
+    } else if (auto logItem = std::get_if<LogItem>(&entry)) {
+      UI_log(logItem);
+    }
+  }
+  results.entries.clear();
+}
+
 bool VGMRoot::removeRawFile(RawFile *rawfile) {
   if (!rawfile)
     return false;
@@ -194,6 +276,12 @@ void VGMRoot::sinkVGMFile(std::unique_ptr<VGMFile>&& file, bool useMatcher) {
     return;
   }
 
+  if (s_pendingScanResults) {
+    s_pendingScanResults->entries.emplace_back(
+        PendingScanResults::VGMFileLoad{std::move(file), useMatcher});
+    return;
+  }
+
   auto discoveredFiles = file->releaseDiscoveredFiles();
   for (auto& discoveredFile : discoveredFiles) {
     sinkVGMFile(std::move(discoveredFile), useMatcher);
@@ -271,6 +359,11 @@ void VGMRoot::sinkVGMColl(std::unique_ptr<VGMColl>&& coll) {
     return;
   }
 
+  if (s_pendingScanResults) {
+    s_pendingScanResults->entries.emplace_back(std::move(coll));
+    return;
+  }
+
   auto* rawColl = coll.get();
   m_vgmcolls.push_back(rawColl);
   UI_addVGMColl(rawColl);
@@ -301,11 +394,41 @@ void VGMRoot::removeVGMColl(VGMColl *coll) {
 }
 
 void VGMRoot::removeAllFilesAndCollections() {
+  detachAllFilesAndCollections();
+}
+
+VGMRoot::DetachedFiles::DetachedFiles() = default;
+
+VGMRoot::DetachedFiles::DetachedFiles(DetachedFiles &&other) noexcept = default;
+
+VGMRoot::DetachedFiles::~DetachedFiles() {
+  clear();
+}
+
+VGMRoot::DetachedFiles &VGMRoot::DetachedFiles::operator=(DetachedFiles &&other) noexcept {
+  if (this != &other) {
+    clear();
+    colls = std::move(other.colls);
+    vgmFiles = std::move(other.vgmFiles);
+    rawFiles = std::move(other.rawFiles);
+  }
+  return *this;
+}
+
+void VGMRoot::DetachedFiles::clear() noexcept {
+  colls.clear();
+  vgmFiles.clear();
+  rawFiles.clear();
+}
+
+VGMRoot::DetachedFiles VGMRoot::detachAllFilesAndCollections() {
+  DetachedFiles detached;
   pushRemoveAll();
 
   for (auto vgmcoll : m_vgmcolls)
     UI_removeVGMColl(vgmcoll);
   m_vgmcolls.clear();
+  detached.colls = std::move(m_ownedVGMColls);
   m_ownedVGMColls.clear();
 
   for (auto variant : m_vgmfiles) {
@@ -316,14 +439,17 @@ void VGMRoot::removeAllFilesAndCollections() {
     UI_removeVGMFile(vgmfile);
   }
   m_vgmfiles.clear();
+  detached.vgmFiles = std::move(m_ownedVGMFiles);
   m_ownedVGMFiles.clear();
 
   for (auto rawfile: m_rawfiles)
     UI_removeRawFile(rawfile);
   m_rawfiles.clear();
+  detached.rawFiles = std::move(m_ownedRawFiles);
   m_ownedRawFiles.clear();
 
   popRemoveAll();
+  return detached;
 }
 
 void VGMRoot::pushLoadRawFile() {
@@ -411,9 +537,25 @@ bool VGMRoot::UI_writeBufferToFile(const std::filesystem::path &filepath, u8 *bu
 
 // Adds a log item to the interface. The UI_AddLog function will handle the interface-specific stuff
 void VGMRoot::log(LogItem *theLog) {
+  if (s_logCapture) {
+    s_logCapture->push_back(*theLog);
+    return;
+  }
+  if (s_pendingScanResults) {
+    s_pendingScanResults->entries.emplace_back(*theLog);
+    return;
+  }
   UI_log(theLog);
 }
 
+VGMRoot::LogCapture::LogCapture(std::vector<LogItem> &items) noexcept
+    : m_previous(std::exchange(s_logCapture, &items)) {
+}
+
+VGMRoot::LogCapture::~LogCapture() {
+  s_logCapture = m_previous;
+}
+
 std::filesystem::path VGMRoot::UI_getResourceDirPath() {
 #if defined(__APPLE__)
   std::filesystem::path resDir = (std::filesystem::current_path() / ".." / "Resources").lexically_normal();
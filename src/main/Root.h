@@ -9,6 +9,7 @@
 #include "components/VGMFileVariant.h"
 #include "VGMTag.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <memory>
 #include <span>
@@ -51,6 +52,8 @@ public:
   virtual bool openRawFile(const std::filesystem::path& filePath);
   bool createVirtFile(const u8* databuf, u32 fileSize, const std::string& filename,
                       const std::filesystem::path& parRawFileFullPath = {}, const VGMTag& tag = VGMTag());
+  bool createVirtFile(std::vector<u8>&& databuf, const std::string& filename,
+                      const std::filesystem::path& parRawFileFullPath = {}, const VGMTag& tag = VGMTag());
   bool loadRawFile(std::unique_ptr<RawFile> newRawFile);
   bool removeRawFile(RawFile *targFile);
   bool loadVGMFile(std::unique_ptr<VGMFile> file, bool useMatcher = true);
@@ -84,6 +87,32 @@ public:
   void removeVGMColl(VGMColl *coll);
   void removeAllFilesAndCollections();
 
+  // Ownership of everything that was loaded into the root. Collections must be freed before the
+  // files they reference, and VGMFiles before the RawFiles they read from (~RawFile asserts
+  // it), so every way of releasing the members goes through clear().
+  struct DetachedFiles {
+    DetachedFiles();
+    DetachedFiles(DetachedFiles &&other) noexcept;
+    DetachedFiles &operator=(DetachedFiles &&other) noexcept;
+    ~DetachedFiles();
+
+    void clear() noexcept;
+
+    std::vector<std::unique_ptr<VGMColl>> colls;
+    std::vector<std::unique_ptr<VGMFile>> vgmFiles;
+    std::vector<std::unique_ptr<RawFile>> rawFiles;
+  };
+  // Removes all files and collections from the root like removeAllFilesAndCollections(), but
+  // hands them to the caller instead of destroying them. They can then be used (and freed) on
+  // another thread while the root loads more files.
+  DetachedFiles detachAllFilesAndCollections();
+
+  // Number of threads loadRawFile() uses to run scanners over a file. With more than one
+  // thread, files loaded by each scanner are buffered and committed in scanner order once the
+  // scan finishes, so results match a serial scan.
+  void setScanThreadCount(unsigned count) { m_scanThreadCount = std::max(1u, count); }
+  unsigned scanThreadCount() const { return m_scanThreadCount; }
+
   void pushLoadRawFile();
   void popLoadRawFile();
   void pushRemoveRawFiles();
@@ -97,6 +126,20 @@ public:
 
   void log(LogItem *theLog);
 
+  // Collects the log items reported on the calling thread while alive, instead of handing them
+  // to the UI, which may only use them after the reporting call returns. Work run on worker
+  // threads logs into one of these, and the calling thread replays the items with log()
+  class LogCapture {
+   public:
+    explicit LogCapture(std::vector<LogItem> &items) noexcept;
+    ~LogCapture();
+    LogCapture(const LogCapture &) = delete;
+    LogCapture &operator=(const LogCapture &) = delete;
+
+   private:
+    std::vector<LogItem> *m_previous;
+  };
+
   virtual std::filesystem::path UI_getResourceDirPath();
   virtual void UI_setRootPtr(VGMRoot **theRoot) = 0;
   virtual void UI_loadRawFile(RawFile *) {}
@@ -136,11 +179,23 @@ public:
   std::span<VGMColl* const> vgmColls() const { return m_vgmcolls; }
 
 private:
+  struct PendingScanResults;
+
+  void runScanners(RawFile *rawFile, std::span<const std::shared_ptr<VGMScanner>> scanners);
+  void commitScanResults(PendingScanResults& results);
+
+  // Set on scanner worker threads: VGMRoot calls made by the scanner are buffered here
+  static thread_local PendingScanResults *s_pendingScanResults;
+  // Set while a LogCapture is alive on the thread
+  static thread_local std::vector<LogItem> *s_logCapture;
+
+  unsigned m_scanThreadCount = 1;
   int rawFileLoadRecurseStack = 0;
   int rawFileRemoveStack = 0;
   int vgmFileRemoveStack = 0;
   int vgmCollRemoveStack = 0;
 
+  // Members are destroyed in reverse order: collections, then VGMFiles, then RawFiles
   std::vector<std::unique_ptr<RawFile>> m_ownedRawFiles;
   std::vector<RawFile *> m_rawfiles;
   std::vector<std::unique_ptr<VGMFile>> m_ownedVGMFiles;
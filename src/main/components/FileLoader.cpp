@@ -1,17 +1,23 @@
 #include "FileLoader.h"
 
-#include <algorithm>
-#include <ranges>
+#include <cassert>
+#include <utility>
 
-std::vector<std::unique_ptr<RawFile>> FileLoader::results() {
-  std::vector<std::unique_ptr<RawFile>> res;
+namespace {
+// Results of the load() call in progress on this thread
+thread_local std::vector<std::unique_ptr<RawFile>> *s_results = nullptr;
+}
 
-  if (!m_res.empty()) {
-    res.reserve(m_res.size());
-    std::ranges::move(m_res, std::back_inserter(res));
-    m_res.clear();
+std::vector<std::unique_ptr<RawFile>> FileLoader::load(const RawFile *file) const {
+  std::vector<std::unique_ptr<RawFile>> res;
+  auto *previous = std::exchange(s_results, &res);
+  try {
+    apply(file);
+  } catch (...) {
+    s_results = previous;
+    throw;
   }
-
+  s_results = previous;
   return res;
 }
 
@@ -20,7 +26,8 @@ void FileLoader::enqueue(RawFile* file) {
 }
 
 void FileLoader::enqueue(std::unique_ptr<RawFile> file) {
-  if (file) {
-    m_res.emplace_back(std::move(file));
+  assert(s_results && "FileLoader::enqueue called outside of FileLoader::load");
+  if (file && s_results) {
+    s_results->emplace_back(std::move(file));
   }
 }
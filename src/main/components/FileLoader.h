@@ -2,20 +2,22 @@
 
 #include "RawFile.h"
 
-#include <deque>
 #include <memory>
 #include <vector>
 
+// Loaders are created once per session and shared by every load, possibly from several threads.
+// apply() must therefore keep no state in the loader itself: the files it extracts go to
+// enqueue(), which collects them for the load() call in progress on the calling thread.
 class FileLoader {
    public:
     virtual ~FileLoader() = default;
-    virtual void apply(const RawFile *) = 0;
-    [[nodiscard]] std::vector<std::unique_ptr<RawFile>> results();
+
+    // Runs the loader over a file and returns the files it extracted from it
+    [[nodiscard]] std::vector<std::unique_ptr<RawFile>> load(const RawFile *file) const;
 
    protected:
-    void enqueue(RawFile* file);
-    void enqueue(std::unique_ptr<RawFile> file);
+    virtual void apply(const RawFile *) const = 0;
 
-   private:
-    std::deque<std::unique_ptr<RawFile>> m_res;
+    static void enqueue(RawFile* file);
+    static void enqueue(std::unique_ptr<RawFile> file);
 };
@@ -0,0 +1,53 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+#include "ItemArena.h"
+
+#include <algorithm>
+
+thread_local ItemArena::Cursor ItemArena::s_cursor;
+
+ItemArena *ItemArena::current() noexcept {
+  return s_cursor.arena;
+}
+
+void *ItemArena::allocate(size_t size) {
+  size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  auto &cursor = s_cursor;
+  if (size > static_cast<size_t>(cursor.end - cursor.next)) {
+    cursor.arena->refill(cursor, size);
+  }
+  void *ptr = cursor.next;
+  cursor.next += size;
+  return ptr;
+}
+
+void ItemArena::refill(Cursor &cursor, size_t size) {
+  std::lock_guard lock(m_mutex);
+  // Whatever is left of the scope's current chunk is abandoned
+  const size_t chunkSize = std::max(m_nextChunkSize, size);
+  m_nextChunkSize = std::min(m_nextChunkSize * 2, MAX_CHUNK_SIZE);
+
+  auto &chunk = m_chunks.emplace_back(new std::byte[chunkSize]);
+  cursor.next = chunk.get();
+  cursor.end = chunk.get() + chunkSize;
+}
+
+const std::string *ItemArena::intern(std::string_view name) {
+  std::lock_guard lock(m_mutex);
+  if (auto it = m_names.find(name); it != m_names.end()) {
+    return &*it;
+  }
+  return &*m_names.emplace(name).first;
+}
+
+ItemArena::Scope::Scope(ItemArena *arena) noexcept : m_previous(s_cursor) {
+  s_cursor = Cursor{arena};
+}
+
+ItemArena::Scope::~Scope() {
+  s_cursor = m_previous;
+}
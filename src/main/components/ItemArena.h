@@ -0,0 +1,81 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+// Monotonic arena backing the VGMItems of a VGMFile.
+// VGMFile::load() activates an ItemArena::Scope for the file's arena, and every VGMItem allocated
+// on that thread meanwhile (headers, tracks, events, instruments...) is bump-allocated from it
+// instead of the global heap (see VGMItem::operator new), and its name is interned in the arena.
+// Item destructors still run one by one,
+// but their memory is only given back, in whole chunks, when the last file sharing the arena is
+// destroyed.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+class ItemArena : public std::enable_shared_from_this<ItemArena> {
+ private:
+  // Arena and free space of the calling thread's innermost scope
+  struct Cursor {
+    ItemArena *arena = nullptr;
+    std::byte *next = nullptr;
+    std::byte *end = nullptr;
+  };
+
+ public:
+  static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+
+  ItemArena() = default;
+  ItemArena(const ItemArena &) = delete;
+  ItemArena &operator=(const ItemArena &) = delete;
+
+  // Arena that VGMItems allocated on this thread come from, or null for the global heap
+  [[nodiscard]] static ItemArena *current() noexcept;
+  // Bump-allocates from the current arena. Only valid while a Scope is active on this thread
+  [[nodiscard]] static void *allocate(size_t size);
+
+  // Copy of the string shared by every item of this arena with the same name, which lives as
+  // long as the arena
+  [[nodiscard]] const std::string *intern(std::string_view name);
+
+  // Routes the calling thread's item allocations to an arena, or to the global heap if null,
+  // until destroyed. Every scope bumps through chunks of its own
+  class Scope {
+   public:
+    explicit Scope(ItemArena *arena) noexcept;
+    ~Scope();
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+   private:
+    Cursor m_previous;
+  };
+
+ private:
+  static constexpr size_t MIN_CHUNK_SIZE = 2 * 1024;
+  static constexpr size_t MAX_CHUNK_SIZE = 1024 * 1024;
+
+  static thread_local Cursor s_cursor;
+
+  struct NameHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view str) const { return std::hash<std::string_view>{}(str); }
+  };
+
+  void refill(Cursor &cursor, size_t size);
+
+  std::mutex m_mutex;
+  std::vector<std::unique_ptr<std::byte[]>> m_chunks;
+  size_t m_nextChunkSize = MIN_CHUNK_SIZE;
+  // Elements of an unordered_set never move, so interned names stay put
+  std::unordered_set<std::string, NameHash, std::equal_to<>> m_names;
+};
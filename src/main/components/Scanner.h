@@ -16,8 +16,15 @@ class VGMScanner {
   virtual ~VGMScanner() = default;
 
   virtual bool init();
+  // A single instance of each scanner serves every file for the whole session (see
+  // ScannerManager), so scan must not keep per-file state in the scanner
   virtual void scan(RawFile *file, void *offset = nullptr) = 0;
 
+  // Whether this scanner may run concurrently with other scanners over the same RawFile.
+  // Scanners that inspect files loaded by earlier scanners (e.g. via
+  // RawFile::containedVGMFiles) must return false so they only see fully committed results.
+  virtual bool canScanConcurrently() const { return true; }
+
   Format* format() const { return m_format; }
 
 protected:
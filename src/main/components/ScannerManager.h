@@ -6,6 +6,8 @@
 #include <functional>
 #include <initializer_list>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -29,32 +31,60 @@ class ScannerManager final {
     m_generators.emplace(format_name, std::move(gen));
   }
 
-  void addExtensionBinding(const char *ext, scannerSpawner gen) {
-    m_generators_ext[ext].emplace_back(std::move(gen));
+  // Binds an extension to the scanner registered under format_name
+  void addExtensionBinding(const char *ext, const char *format_name) {
+    m_generators_ext[ext].emplace_back(format_name);
   }
 
-  std::vector<std::shared_ptr<VGMScanner>> scanners() const {
-    std::vector<std::shared_ptr<VGMScanner>> tmp(m_generators.size());
-    std::ranges::transform(m_generators, tmp.begin(), [](auto pair) { return pair.second(); });
-
-    return tmp;
+  // Every registered scanner. Scanners are spawned once on first use and then shared by every
+  // scan, so VGMScanner::scan must not keep per-file state in the scanner
+  std::span<const std::shared_ptr<VGMScanner>> scanners() const {
+    return instances().all;
   }
 
-  std::vector<std::shared_ptr<VGMScanner>> scannersWithExtension(const std::string& ext) const {
-    std::vector<std::shared_ptr<VGMScanner>> tmp;
-    if (auto vec = m_generators_ext.find(ext); vec != m_generators_ext.end()) {
-      tmp.resize(vec->second.size());
-      std::ranges::transform(vec->second, tmp.begin(), [](auto spawner) { return spawner(); });
+  std::span<const std::shared_ptr<VGMScanner>> scannersWithExtension(const std::string& ext) const {
+    const auto &byExtension = instances().byExtension;
+    if (auto vec = byExtension.find(ext); vec != byExtension.end()) {
+      return vec->second;
     }
 
-    return tmp;
+    return {};
   }
 
  private:
   ScannerManager() = default;
 
+  struct Instances {
+    std::vector<std::shared_ptr<VGMScanner>> all;
+    std::unordered_map<std::string, std::vector<std::shared_ptr<VGMScanner>>> byExtension;
+  };
+
+  const Instances &instances() const {
+    std::call_once(m_spawnOnce, [this] {
+      std::unordered_map<std::string, std::shared_ptr<VGMScanner>> byFormat;
+      m_instances.all.reserve(m_generators.size());
+      for (const auto &[formatName, spawner] : m_generators) {
+        auto &scanner = m_instances.all.emplace_back(spawner());
+        byFormat.emplace(formatName, scanner);
+      }
+
+      for (const auto &[ext, formatNames] : m_generators_ext) {
+        auto &extScanners = m_instances.byExtension[ext];
+        for (const auto &formatName : formatNames) {
+          if (auto scanner = byFormat.find(formatName); scanner != byFormat.end()) {
+            extScanners.push_back(scanner->second);
+          }
+        }
+      }
+    });
+
+    return m_instances;
+  }
+
   std::unordered_map<std::string, scannerSpawner> m_generators;
-  std::unordered_map<std::string, std::vector<scannerSpawner>> m_generators_ext;
+  std::unordered_map<std::string, std::vector<std::string>> m_generators_ext;
+  mutable std::once_flag m_spawnOnce;
+  mutable Instances m_instances;
 };
 
 namespace vgmtrans::scanners {
@@ -76,10 +106,7 @@ class ScannerRegistration final {
     });
 
     for (auto ext : exts) {
-      sm.addExtensionBinding(ext, [formatName]() -> std::shared_ptr<VGMScanner> {
-        auto format = Format::formatFromName(formatName);
-        return std::make_shared<T>(format);
-      });
+      sm.addExtensionBinding(ext, formatName);
     }
   }
 };
@@ -8,6 +8,7 @@
 
 #include "base/Types.h"
 #include "Format.h"
+#include "ItemArena.h"
 #include "Root.h"
 
 #include <limits>
@@ -18,7 +19,36 @@ VGMFile::VGMFile(std::string format, RawFile *rawfile, u32 offset,
     : VGMItem(this, offset, length, std::move(name)),
       m_rawfile(rawfile),
       m_format(std::move(format)),
-      m_id(std::numeric_limits<u32>::max()) {}
+      m_id(std::numeric_limits<u32>::max()) {
+  if (m_rawfile) {
+    ++m_rawfile->m_liveVGMFiles;
+  }
+}
+
+VGMFile::~VGMFile() {
+  // The VGMItem destructor would only free the children after the arena they live in
+  removeChildren();
+  if (m_rawfile) {
+    --m_rawfile->m_liveVGMFiles;
+  }
+}
+
+void *VGMFile::operator new(size_t size) {
+  ItemArena::Scope heapScope(nullptr);
+  return VGMItem::operator new(size);
+}
+
+bool VGMFile::load() {
+  ItemArena *current = ItemArena::current();
+  if (!m_itemArena) {
+    m_itemArena = current ? current->shared_from_this() : std::make_shared<ItemArena>();
+  }
+  if (current == m_itemArena.get()) {
+    return parse();
+  }
+  ItemArena::Scope arenaScope(m_itemArena.get());
+  return parse();
+}
 
 std::vector<std::unique_ptr<VGMFile>> VGMFile::releaseDiscoveredFiles() {
   return std::exchange(m_discoveredFiles, {});
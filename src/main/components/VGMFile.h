@@ -17,18 +17,26 @@
 
 class VGMColl;
 class Format;
+class ItemArena;
 
 class VGMFile : public VGMItem {
 public:
   VGMFile(std::string format, RawFile *rawfile, u32 offset, u32 length = 0,
           std::string name = "VGM File");
-  ~VGMFile() override = default;
+  ~VGMFile() override;
+
+  // Files are always allocated from the global heap, since they own the arena of their items
+  static void *operator new(size_t size);
 
   void addToUI(VGMItem *parent, void *UI_specific) override;
 
   [[nodiscard]] std::string description() override;
 
-  virtual bool load() = 0;
+  // Parses the file. Items allocated on this thread meanwhile come from the file's ItemArena,
+  // which is shared with any file loaded while parsing it (discovered files, embedded sample
+  // collections), since items can be handed between them
+  bool load();
+  virtual bool parse() = 0;
   std::vector<std::unique_ptr<VGMFile>> releaseDiscoveredFiles();
 
   template <class FileType, class... Args>
@@ -77,6 +85,7 @@ public:
   [[nodiscard]] const char *data() const { return m_rawfile->data() + offset(); }
 
 private:
+  std::shared_ptr<ItemArena> m_itemArena;
   RawFile* m_rawfile;
   std::string m_format;
   u32 m_id;
@@ -2,40 +2,104 @@
 
 #include "base/Types.h"
 #include "Helper.h"
+#include "ItemArena.h"
 #include "LogManager.h"
 #include "RawFile.h"
 #include "Root.h"
 #include "VGMFile.h"
 
-VGMItem::VGMItem() : type(Type::Unknown), m_vgmfile(nullptr), m_offset(0), m_length(0) {
+namespace {
+const std::string EMPTY_NAME;
+}
+
+VGMItem::VGMItem()
+    : type(Type::Unknown), m_vgmfile(nullptr), m_name(&EMPTY_NAME), m_offset(0), m_length(0) {
 }
 
 VGMItem::VGMItem(VGMFile *vgmfile, u32 offset, u32 length, std::string name, Type type)
     : type(type),
       m_vgmfile(vgmfile),
+      m_name(&EMPTY_NAME),
       m_offset(offset),
-      m_length(length),
-      m_name(std::move(name)) {
+      m_length(length) {
+  assignName(name);
 }
 
 VGMItem::VGMItem(VGMItem&& other) noexcept
     : type(other.type),
-      m_ownedChildren(std::move(other.m_ownedChildren)),
-      m_children(std::move(other.m_children)),
-      m_childrenSorted(other.m_childrenSorted),
-      m_childrenPrefixMaxEnd(std::move(other.m_childrenPrefixMaxEnd)),
+      m_ownsName(std::exchange(other.m_ownsName, false)),
       m_vgmfile(other.m_vgmfile),
+      m_childList(std::move(other.m_childList)),
+      m_name(std::exchange(other.m_name, &EMPTY_NAME)),
       m_offset(other.m_offset),
-      m_length(other.m_length),
-      m_name(std::move(other.m_name)) {
-  for (auto *child : m_children) {
+      m_length(other.m_length) {
+  for (auto *child : children()) {
     child->m_parent = this;
   }
-  other.m_children.clear();
-  other.m_childrenPrefixMaxEnd.clear();
 }
 
-VGMItem::~VGMItem() = default;
+VGMItem::~VGMItem() {
+  releaseName();
+}
+
+VGMItem::ChildList::~ChildList() {
+  for (auto *child : items) {
+    delete child;
+  }
+}
+
+namespace {
+// Room in front of every item for the arena it was allocated from, keeping the item aligned
+constexpr size_t ARENA_HEADER_SIZE = ItemArena::ALIGNMENT;
+static_assert(sizeof(ItemArena *) <= ARENA_HEADER_SIZE);
+}
+
+void *VGMItem::operator new(size_t size) {
+  ItemArena *arena = ItemArena::current();
+  const size_t total = size + ARENA_HEADER_SIZE;
+  void *block = arena ? ItemArena::allocate(total) : ::operator new(total);
+  *static_cast<ItemArena **>(block) = arena;
+  return static_cast<std::byte *>(block) + ARENA_HEADER_SIZE;
+}
+
+void VGMItem::operator delete(void *ptr, size_t size) noexcept {
+  if (!ptr)
+    return;
+  // Arena memory is released all at once along with the arena
+  void *block = static_cast<std::byte *>(ptr) - ARENA_HEADER_SIZE;
+  if (!*static_cast<ItemArena **>(block)) {
+    ::operator delete(block, size + ARENA_HEADER_SIZE);
+  }
+}
+
+void VGMItem::assignName(std::string_view name) {
+  releaseName();
+  // A file can outlive the arena that is current when it is named, so it keeps its own copy
+  ItemArena *arena = (m_vgmfile != this) ? ItemArena::current() : nullptr;
+  if (name.empty()) {
+    m_name = &EMPTY_NAME;
+  } else if (arena) {
+    m_name = arena->intern(name);
+  } else {
+    m_name = new std::string(name);
+    m_ownsName = true;
+  }
+}
+
+void VGMItem::releaseName() noexcept {
+  if (m_ownsName) {
+    delete m_name;
+    m_ownsName = false;
+  }
+  m_name = &EMPTY_NAME;
+}
+
+VGMItem::ChildList &VGMItem::childList() {
+  if (!m_childList) {
+    m_childList = std::make_unique<ChildList>();
+  }
+  return *m_childList;
+}
 
 bool operator>(const VGMItem &item1, const VGMItem &item2) {
   return item1.offset() > item2.offset();
@@ -62,29 +126,31 @@ bool VGMItem::isItemAtOffset(u32 offset, bool matchStartOffset) {
 }
 
 VGMItem* VGMItem::getItemAtOffset(u32 offset, bool matchStartOffset) {
-  if (m_children.empty()) {
+  const auto items = children();
+  if (items.empty()) {
     if ((matchStartOffset ? offset == m_offset : offset >= m_offset) && (offset < m_offset + m_length)) {
       return this;
     }
+    return nullptr;
   }
-  if (m_children.size() == 1) {
-    return m_children[0]->getItemAtOffset(offset, matchStartOffset);
+  if (items.size() == 1) {
+    return items[0]->getItemAtOffset(offset, matchStartOffset);
   }
 
   ensureChildrenSorted();
+  const auto &prefixMaxEnd = m_childList->prefixMaxEnd;
   // Binary search by start offset, then scan backwards only across potentially overlapping items.
-  const auto begin = m_children.begin();
-  const auto end = m_children.end();
+  const auto begin = items.begin();
+  const auto end = items.end();
   auto it = std::upper_bound(begin, end, offset,
       [](u32 off, const VGMItem* child) { return off < child->offset(); });
 
   for (auto idx = static_cast<size_t>(it - begin); idx > 0; --idx) {
-    VGMItem* child = m_children[idx - 1];
+    VGMItem* child = items[idx - 1];
     if (VGMItem* foundItem = child->getItemAtOffset(offset, matchStartOffset)) {
       return foundItem;
     }
-    if (!m_childrenPrefixMaxEnd.empty() &&
-        m_childrenPrefixMaxEnd[idx - 1] <= static_cast<u64>(offset)) {
+    if (!prefixMaxEnd.empty() && prefixMaxEnd[idx - 1] <= static_cast<u64>(offset)) {
       break;
     }
   }
@@ -122,7 +188,7 @@ void VGMItem::setRange(u32 offset, u32 length) {
 void VGMItem::addToUI(VGMItem *parent, void *UI_specific) {
   pRoot->UI_addItem(this, parent, name(), UI_specific);
 
-  for (const auto child : m_children) {
+  for (const auto child : children()) {
     child->addToUI(this, UI_specific);
   }
 }
@@ -161,10 +227,11 @@ VGMItem* VGMItem::sinkChild(std::unique_ptr<VGMItem>&& item) {
   auto *rawChild = item.get();
   rawChild->m_vgmfile = vgmFile();
   rawChild->m_parent = this;
-  m_children.emplace_back(rawChild);
-  m_ownedChildren.emplace_back(std::move(item));
-  m_childrenSorted = false;
-  m_childrenPrefixMaxEnd.clear();
+  auto &list = childList();
+  list.items.emplace_back(rawChild);
+  item.release();
+  list.sorted = false;
+  list.prefixMaxEnd.clear();
   return rawChild;
 }
 
@@ -184,48 +251,46 @@ VGMHeader* VGMItem::addHeader(u32 offset, u32 length, const std::string &name) {
 }
 
 void VGMItem::removeChildren() {
-  for (auto *child : m_children) {
-    child->m_parent = nullptr;
-  }
-  m_ownedChildren.clear();
-  m_children.clear();
-  m_childrenSorted = true;
-  m_childrenPrefixMaxEnd.clear();
+  m_childList.reset();
 }
 
 void VGMItem::transferChildren(VGMItem* destination) {
-  destination->m_children.insert(destination->m_children.end(), m_children.begin(), m_children.end());
-  for (auto *child : m_children) {
+  if (!m_childList) {
+    return;
+  }
+  for (auto *child : m_childList->items) {
     child->m_parent = destination;
   }
-  std::ranges::move(m_ownedChildren, std::back_inserter(destination->m_ownedChildren));
-  m_ownedChildren.clear();
-  m_children.clear();
-  m_childrenSorted = true;
-  m_childrenPrefixMaxEnd.clear();
-  destination->m_childrenSorted = false;
-  destination->m_childrenPrefixMaxEnd.clear();
+  auto &target = destination->childList();
+  target.items.insert(target.items.end(), m_childList->items.begin(), m_childList->items.end());
+  // The children now belong to the destination
+  m_childList->items.clear();
+  m_childList.reset();
+  target.sorted = false;
+  target.prefixMaxEnd.clear();
 }
 
 void VGMItem::ensureChildrenSorted() {
   // Lazy path: only sort/rebuild when a lookup needs it (single-child handled in caller).
-  if (!m_childrenSorted) {
-    std::sort(m_children.begin(), m_children.end(),
+  auto &list = childList();
+  if (!list.sorted) {
+    std::sort(list.items.begin(), list.items.end(),
               [](const VGMItem* a, const VGMItem* b) { return a->offset() < b->offset(); });
-    m_childrenSorted = true;
+    list.sorted = true;
     rebuildChildPrefixMaxEnd();
     return;
   }
-  if (m_childrenPrefixMaxEnd.size() != m_children.size()) {
+  if (list.prefixMaxEnd.size() != list.items.size()) {
     rebuildChildPrefixMaxEnd();
   }
 }
 
 void VGMItem::rebuildChildPrefixMaxEnd() {
-  m_childrenPrefixMaxEnd.clear();
-  m_childrenPrefixMaxEnd.reserve(m_children.size());
+  auto &list = childList();
+  list.prefixMaxEnd.clear();
+  list.prefixMaxEnd.reserve(list.items.size());
   u64 maxEnd = 0;
-  for (const auto* child : m_children) {
+  for (const auto* child : list.items) {
     assert(child->length() != 0);
     if (child->length() == 0) {
       L_WARN("getItemAtOffset() called on an item with a child of length 0 - could screw up prefix max cache. "
@@ -234,29 +299,32 @@ void VGMItem::rebuildChildPrefixMaxEnd() {
     const u32 span = (child->length() != 0) ? child->length() : child->guessLength();
     const u64 end = static_cast<u64>(child->offset()) + span;
     maxEnd = std::max(maxEnd, end);
-    m_childrenPrefixMaxEnd.push_back(maxEnd);
+    list.prefixMaxEnd.push_back(maxEnd);
   }
 }
 
 void VGMItem::invalidateParentCache(bool offsetChanged) {
-  if (!m_parent) {
+  if (!m_parent || !m_parent->m_childList) {
     return;
   }
   if (offsetChanged) {
-    m_parent->m_childrenSorted = false;
+    m_parent->m_childList->sorted = false;
   }
-  m_parent->m_childrenPrefixMaxEnd.clear();
+  m_parent->m_childList->prefixMaxEnd.clear();
 }
 
 void VGMItem::sortChildrenByOffset() {
-  std::ranges::sort(m_children, [](const VGMItem *a, const VGMItem *b) {
+  if (!m_childList) {
+    return;
+  }
+  std::ranges::sort(m_childList->items, [](const VGMItem *a, const VGMItem *b) {
     return a->offset() < b->offset();
   });
-  m_childrenSorted = true;
+  m_childList->sorted = true;
   rebuildChildPrefixMaxEnd();
 
   // Recursively sort the children of each child, if they have any children
-  for (VGMItem* child : m_children) {
+  for (VGMItem* child : m_childList->items) {
     if (!child->children().empty()) {
       child->sortChildrenByOffset();
     }
@@ -265,12 +333,12 @@ void VGMItem::sortChildrenByOffset() {
 
 // Guess length of a container from its descendants
 u32 VGMItem::guessLength() const {
-  if (m_children.empty()) {
+  if (children().empty()) {
     return m_length;
   }
   // NOTE: child items can sometimes overlap each other
   u32 guessedLength = 0;
-  for (const auto child : m_children) {
+  for (const auto child : children()) {
     assert(m_offset <= child->offset());
 
     u32 itemLength = child->length();
@@ -287,7 +355,7 @@ u32 VGMItem::guessLength() const {
 }
 
 void VGMItem::setGuessedLength() {
-  for (const auto child : m_children) {
+  for (const auto child : children()) {
     child->setGuessedLength();
   }
   if (m_length == 0) {
@@ -3,9 +3,11 @@
 #include "base/Types.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <span>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -94,13 +96,20 @@ public:
   VGMItem& operator=(VGMItem&& other) noexcept = delete;
   virtual ~VGMItem();
 
+  // Items come from the thread's current ItemArena (see ItemArena::Scope) when there is one, and
+  // from the global heap otherwise. Each allocation records its source in a small header that
+  // only the matching operator delete reads, so items created on the stack or by make_shared
+  // never have it looked up
+  static void *operator new(size_t size);
+  static void operator delete(void *ptr, size_t size) noexcept;
+
   friend bool operator>(VGMItem &item1, VGMItem &item2);
   friend bool operator<=(VGMItem &item1, VGMItem &item2);
   friend bool operator<(VGMItem &item1, VGMItem &item2);
   friend bool operator>=(VGMItem &item1, VGMItem &item2);
 
-  [[nodiscard]] const std::string& name() const noexcept { return m_name; }
-  void setName(const std::string& newName) { m_name = newName; }
+  [[nodiscard]] const std::string& name() const noexcept { return *m_name; }
+  void setName(const std::string& newName) { assignName(newName); }
 
   [[nodiscard]] VGMFile* vgmFile() const { return m_vgmfile; }
   [[nodiscard]] RawFile* rawFile() const;
@@ -113,7 +122,9 @@ public:
   virtual std::string description() { return ""; }
   virtual void addToUI(VGMItem *parent, void *UI_specific);
 
-  [[nodiscard]] std::span<VGMItem* const> children() const { return m_children; }
+  [[nodiscard]] std::span<VGMItem* const> children() const {
+    return m_childList ? std::span<VGMItem* const>(m_childList->items) : std::span<VGMItem* const>();
+  }
   [[nodiscard]] u32 offset() const noexcept { return m_offset; }
   [[nodiscard]] u32 length() const noexcept { return m_length; }
   void setOffset(u32 offset);
@@ -149,20 +160,37 @@ public:
   const Type type;
 
 private:
-  std::vector<std::unique_ptr<VGMItem>> m_ownedChildren;
-  std::vector<VGMItem *> m_children;
-  // Maintains sort + prefix-max end cache for fast offset lookups.
-  bool m_childrenSorted = true;
-  std::vector<u64> m_childrenPrefixMaxEnd;
-  VGMFile *m_vgmfile;
-  VGMItem *m_parent = nullptr;
-  u32 m_offset;  // offset in the pDoc data buffer
-  u32 m_length;  // num of bytes the event engulfs
+  // Most items are leaves, so child bookkeeping is only allocated once a child is added
+  struct ChildList {
+    ChildList() = default;
+    ChildList(const ChildList &) = delete;
+    ChildList &operator=(const ChildList &) = delete;
+    ~ChildList();
+
+    // The children, owned by the list, in one contiguous array
+    std::vector<VGMItem *> items;
+    // Maintains sort + prefix-max end cache for fast offset lookups.
+    std::vector<u64> prefixMaxEnd;
+    bool sorted = true;
+  };
 
+  // Items named while a file is being parsed share the copy of their name interned in the
+  // file's ItemArena. Files themselves, and items named at any other time, own a copy
+  void assignName(std::string_view name);
+  void releaseName() noexcept;
+
+  ChildList &childList();
   void ensureChildrenSorted();
   void rebuildChildPrefixMaxEnd();
   void invalidateParentCache(bool offsetChanged);
-  std::string m_name;
+
+  bool m_ownsName = false;
+  VGMFile *m_vgmfile;
+  VGMItem *m_parent = nullptr;
+  std::unique_ptr<ChildList> m_childList;
+  const std::string *m_name;
+  u32 m_offset;  // offset in the pDoc data buffer
+  u32 m_length;  // num of bytes the event engulfs
 };
 
 struct ItemPtrOffsetCmp {
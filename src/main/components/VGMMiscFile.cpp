@@ -23,7 +23,7 @@ bool VGMMiscFile::loadMain() {
   return true;
 }
 
-bool VGMMiscFile::load() {
+bool VGMMiscFile::parse() {
   if (!loadMain()) {
     return false;
   }
@@ -22,5 +22,5 @@ public:
               std::string name = "VGMMiscFile");
 
   virtual bool loadMain();
-  bool load() override;
+  bool parse() override;
 };
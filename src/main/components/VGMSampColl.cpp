@@ -35,7 +35,7 @@ VGMSampColl::VGMSampColl(const std::string &format, RawFile *rawfile, VGMInstrSe
       bLoaded(false) {
 }
 
-bool VGMSampColl::load() {
+bool VGMSampColl::parse() {
   if (bLoaded)
     return true;
   if (!parseHeader())
@@ -26,7 +26,7 @@ class VGMSampColl : public VGMFile {
   ~VGMSampColl() override;
   void attachInstrSet(VGMInstrSet *instrset) { parInstrSet = instrset; }
 
-  bool load() override;
+  bool parse() override;
   virtual bool parseHeader();        // retrieve any header data
   virtual bool parseSampleInfo();        // retrieve sample info, including pointers to data, # channels, rate, etc.
 
@@ -0,0 +1,116 @@
+/**
+ * VGMTrans (c) - 2002-2026
+ * Licensed under the zlib license
+ * See the included LICENSE for more information
+ */
+
+#include "PcmCache.h"
+
+#include "VGMSamp.h"
+
+#include <functional>
+#include <utility>
+
+size_t PcmCache::KeyHash::operator()(const Key& key) const {
+  size_t h = std::hash<const VGMSamp*>{}(key.samp);
+  const size_t format = (static_cast<size_t>(key.signedness) << 16) |
+                        (static_cast<size_t>(key.endianness) << 8) |
+                        static_cast<size_t>(key.bps);
+  return h ^ (format + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2));
+}
+
+bool PcmCache::enabled() const {
+  std::lock_guard lock(m_mutex);
+  return m_byteBudget > 0;
+}
+
+PcmCache::Pcm PcmCache::find(const VGMSamp* samp, const Params& params, Signedness signedness,
+                             Endianness endianness, BPS bps) {
+  std::lock_guard lock(m_mutex);
+  auto it = m_index.find(Key{samp, signedness, endianness, bps});
+  if (it == m_index.end() || it->second->params != params) {
+    m_misses++;
+    return nullptr;
+  }
+
+  m_hits++;
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->pcm;
+}
+
+void PcmCache::insert(const VGMSamp* samp, const Params& params, Signedness signedness,
+                      Endianness endianness, BPS bps, Pcm pcm) {
+  std::lock_guard lock(m_mutex);
+  const size_t bytes = pcm->size();
+  if (bytes > m_byteBudget) {
+    return;
+  }
+
+  const Key key{samp, signedness, endianness, bps};
+  if (auto it = m_index.find(key); it != m_index.end()) {
+    erase(it->second);
+  }
+
+  m_entries.push_front(Entry{key, params, std::move(pcm)});
+  m_index.emplace(key, m_entries.begin());
+  m_entriesPerSamp[samp]++;
+  m_bytes += bytes;
+  evictToBudget();
+}
+
+void PcmCache::invalidate(const VGMSamp* samp) {
+  std::lock_guard lock(m_mutex);
+  if (!m_entriesPerSamp.contains(samp)) {
+    return;
+  }
+
+  for (auto it = m_entries.begin(); it != m_entries.end();) {
+    auto next = std::next(it);
+    if (it->key.samp == samp) {
+      erase(it);
+    }
+    it = next;
+  }
+}
+
+void PcmCache::clear() {
+  std::lock_guard lock(m_mutex);
+  m_entries.clear();
+  m_index.clear();
+  m_entriesPerSamp.clear();
+  m_bytes = 0;
+}
+
+void PcmCache::setByteBudget(size_t bytes) {
+  std::lock_guard lock(m_mutex);
+  m_byteBudget = bytes;
+  evictToBudget();
+}
+
+PcmCache::Stats PcmCache::stats() const {
+  std::lock_guard lock(m_mutex);
+  return {m_hits, m_misses, m_evictions, m_entries.size(), m_bytes, m_byteBudget};
+}
+
+void PcmCache::resetStats() {
+  std::lock_guard lock(m_mutex);
+  m_hits = 0;
+  m_misses = 0;
+  m_evictions = 0;
+}
+
+void PcmCache::erase(EntryList::iterator it) {
+  m_bytes -= it->pcm->size();
+  m_index.erase(it->key);
+  if (auto count = m_entriesPerSamp.find(it->key.samp); --count->second == 0) {
+    m_entriesPerSamp.erase(count);
+  }
+  m_entries.erase(it);
+}
+
+void PcmCache::evictToBudget() {
+  while (m_bytes > m_byteBudget && !m_entries.empty()) {
+    erase(std::prev(m_entries.end()));
+    m_evictions++;
+  }
+}
@@ -0,0 +1,119 @@
+/**
+ * VGMTrans (c) - 2002-2026
+ * Licensed under the zlib license
+ * See the included LICENSE for more information
+ */
+
+#pragma once
+
+#include "base/Binary.h"
+#include "base/Types.h"
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class VGMSamp;
+enum class BPS : int;
+
+/*
+ * Process-wide LRU cache of decoded sample data, so that exporting a collection to several
+ * formats (or previewing it and then exporting it) decodes each sample once. Entries are keyed
+ * by sample and output format and are evicted least-recently-used first once the cache grows
+ * past its byte budget. Entries share their data with the callers that decoded or found them,
+ * so neither a hit nor an insert copies the samples.
+ *
+ * The cache is off by default: SF2 export decodes one sample at a time to keep its peak memory
+ * low, and a cache would hold on to every sample it decoded. Front ends that convert the same
+ * collection repeatedly turn it on by giving it a byte budget.
+ */
+class PcmCache {
+public:
+  // Sample parameters the decoded data depends on. An entry whose parameters no longer match
+  // the sample's is treated as a miss and replaced.
+  struct Params {
+    u32 dataOffset;
+    u32 dataLength;
+    u32 uncompressedSize;
+    u8 channels;
+    int bps;
+    bool reverse;
+    Endianness endianness;
+    Signedness signedness;
+
+    bool operator==(const Params&) const = default;
+  };
+
+  struct Stats {
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+    size_t entries;
+    size_t bytes;
+    size_t byteBudget;
+  };
+
+  using Pcm = std::shared_ptr<const std::vector<u8>>;
+
+  static constexpr size_t kDefaultByteBudget = 0;
+
+  // Never destroyed: samples owned by global roots may be released during static destruction
+  static PcmCache& the() {
+    static PcmCache* instance = new PcmCache;
+    return *instance;
+  }
+
+  bool enabled() const;
+  // Returns null on a miss
+  Pcm find(const VGMSamp* samp, const Params& params, Signedness signedness,
+           Endianness endianness, BPS bps);
+  void insert(const VGMSamp* samp, const Params& params, Signedness signedness,
+              Endianness endianness, BPS bps, Pcm pcm);
+
+  // Drops every entry for the sample; called when it is destroyed or its decoding changes
+  void invalidate(const VGMSamp* samp);
+  void clear();
+
+  // A budget of 0 disables caching
+  void setByteBudget(size_t bytes);
+  Stats stats() const;
+  void resetStats();
+
+private:
+  struct Key {
+    const VGMSamp* samp;
+    Signedness signedness;
+    Endianness endianness;
+    BPS bps;
+
+    bool operator==(const Key&) const = default;
+  };
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+  struct Entry {
+    Key key;
+    Params params;
+    Pcm pcm;
+  };
+  using EntryList = std::list<Entry>;
+
+  PcmCache() = default;
+
+  void erase(EntryList::iterator it);
+  void evictToBudget();
+
+  mutable std::mutex m_mutex;
+  // Most recently used first
+  EntryList m_entries;
+  std::unordered_map<Key, EntryList::iterator, KeyHash> m_index;
+  std::unordered_map<const VGMSamp*, size_t> m_entriesPerSamp;
+  size_t m_bytes = 0;
+  size_t m_byteBudget = kDefaultByteBudget;
+  size_t m_hits = 0;
+  size_t m_misses = 0;
+  size_t m_evictions = 0;
+};
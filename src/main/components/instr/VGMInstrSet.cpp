@@ -67,7 +67,7 @@ void VGMInstrSet::clearInstrs() {
   m_ownedInstrs.clear();
 }
 
-bool VGMInstrSet::load() {
+bool VGMInstrSet::parse() {
   if (!parseHeader())
     return false;
   if (!parseInstrPointers()) {
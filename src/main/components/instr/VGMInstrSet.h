@@ -29,7 +29,7 @@ public:
               std::string name = "VGMInstrSet", VGMSampColl *sampColl = nullptr);
   ~VGMInstrSet() override;
 
-  bool load() override;
+  bool parse() override;
   virtual bool parseHeader();
   virtual bool parseInstrPointers();
   virtual bool loadInstrs();
@@ -8,6 +8,7 @@
 
 #include "base/Types.h"
 #include "Helper.h"
+#include "PcmCache.h"
 #include "Root.h"
 #include "ScaleConversion.h"
 #include "util/Path.h"
@@ -29,6 +30,10 @@ VGMSamp::VGMSamp(VGMSampColl *sampColl, u32 offset, u32 length, u32 dataOffset,
       parSampColl(sampColl), m_bps(bps) {
 }
 
+VGMSamp::~VGMSamp() {
+  invalidateCachedPcm();
+}
+
 double VGMSamp::compressionRatio() const {
   return 1.0;
 }
@@ -39,7 +44,32 @@ std::vector<u8> VGMSamp::decodeToNativePcm() {
   return src;
 }
 
-std::vector<u8> VGMSamp::toPcm(Signedness targetSignedness,
+std::shared_ptr<const std::vector<u8>> VGMSamp::toPcm(Signedness targetSignedness,
+                                                      Endianness targetEndianness,
+                                                      BPS targetBps) {
+  auto& cache = PcmCache::the();
+  if (!cache.enabled()) {
+    return std::make_shared<const std::vector<u8>>(
+        convertPcm(targetSignedness, targetEndianness, targetBps));
+  }
+
+  const PcmCache::Params params{dataOff, dataLength, ulUncompressedSize, channels,
+                                bitsPerSample(), m_reverse, m_endianness, m_signedness};
+  if (auto cached = cache.find(this, params, targetSignedness, targetEndianness, targetBps)) {
+    return cached;
+  }
+
+  auto pcm = std::make_shared<const std::vector<u8>>(
+      convertPcm(targetSignedness, targetEndianness, targetBps));
+  cache.insert(this, params, targetSignedness, targetEndianness, targetBps, pcm);
+  return pcm;
+}
+
+void VGMSamp::invalidateCachedPcm() {
+  PcmCache::the().invalidate(this);
+}
+
+std::vector<u8> VGMSamp::convertPcm(Signedness targetSignedness,
                                     Endianness targetEndianness,
                                     BPS targetBps) {
   std::vector<u8> src = decodeToNativePcm();
@@ -132,7 +162,8 @@ bool VGMSamp::saveAsWav(const std::filesystem::path &filepath) {
   u32 bufSize = uncompressedSize();
 
   const auto wavSignedness = (m_bps == BPS::PCM8) ? Signedness::Unsigned : Signedness::Signed;
-  std::vector<u8> uncompSampBuf = toPcm(wavSignedness, Endianness::Little, m_bps);
+  const auto pcm = toPcm(wavSignedness, Endianness::Little, m_bps);
+  const std::vector<u8> &uncompSampBuf = *pcm;
   bufSize = static_cast<u32>(uncompSampBuf.size());
 
   u16 blockAlign = bytesPerSample() * channels;
@@ -13,6 +13,7 @@
 
 #include <cstddef>
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -28,12 +29,20 @@ public:
   VGMSamp(VGMSampColl *sampColl, u32 offset = 0, u32 length = 0, u32 dataOffset = 0,
           u32 dataLength = 0, u8 channels = 1, BPS bps = BPS::PCM16, u32 rate = 0,
           std::string name = "Sample");
-  ~VGMSamp() override = default;
+  ~VGMSamp() override;
 
   virtual double compressionRatio() const;  // ratio of space conserved.  should generally be > 1
-  std::vector<u8> toPcm(Signedness targetSignedness,
-                             Endianness targetEndianness,
-                             BPS targetBps);
+  // When the PcmCache is enabled, decoded data is kept there and repeated conversions of the
+  // same sample share it
+  std::shared_ptr<const std::vector<u8>> toPcm(Signedness targetSignedness,
+                                               Endianness targetEndianness,
+                                               BPS targetBps);
+  // Subclasses whose decoding depends on state other than the generic sample parameters must
+  // call this when that state changes after the sample was first converted
+  void invalidateCachedPcm();
+  // Formats that keep loop points in the encoded data override this to fill in `loop` without
+  // decoding the sample. Conversions call it before reading the loop, as decoding is deferred.
+  virtual void readLoopInfo() {}
 
   inline void setBPS(BPS theBps) { m_bps = theBps; }
   inline void setRate(u32 theRate) { rate = theRate; }
@@ -91,6 +100,11 @@ private:
 
 protected:
   virtual std::vector<u8> decodeToNativePcm();
+
+private:
+  std::vector<u8> convertPcm(Signedness targetSignedness,
+                             Endianness targetEndianness,
+                             BPS targetBps);
 };
 
 
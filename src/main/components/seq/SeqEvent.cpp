@@ -20,7 +20,8 @@ SeqEvent::SeqEvent(SeqTrack *track,
                    Type type,
                    const std::string &desc)
     : VGMItem(track->parentSeq, offset, length, name, type), channel(0),
-      parentTrack(track), m_description(desc) {}
+      parentTrack(track),
+      m_description(desc.empty() ? nullptr : std::make_unique<const std::string>(desc)) {}
 
 // ***************
 // DurNoteSeqEvent
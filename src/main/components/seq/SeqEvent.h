@@ -10,6 +10,7 @@
 #include "MidiFile.h"
 #include "VGMItem.h"
 
+#include <memory>
 #include <string>
 
 #include <spdlog/fmt/fmt.h>
@@ -27,14 +28,15 @@ class SeqEvent:
                     const std::string &desc = "");
   ~SeqEvent() override = default;
   std::string description() override {
-    return m_description;
+    return m_description ? *m_description : std::string();
   }
 
  public:
   u8 channel;
   SeqTrack *parentTrack;
  private:
-  std::string m_description;
+  // Most events have no fixed description, so it is only allocated when one is given
+  std::unique_ptr<const std::string> m_description;
 };
 
 //  ***************
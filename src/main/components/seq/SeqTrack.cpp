@@ -45,7 +45,7 @@ bool SeqTrack::usesLinearAmplitudeScale() const {
 SeqEventTimeIndex::Index SeqTrack::addTimedEventIndexEntry(SeqEvent* event,
                                                            u32 startTick,
                                                            u32 duration) {
-  return parentSeq->timedEventIndex().addEvent(event, startTick, duration);
+  return parentSeq->conversionTimeline().addEvent(event, startTick, duration);
 }
 
 void SeqTrack::resetVars() {
@@ -71,7 +71,7 @@ void SeqTrack::resetVars() {
   panVolumeCorrectionRate = 1.0;
   returnOffsets.clear();
   loopStack.clear();
-  visitedControlFlowStates.clear();
+  clearControlFlowStates();
   prevDurEventIndices.clear();
   m_activeNoteEventIndices.clear();
   clearSeqEventTarget();
@@ -85,7 +85,7 @@ void SeqTrack::resetSegmentVars() {
   deltaTime = 0;
   returnOffsets.clear();
   loopStack.clear();
-  visitedControlFlowStates.clear();
+  clearControlFlowStates();
   prevDurEventIndices.clear();
   m_activeNoteEventIndices.clear();
   m_lastEventOffset = 0;
@@ -95,8 +95,6 @@ void SeqTrack::resetSegmentVars() {
 
 void SeqTrack::resetVisitedAddresses() {
   visitedAddresses.clear();
-  visitedAddresses.reserve(8192);
-  visitedAddressMax = 0;
 }
 
 bool SeqTrack::readEvent() {
@@ -378,24 +376,15 @@ bool SeqTrack::emitTremoloDepth(SeqSynthLfoAutomation& automation, u8 depth, boo
 }
 
 bool SeqTrack::isOffsetUsed(u32 offset) {
-  if (offset <= visitedAddressMax) {
-    auto itrAddress = visitedAddresses.find(offset);
-    if (itrAddress != visitedAddresses.end()) {
-      return true;
-    }
-  }
-  return false;
+  return visitedAddresses.contains(offset);
 }
 
 
 bool SeqTrack::onEvent(u32 offset, u32 length) {
   m_lastEventOffset = offset;
   m_lastEventLength = length;
-  if (offset > visitedAddressMax) {
-    visitedAddressMax = offset;
-  }
   addControlFlowState(offset);
-  return visitedAddresses.insert(offset).second;
+  return visitedAddresses.insert(offset);
 }
 
 SeqEvent* SeqTrack::sinkEvent(std::unique_ptr<SeqEvent>&& seqEvent) {
@@ -559,7 +548,7 @@ void SeqTrack::endActiveNoteIndex(s8 key, u32 endTick) {
   if (idx == SeqEventTimeIndex::kInvalidIndex) {
     return;
   }
-  auto& timeline = parentSeq->timedEventIndex();
+  auto& timeline = parentSeq->conversionTimeline();
   if (idx >= timeline.size()) {
     return;
   }
@@ -859,10 +848,10 @@ void SeqTrack::makePrevDurNoteEnd() const {
 
 void SeqTrack::makePrevDurNoteEnd(u32 absTime) const {
   if (readMode == READMODE_CONVERT_TO_MIDI) {
-    for (auto* prevDurNoteOff : pMidiTrack->previousDurNoteOffs()) {
-      prevDurNoteOff->absTime = absTime;
+    for (size_t prevDurNoteOff : pMidiTrack->previousDurNoteOffs()) {
+      pMidiTrack->event(prevDurNoteOff).absTime = absTime;
     }
-    auto& timeline = parentSeq->timedEventIndex();
+    auto& timeline = parentSeq->conversionTimeline();
     for (auto idx : prevDurEventIndices) {
       auto& evt = timeline.event(idx);
       evt.duration = absTime > evt.startTick ? absTime - evt.startTick : 0;
@@ -876,12 +865,13 @@ void SeqTrack::limitPrevDurNoteEnd() const {
 
 void SeqTrack::limitPrevDurNoteEnd(u32 absTime) const {
   if (readMode == READMODE_CONVERT_TO_MIDI) {
-    for (auto* prevDurNoteOff : pMidiTrack->previousDurNoteOffs()) {
-      if (prevDurNoteOff->absTime > absTime) {
-        prevDurNoteOff->absTime = absTime;
+    for (size_t prevDurNoteOff : pMidiTrack->previousDurNoteOffs()) {
+      MidiEvent& noteOff = pMidiTrack->event(prevDurNoteOff);
+      if (noteOff.absTime > absTime) {
+        noteOff.absTime = absTime;
       }
     }
-    auto& timeline = parentSeq->timedEventIndex();
+    auto& timeline = parentSeq->conversionTimeline();
     for (auto idx : prevDurEventIndices) {
       auto& evt = timeline.event(idx);
       if (evt.endTickExclusive() > absTime) {
@@ -898,7 +888,7 @@ void SeqTrack::purgePrevDurEvents(u32 absTime) {
   if (prevDurEventIndices.empty()) {
     return;
   }
-  auto& timeline = parentSeq->timedEventIndex();
+  auto& timeline = parentSeq->conversionTimeline();
   prevDurEventIndices.erase(
     std::remove_if(prevDurEventIndices.begin(), prevDurEventIndices.end(),
       [&timeline, absTime](SeqEventTimeIndex::Index idx) {
@@ -1964,6 +1954,10 @@ void SeqTrack::addControlFlowState(u32 destinationOffset) {
     return;
   }
 
+  if (returnOffsets.empty() && loopStack.empty()) {
+    visitedTopLevelControlFlowStates.insert(destinationOffset);
+    return;
+  }
   ControlFlowState state{destinationOffset, returnOffsets, loopStack};
   visitedControlFlowStates.insert(state);
 }
@@ -1977,8 +1971,13 @@ bool SeqTrack::checkControlStateForInfiniteLoop(u32 offset) {
   if (!shouldTrackControlFlowState())
     return true;
 
-  ControlFlowState state{offset, returnOffsets, loopStack};
-  bool isVisited = visitedControlFlowStates.contains(state);
+  bool isVisited;
+  if (returnOffsets.empty() && loopStack.empty()) {
+    isVisited = visitedTopLevelControlFlowStates.contains(offset);
+  } else {
+    ControlFlowState state{offset, returnOffsets, loopStack};
+    isVisited = visitedControlFlowStates.contains(state);
+  }
   if (!isVisited)
     return true;
 
@@ -2002,10 +2001,15 @@ bool SeqTrack::checkControlStateForInfiniteLoop(u32 offset) {
     return false;
   }
   // Otherwise, clear control flow states to allow another full loop of conversion
-  visitedControlFlowStates.clear();
+  clearControlFlowStates();
   return true;
 }
 
+void SeqTrack::clearControlFlowStates() {
+  visitedTopLevelControlFlowStates.clear();
+  visitedControlFlowStates.clear();
+}
+
 void SeqTrack::pushReturnOffset(u32 returnOffset) {
   returnOffsets.push_back(returnOffset);
 }
@@ -12,6 +12,7 @@
 #include "SynthType.h"
 #include "VGMItem.h"
 #include "SeqEventTimeIndex.h"
+#include "util/PagedBitset.h"
 
 #include <cstddef>
 #include <cstdint>
@@ -162,6 +163,7 @@ protected:
   bool shouldTrackControlFlowState() const;
   void addControlFlowState(u32 destinationOffset);
   bool checkControlStateForInfiniteLoop(u32 offset);
+  void clearControlFlowStates();
   void pushReturnOffset(u32 returnOffset);
   bool popReturnOffset(u32 &returnOffset);
   SeqEvent* findSeqEventAtOffset(u32 offset, u32 length);
@@ -399,11 +401,14 @@ private:
   bool bWriteGenericEventAsTextEvent;
   bool m_useLinearAmpScale = false;
 
-  std::unordered_set<u32> visitedAddresses;
-  u32 visitedAddressMax;
+  // Offsets of the events read since the last resetVisitedAddresses()
+  PagedBitset visitedAddresses;
 
   std::vector<u32> returnOffsets;
   std::vector<LoopState> loopStack;
+  // Control flow states with empty return and loop stacks (the common case) are identified by
+  // their offset alone and kept in the bitset; only nested states are hashed
+  PagedBitset visitedTopLevelControlFlowStates;
   std::unordered_set<ControlFlowState, ControlFlowStateHasher> visitedControlFlowStates;
   std::vector<SeqEventTimeIndex::Index> prevDurEventIndices;
   std::unordered_map<int, std::vector<SeqEventTimeIndex::Index>> m_activeNoteEventIndices;
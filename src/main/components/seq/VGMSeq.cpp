@@ -74,38 +74,79 @@ std::unique_ptr<MidiFile> VGMSeq::convertToMidi(const VGMColl* coll) {
 }
 
 std::unique_ptr<MidiFile> VGMSeq::convertToMidi(const VGMColl* coll, const ConversionContext& context) {
-  setConversionContext(context);
+  ConversionSession session(*this, context);
   size_t numTracks = m_tracks.size();
 
-  if (!loadTracks(READMODE_FIND_DELTA_LENGTH)) {
+  long stopTime = 0;
+  if (auto cached = cachedStopTime()) {
+    stopTime = *cached;
+  } else {
+    if (!loadTracks(READMODE_FIND_DELTA_LENGTH)) {
       return nullptr;
+    }
+
+    // Find the greatest length of all tracks to use as stop point for every track
+    for (size_t i = 0; i < numTracks; i++)
+      stopTime = std::max(stopTime, m_tracks[i]->totalTicks);
+    cacheStopTime(stopTime);
   }
 
   useColl(coll);
 
-  // Find the greatest length of all tracks to use as stop point for every track
-  long stopTime = 0;
-  for (size_t i = 0; i < numTracks; i++)
-    stopTime = std::max(stopTime, m_tracks[i]->totalTicks);
-
-  auto newMidi = std::make_unique<MidiFile>(this);
-  this->midi = newMidi.get();
+  session.beginMidi();
   if (!loadTracks(READMODE_CONVERT_TO_MIDI, stopTime)) {
-    this->midi = nullptr;
-    m_timedEvents.clear();
     return nullptr;
   }
-  this->midi = nullptr;
-  return newMidi;
+  return session.finish();
+}
+
+VGMSeq::ConversionSession::ConversionSession(VGMSeq& seq, const ConversionContext& context)
+    : m_seq(seq), m_lock(seq.m_conversionMutex) {
+  m_seq.setConversionContext(context);
+  m_seq.m_session = this;
+}
+
+VGMSeq::ConversionSession::~ConversionSession() {
+  m_seq.midi = nullptr;
+  m_seq.m_session = nullptr;
+}
+
+MidiFile* VGMSeq::ConversionSession::beginMidi() {
+  m_midi = std::make_unique<MidiFile>(&m_seq);
+  m_seq.midi = m_midi.get();
+  m_timeline.clear();
+  return m_midi.get();
+}
+
+std::unique_ptr<MidiFile> VGMSeq::ConversionSession::finish() {
+  m_seq.midi = nullptr;
+  m_seq.m_timedEvents = std::move(m_timeline);
+  return std::move(m_midi);
+}
+
+SeqEventTimeIndex& VGMSeq::conversionTimeline() {
+  return m_session ? m_session->timeline() : m_timedEvents;
+}
+
+std::optional<long> VGMSeq::cachedStopTime() const {
+  if (m_cachedStopTimeLoops != m_conversionContext.sequenceLoops)
+    return std::nullopt;
+  return m_cachedStopTime;
+}
+
+void VGMSeq::cacheStopTime(long stopTime) {
+  m_cachedStopTime = stopTime;
+  m_cachedStopTimeLoops = m_conversionContext.sequenceLoops;
 }
 
 MidiTrack *VGMSeq::firstMidiTrack() {
   return m_tracks.empty() ? nullptr : m_tracks[0]->pMidiTrack;
 }
 
-bool VGMSeq::load() {
+bool VGMSeq::parse() {
   setConversionContext(ConversionContext::fromOptions(ConversionOptions::the(), SynthTarget::SoundFont));
   readMode = READMODE_ADD_TO_UI;
+  invalidateStopTime();
 
   if (!parseHeader())
     return false;
@@ -136,7 +177,7 @@ bool VGMSeq::postLoad() {
     }
   } else if (readMode == READMODE_CONVERT_TO_MIDI) {
     midi->sort();
-    m_timedEvents.finalize();
+    conversionTimeline().finalize();
   }
 
   return true;
@@ -150,7 +191,7 @@ bool VGMSeq::loadTracks(ReadMode seqReadMode, u32 stopTime) {
   }
 
   if (seqReadMode == READMODE_CONVERT_TO_MIDI) {
-    m_timedEvents.clear();
+    conversionTimeline().clear();
   }
 
   // reset variables
@@ -17,6 +17,8 @@
 
 #include <filesystem>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <span>
 #include <set>
 #include <string>
@@ -36,7 +38,7 @@ class VGMSeq : public VGMFile {
          std::string name = "VGM Sequence");
   ~VGMSeq() override;
 
-  bool load() override;
+  bool parse() override;
   virtual bool parseHeader();
   virtual bool parseTrackPointers();  // Function to find all of the track pointers.   Returns number of total tracks.
   virtual void resetVars();
@@ -118,13 +120,40 @@ class VGMSeq : public VGMFile {
   [[nodiscard]] u16 initialPitchBendRange() const { return m_initial_pitch_bend_range_cents; }
   void setInitialPitchBendRange(u16 cents) { m_initial_pitch_bend_range_cents = cents; }
 
+  // Timeline of the most recent completed conversion
   SeqEventTimeIndex& timedEventIndex() { return m_timedEvents; }
+  // Timeline being built by the conversion in progress. Only valid on the converting thread
+  SeqEventTimeIndex& conversionTimeline();
   [[nodiscard]] std::span<SeqTrack* const> tracks() const { return m_tracks; }
   [[nodiscard]] bool hasTracks() const { return !m_tracks.empty(); }
   [[nodiscard]] size_t trackCount() const { return m_tracks.size(); }
   SeqTrack* track(size_t index) const { return m_tracks.at(index); }
 
  protected:
+  // The state of one convertToMidi call. The session owns the MidiFile being written, which
+  // `midi` points at for the session's lifetime, and the timeline of the events it plays.
+  // Format interpreters keep their cursors, loop counters and sliders in the sequence and its
+  // tracks, so a session also holds the sequence's conversion lock: conversions of one sequence
+  // are serialized while different sequences convert concurrently.
+  class ConversionSession {
+   public:
+    ConversionSession(VGMSeq& seq, const ConversionContext& context);
+    ~ConversionSession();
+    ConversionSession(const ConversionSession&) = delete;
+    ConversionSession& operator=(const ConversionSession&) = delete;
+
+    MidiFile* beginMidi();
+    SeqEventTimeIndex& timeline() { return m_timeline; }
+    // Publishes the timeline to timedEventIndex() and hands over the converted file
+    std::unique_ptr<MidiFile> finish();
+
+   private:
+    VGMSeq& m_seq;
+    std::unique_lock<std::mutex> m_lock;
+    std::unique_ptr<MidiFile> m_midi;
+    SeqEventTimeIndex m_timeline;
+  };
+
   void setConversionContext(const ConversionContext& context) { m_conversionContext = context; }
   void reserveTracks(size_t count) { m_ownedTracks.reserve(count); m_tracks.reserve(count); }
   void clearTracks();
@@ -149,6 +178,13 @@ class VGMSeq : public VGMFile {
   virtual void loadTracksMain(u32 stopTime);
   virtual bool postLoad();
 
+  // Length in ticks found by the last READMODE_FIND_DELTA_LENGTH pass. It only depends on the
+  // number of loops being converted, so later conversions with the same loop count reuse it
+  // rather than interpreting the whole sequence twice.
+  [[nodiscard]] std::optional<long> cachedStopTime() const;
+  void cacheStopTime(long stopTime);
+  void invalidateStopTime() { m_cachedStopTime.reset(); }
+
 private:
   bool hasActiveTracks();
   int foreverLoopCount();
@@ -191,6 +227,12 @@ private:
   // Timeline of sequence events emitted during MIDI conversion.
   SeqEventTimeIndex m_timedEvents;
 
+  std::mutex m_conversionMutex;
+  ConversionSession* m_session{nullptr};
+
+  std::optional<long> m_cachedStopTime;
+  int m_cachedStopTimeLoops{0};
+
   u16 m_ppqn;
 
   u8 m_initial_volume;
@@ -28,9 +28,10 @@ void VGMSeqNoTrks::resetVars() {
 }
 
 // LoadMain() - loads all sequence data into the class
-bool VGMSeqNoTrks::load() {
+bool VGMSeqNoTrks::parse() {
   this->SeqTrack::readMode = READMODE_ADD_TO_UI;
   this->VGMSeq::readMode = READMODE_ADD_TO_UI;
+  invalidateStopTime();
   if (!parseHeader())
     return false;
 
@@ -95,34 +96,31 @@ std::unique_ptr<MidiFile> VGMSeqNoTrks::convertToMidi(const VGMColl* coll) {
 }
 
 std::unique_ptr<MidiFile> VGMSeqNoTrks::convertToMidi(const VGMColl* coll, const ConversionContext& context) {
-  setConversionContext(context);
-  this->SeqTrack::readMode = this->VGMSeq::readMode = READMODE_FIND_DELTA_LENGTH;
+  ConversionSession session(*this, context);
 
   useColl(coll);
 
-  if (!loadEvents())
-    return nullptr;
-  if (!postLoad())
-    return nullptr;
-
-  long stopTime = totalTicks;
+  long stopTime;
+  if (auto cached = cachedStopTime()) {
+    stopTime = *cached;
+  } else {
+    this->SeqTrack::readMode = this->VGMSeq::readMode = READMODE_FIND_DELTA_LENGTH;
+    if (!loadEvents())
+      return nullptr;
+    if (!postLoad())
+      return nullptr;
+
+    stopTime = totalTicks;
+    cacheStopTime(stopTime);
+  }
 
-  auto newMidi = std::make_unique<MidiFile>(this);
-  this->midi = newMidi.get();
+  session.beginMidi();
   this->SeqTrack::readMode = this->VGMSeq::readMode = READMODE_CONVERT_TO_MIDI;
-  timedEventIndex().clear();
-  if (!loadEvents(stopTime)) {
-    this->midi = nullptr;
-    timedEventIndex().clear();
+  if (!loadEvents(stopTime))
     return nullptr;
-  }
-  if (!postLoad()) {
-    this->midi = nullptr;
-    timedEventIndex().clear();
+  if (!postLoad())
     return nullptr;
-  }
-  this->midi = nullptr;
-  return newMidi;
+  return session.finish();
 }
 
 MidiTrack *VGMSeqNoTrks::firstMidiTrack() {
@@ -23,6 +23,7 @@ public:
 
   void resetVars() override;
 
+  using VGMFile::operator new;
   using VGMSeq::readBytes;
   using VGMSeq::readByte;
   using VGMSeq::readShort;
@@ -53,7 +54,7 @@ public:
   void setChannel(u8 newChannel);
   void tryExpandMidiTracks(u32 numTracks);
 
-  bool load() override;  // Function to load all the information about the sequence
+  bool parse() override;  // Function to load all the information about the sequence
   virtual bool loadEvents(long stopTime = 1000000);
   std::unique_ptr<MidiFile> convertToMidi(const VGMColl* coll) override;
   std::unique_ptr<MidiFile> convertToMidi(const VGMColl* coll, const ConversionContext& context) override;
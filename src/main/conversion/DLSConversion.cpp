@@ -30,7 +30,7 @@ void unpackSampColl(DLSFile &dls, const VGMSampColl *sampColl, std::vector<VGMSa
     VGMSamp *samp = sampColl->sample(i);
 
     BPS targetBps = samp->bps();
-    std::vector<u8> uncompSampBuf = samp->toPcm(
+    const auto uncompSampBuf = samp->toPcm(
       targetBps == BPS::PCM8 ? Signedness::Unsigned : Signedness::Signed,
       Endianness::Little,
       targetBps
@@ -39,7 +39,7 @@ void unpackSampColl(DLSFile &dls, const VGMSampColl *sampColl, std::vector<VGMSa
     u16 bitsPerSample = static_cast<u16>(samp->bitsPerSample());
     u16 blockAlign = bitsPerSample / 8 * samp->channels;
     dls.addWave(1, samp->channels, samp->rate, samp->rate * blockAlign, blockAlign,
-                bitsPerSample, static_cast<u32>(uncompSampBuf.size()), uncompSampBuf.data(),
+                bitsPerSample, static_cast<u32>(uncompSampBuf->size()), uncompSampBuf->data(),
                 samp->name());
     finalSamps.push_back(samp);
   }
@@ -56,7 +56,7 @@ DLSInstr *DLSFile::addInstr(unsigned long bank, unsigned long instrNum, std::str
 
 DLSWave *DLSFile::addWave(u16 formatTag, u16 channels, int samplesPerSec,
                           int aveBytesPerSec, u16 blockAlign, u16 bitsPerSample,
-                          u32 waveDataSize, unsigned char *waveData, std::string wave_name) {
+                          u32 waveDataSize, const unsigned char *waveData, std::string wave_name) {
   auto wave = m_waves
                   .emplace_back(std::make_unique<DLSWave>(formatTag, channels, samplesPerSec,
                                                           aveBytesPerSec, blockAlign, bitsPerSample,
@@ -114,7 +114,7 @@ public:
   DLSInstr *addInstr(unsigned long bank, unsigned long instrNum, std::string Name);
   DLSWave *addWave(u16 formatTag, u16 channels, int samplesPerSec, int aveBytesPerSec,
                    u16 blockAlign, u16 bitsPerSample, u32 waveDataSize,
-                   u8 *waveData, std::string name = "Unnamed Wave");
+                   const u8 *waveData, std::string name = "Unnamed Wave");
 
   std::vector<DLSInstr *> instruments();
   std::vector<DLSWave *> waves();
@@ -242,7 +242,7 @@ class DLSWave {
 public:
   DLSWave(u16 formatTag, u16 channels, u32 samplesPerSec, u32 aveBytesPerSec,
           u16 blockAlign, u16 bitsPerSample, u32 waveDataSize,
-          u8* waveData, std::string waveName = "Untitled wave")
+          const u8* waveData, std::string waveName = "Untitled wave")
       : wFormatTag(formatTag), wChannels(channels), dwSamplesPerSec(samplesPerSec),
         dwAveBytesPerSec(aveBytesPerSec), wBlockAlign(blockAlign), wBitsPerSample(bitsPerSample),
         m_name(std::move(waveName)), m_wave_data(waveData, waveData + waveDataSize) {
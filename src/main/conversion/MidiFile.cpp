@@ -10,10 +10,15 @@
 #include "VGMSeq.h"
 
 #include <algorithm>
+#include <cmath>
 #include <filesystem>
+#include <fstream>
+#include <limits>
+#include <numeric>
 #include <ranges>
 
 #include <spdlog/fmt/fmt.h>
+#include <spdlog/fmt/std.h>
 
 MidiFile::MidiFile(VGMSeq *assocSeq)
     : assocSeq(assocSeq),
@@ -97,13 +102,63 @@ void MidiFile::sort() {
 }
 
 bool MidiFile::saveMidiFile(const std::filesystem::path &filepath) {
-  std::vector<u8> midiBuf;
-  writeMidiToBuffer(midiBuf);
-  return pRoot->UI_writeBufferToFile(filepath, &midiBuf[0], midiBuf.size());
+  std::ofstream out(filepath, std::ios::out | std::ios::trunc | std::ios::binary);
+  if (!out.is_open()) {
+    L_ERROR("Error: could not open file {} for writing", filepath);
+    return false;
+  }
+
+  // Each chunk is written to the file as soon as it is complete, reusing one buffer
+  std::vector<u8> buf;
+  writeHeader(buf);
+  for (auto& aTrack : m_tracks) {
+    out.write(reinterpret_cast<const char *>(buf.data()), static_cast<std::streamsize>(buf.size()));
+    buf.clear();
+    if (aTrack) {
+      globalTranspose = 0;
+      aTrack->writeTrack(buf);
+    }
+  }
+  out.write(reinterpret_cast<const char *>(buf.data()), static_cast<std::streamsize>(buf.size()));
+  globalTranspose = 0;
+
+  out.close();
+  if (out.fail()) {
+    L_ERROR("Error: failed writing {}", filepath);
+    return false;
+  }
+  return true;
 }
 
 void MidiFile::writeMidiToBuffer(std::vector<u8> &buf) {
-  size_t nNumTracks = m_tracks.size();
+  const size_t nNumTracks = writeHeader(buf);
+
+  // Reserve room for a few bytes per event so the tracks are written without reallocating
+  size_t sizeEstimate = nNumTracks * 8;
+  for (auto& aTrack : m_tracks) {
+    if (aTrack) {
+      sizeEstimate += (aTrack->events().size() + globalTrack.events().size()) * 4;
+    }
+  }
+  buf.reserve(buf.size() + sizeEstimate);
+
+  for (auto& aTrack : m_tracks) {
+    if (aTrack) {
+      globalTranspose = 0;
+      aTrack->writeTrack(buf);
+    }
+  }
+  globalTranspose = 0;
+}
+
+size_t MidiFile::writeHeader(std::vector<u8> &buf) {
+  sort();
+  globalTrack.sortEvents();
+
+  const size_t nNumTracks = std::ranges::count_if(m_tracks, [](const MidiTrack *aTrack) {
+    return aTrack != nullptr;
+  });
+
   buf.push_back('M');
   buf.push_back('T');
   buf.push_back('h');
@@ -118,18 +173,7 @@ void MidiFile::writeMidiToBuffer(std::vector<u8> &buf) {
   buf.push_back(nNumTracks & 0x00FF);         //num tracks lo
   buf.push_back((m_ppqn & 0xFF00) >> 8);
   buf.push_back(m_ppqn & 0xFF);
-
-  sort();
-
-  for (auto& aTrack : m_tracks) {
-    if (aTrack) {
-      std::vector<u8> trackBuf;
-      globalTranspose = 0;
-      aTrack->writeTrack(trackBuf);
-      buf.insert(buf.end(), trackBuf.begin(), trackBuf.end());
-    }
-  }
-  globalTranspose = 0;
+  return nNumTracks;
 }
 
 //  *********
@@ -142,55 +186,142 @@ MidiTrack::MidiTrack(MidiFile *parentSeq, bool monophonic)
       bHasEndOfTrack(false),
       channelGroup(0),
       DeltaTime(0),
-      prevDurEvent(nullptr),
       bSustain(false) {}
 
 MidiTrack::~MidiTrack() = default;
 
-MidiEvent* MidiTrack::sinkEvent(std::unique_ptr<MidiEvent>&& event) {
-  if (!event) {
-    return nullptr;
+MidiEvent &MidiTrack::addEvent(MidiEvent::Kind kind, MidiEventType type, u32 absTime, u8 channel,
+                               s8 priority) {
+  MidiEvent &event = m_events.emplace_back();
+  event.absTime = absTime;
+  event.type = type;
+  event.kind = kind;
+  event.priority = priority;
+  event.channel = channel;
+  return event;
+}
+
+void MidiTrack::addNote(u8 channel, s8 key, s8 vel, bool noteDown, u32 absTime) {
+  MidiEvent &event = addEvent(MidiEvent::Kind::Note, MIDIEVENT_NOTEON, absTime, channel, PRIORITY_LOWER);
+  event.note = {key, vel, noteDown};
+}
+
+void MidiTrack::addBlobEvent(MidiEvent::Kind kind, MidiEventType type, u32 absTime, s8 priority,
+                             const void *data, size_t size) {
+  const u32 offset = storeBlob(data, size);
+  MidiEvent &event = addEvent(kind, type, absTime, 0, priority);
+  event.blob = {offset, static_cast<u32>(size)};
+}
+
+u32 MidiTrack::storeBlob(const void *data, size_t size) {
+  const auto offset = static_cast<u32>(m_blob.size());
+  const auto *bytes = static_cast<const u8 *>(data);
+  m_blob.insert(m_blob.end(), bytes, bytes + size);
+  return offset;
+}
+
+std::string_view MidiTrack::text(const MidiEvent &event) const {
+  const auto *blob = reinterpret_cast<const char *>(m_blob.data());
+  switch (event.kind) {
+    case MidiEvent::Kind::Sysex:
+    case MidiEvent::Kind::Text:
+    case MidiEvent::Kind::TrackName:
+      return {blob + event.blob.offset, event.blob.length};
+    case MidiEvent::Kind::Marker:
+      return {blob + event.marker.nameOffset, event.marker.nameLength};
+    default:
+      return {};
   }
+}
 
-  auto* rawEvent = event.get();
-  m_ownedEvents.push_back(std::move(event));
-  m_events.push_back(rawEvent);
-  return rawEvent;
+void MidiTrack::prependEvents(std::span<const MidiEvent> events) {
+  m_events.insert(m_events.begin(), events.begin(), events.end());
+  for (size_t &index : m_prevDurNoteOffs) {
+    index += events.size();
+  }
 }
 
-void MidiTrack::prependEvents(std::vector<std::unique_ptr<MidiEvent>> events) {
-  std::vector<MidiEvent*> rawEvents;
-  rawEvents.reserve(events.size());
+void MidiTrack::appendEvents(MidiTrack &source) {
+  const auto blobBase = static_cast<u32>(m_blob.size());
+  m_blob.insert(m_blob.end(), source.m_blob.begin(), source.m_blob.end());
 
-  for (auto& event : events) {
-    if (!event) {
-      continue;
+  m_events.reserve(m_events.size() + source.m_events.size());
+  for (MidiEvent event : source.m_events) {
+    switch (event.kind) {
+      case MidiEvent::Kind::Sysex:
+      case MidiEvent::Kind::Text:
+      case MidiEvent::Kind::TrackName:
+        event.blob.offset += blobBase;
+        break;
+      case MidiEvent::Kind::Marker:
+        event.marker.nameOffset += blobBase;
+        break;
+      default:
+        break;
     }
-    rawEvents.push_back(event.get());
-    m_ownedEvents.push_back(std::move(event));
+    m_events.push_back(event);
   }
 
-  m_events.insert(m_events.begin(), rawEvents.begin(), rawEvents.end());
+  source.m_events.clear();
+  source.m_blob.clear();
+  source.m_prevDurNoteOffs.clear();
 }
 
-std::vector<std::unique_ptr<MidiEvent>> MidiTrack::releaseEvents() {
-  prevDurEvent = nullptr;
-  m_prevDurNoteOffs.clear();
-  m_events.clear();
-  return std::move(m_ownedEvents);
+void MidiTrack::sortEvents() {
+  // Same order as a stable sort by priority followed by a stable sort by time
+  auto precedes = [](const MidiEvent &a, const MidiEvent &b) {
+    return a.absTime != b.absTime ? a.absTime < b.absTime : a.priority < b.priority;
+  };
+  if (std::ranges::is_sorted(m_events, precedes))
+    return;
+
+  // Work out where each event goes, so the events are moved once and the indices of the
+  // previous dur note offs can follow them
+  std::vector<u32> order(m_events.size());
+  constexpr size_t indexBits = 24;
+  if (m_events.size() > (size_t{1} << indexBits)) {
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::stable_sort(order, [&](u32 a, u32 b) { return precedes(m_events[a], m_events[b]); });
+  } else {
+    // Pack (absTime, priority, index) into one integer key so a single plain sort does the job
+    std::vector<u64> keys(m_events.size());
+    for (size_t i = 0; i < m_events.size(); i++) {
+      const auto priority = static_cast<u8>(m_events[i].priority + 128);
+      keys[i] = (u64{m_events[i].absTime} << 32) | (u64{priority} << indexBits) | i;
+    }
+    std::ranges::sort(keys);
+    for (size_t i = 0; i < keys.size(); i++) {
+      order[i] = static_cast<u32>(keys[i] & ((size_t{1} << indexBits) - 1));
+    }
+  }
+
+  std::vector<MidiEvent> sorted(m_events.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    sorted[i] = m_events[order[i]];
+  }
+  m_events = std::move(sorted);
+
+  if (!m_prevDurNoteOffs.empty()) {
+    std::vector<u32> newIndex(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+      newIndex[order[i]] = static_cast<u32>(i);
+    }
+    for (size_t &index : m_prevDurNoteOffs) {
+      index = newIndex[index];
+    }
+  }
 }
 
 void MidiTrack::sort() {
-  std::ranges::stable_sort(m_events, PriorityCmp()); // Sort all the events by priority
-  std::ranges::stable_sort(m_events, AbsTimeCmp());  // Sort all the events by absolute time,
-                                                             // so that delta times can be recorded correctly
+  sortEvents();
   if (!bHasEndOfTrack && !m_events.empty()) {
-    addEvent<EndOfTrackEvent>(this, m_events.back()->absTime);
+    addEvent(MidiEvent::Kind::EndOfTrack, MIDIEVENT_ENDOFTRACK, m_events.back().absTime, 0, PRIORITY_LOWEST);
     bHasEndOfTrack = true;
   }
 }
 
-void MidiTrack::writeTrack(std::vector<u8> &buf) const {
+void MidiTrack::writeTrack(std::vector<u8> &buf) {
+  const size_t trackStart = buf.size();
   buf.push_back('M');
   buf.push_back('T');
   buf.push_back('r');
@@ -201,24 +332,166 @@ void MidiTrack::writeTrack(std::vector<u8> &buf) const {
   buf.push_back(0);
   u32 time = 0;  // start at 0 ticks
 
-  std::vector<MidiEvent *> finalEvents(m_events);
-  const auto& globEvents = parentSeq->globalTrack.events();
-  finalEvents.insert(finalEvents.end(), globEvents.begin(), globEvents.end());
+  // Merge in the global track's events. On ties the track's own events go first, matching a
+  // stable sort of the track's events followed by the global ones
+  MidiTrack &globalTrack = parentSeq->globalTrack;
+  const auto globEvents = std::span<const MidiEvent>(globalTrack.m_events);
+  auto event = m_events.cbegin();
+  auto globEvent = globEvents.begin();
+  while (event != m_events.cend() || globEvent != globEvents.end()) {
+    bool takeGlobal = event == m_events.cend();
+    if (!takeGlobal && globEvent != globEvents.end()) {
+      takeGlobal = globEvent->absTime != event->absTime ? globEvent->absTime < event->absTime
+                                                        : globEvent->priority < event->priority;
+    }
+    if (takeGlobal)
+      time = globalTrack.writeEvent(buf, *globEvent++, time);
+    else
+      time = writeEvent(buf, *event++, time);
+  }
+
+  size_t trackSize = buf.size() - trackStart - 8;  // -8 for MTrk and size that shouldn't be accounted for
+  buf[trackStart + 4] = static_cast<u8>((trackSize & 0xFF000000) >> 24);
+  buf[trackStart + 5] = static_cast<u8>((trackSize & 0x00FF0000) >> 16);
+  buf[trackStart + 6] = static_cast<u8>((trackSize & 0x0000FF00) >> 8);
+  buf[trackStart + 7] = static_cast<u8>(trackSize & 0x000000FF);
+}
+
+namespace {
+
+u32 writeMetaEvent(std::vector<u8> &buf, const MidiEvent &event, u32 time, u8 metaType,
+                   const void *data, size_t dataSize) {
+  MidiEvent::writeVarLength(buf, event.absTime - time);
+  buf.push_back(0xFF);
+  buf.push_back(metaType);
+  MidiEvent::writeVarLength(buf, static_cast<u32>(dataSize));
+  const auto *bytes = static_cast<const u8 *>(data);
+  buf.insert(buf.end(), bytes, bytes + dataSize);
+  return event.absTime;
+}
+
+}  // namespace
+
+// Writes one of this track's events and returns the time the next event's delta is relative to
+u32 MidiTrack::writeEvent(std::vector<u8> &buf, const MidiEvent &event, u32 time) {
+  const u8 channel = event.channel;
+  switch (event.kind) {
+    case MidiEvent::Kind::Note: {
+      const s8 key = event.note.key;
+      MidiEvent::writeVarLength(buf, event.absTime - time);
+
+      u8 finalKey = key + ((channel == 9) ? 0 : parentSeq->globalTranspose);
+
+      if (event.note.noteDown) {
+        buf.push_back(0x90 + channel);
+        if (activeNotes.contains(key)) {
+          L_WARN("During MIDI conversion, received note on event for a key with an already live note on event."
+            " Channel: {} Key: {}", channel, key);
+        }
+        activeNotes[key] = finalKey;
+      }
+      else {
+        buf.push_back(0x80 + channel);
+        if (activeNotes.contains(key)) {
+          finalKey = activeNotes[key];
+          activeNotes.erase(key);
+        } else {
+          L_WARN("During MIDI conversion, a note off event could not find a matching prior note on event."
+            " Channel: {} Key: {}", channel, key);
+        }
+      }
+
+      buf.push_back(finalKey);
+      buf.push_back(event.note.vel);
+      return event.absTime;
+    }
+
+    case MidiEvent::Kind::Controller:
+    case MidiEvent::Kind::PortamentoControl: {
+      u8 dataByte = event.controller.dataByte;
+      if (event.kind == MidiEvent::Kind::PortamentoControl) {
+        // Add the global transpose into the starting key of the portamento control event
+        dataByte = std::clamp<s16>(dataByte + parentSeq->globalTranspose, 0, 127);
+      }
+      MidiEvent::writeVarLength(buf, event.absTime - time);
+      buf.push_back(0xB0 + channel);
+      buf.push_back(event.controller.controlNum & 0x7F);
+      buf.push_back(dataByte);
+      return event.absTime;
+    }
+
+    case MidiEvent::Kind::ProgramChange:
+      MidiEvent::writeVarLength(buf, event.absTime - time);
+      buf.push_back(0xC0 + channel);
+      buf.push_back(event.programNum & 0x7F);
+      return event.absTime;
+
+    case MidiEvent::Kind::PitchBend: {
+      u8 loByte = (event.bend + 0x2000) & 0x7F;
+      u8 hiByte = ((event.bend + 0x2000) & 0x3F80) >> 7;
+      MidiEvent::writeVarLength(buf, event.absTime - time);
+      buf.push_back(0xE0 + channel);
+      buf.push_back(loByte);
+      buf.push_back(hiByte);
+      return event.absTime;
+    }
+
+    case MidiEvent::Kind::ChannelPressure:
+      MidiEvent::writeVarLength(buf, event.absTime - time);
+      buf.push_back(0xD0 + channel);
+      buf.push_back(event.pressure & 0x7F);
+      return event.absTime;
+
+    case MidiEvent::Kind::Sysex: {
+      const auto data = std::span(m_blob).subspan(event.blob.offset, event.blob.length);
+      MidiEvent::writeVarLength(buf, event.absTime - time);
+      buf.push_back(0xF0);
+      buf.insert(buf.end(), data.begin(), data.end());
+      buf.push_back(0xF7);
+      return event.absTime;
+    }
+
+    case MidiEvent::Kind::Tempo: {
+      u8 data[3] = {
+          static_cast<u8>((event.microSecs & 0xFF0000) >> 16),
+          static_cast<u8>((event.microSecs & 0x00FF00) >> 8),
+          static_cast<u8>(event.microSecs & 0x0000FF)
+      };
+      return writeMetaEvent(buf, event, time, 0x51, data, 3);
+    }
+
+    case MidiEvent::Kind::MidiPort:
+      return writeMetaEvent(buf, event, time, 0x21, &event.port, 1);
+
+    case MidiEvent::Kind::TimeSig: {
+      //denom is expressed in power of 2... so if we have 6/8 time.  it's 6 = 2^x  ==  ln6 / ln2
+      u8 data[4] = {
+          event.timeSig.numer,
+          static_cast<u8>(log(static_cast<double>(event.timeSig.denom)) / 0.69314718055994530941723212145818),
+          event.timeSig.ticksPerQuarter,
+          8
+      };
+      return writeMetaEvent(buf, event, time, 0x58, data, 4);
+    }
 
-  std::ranges::stable_sort(finalEvents, PriorityCmp()); // Sort all the events by priority
-  std::ranges::stable_sort(finalEvents, AbsTimeCmp());  // Sort all the events by absolute time,
-                                                                 // so that delta times can be recorded correctly
+    case MidiEvent::Kind::EndOfTrack:
+      return writeMetaEvent(buf, event, time, 0x2F, nullptr, 0);
 
-  size_t numEvents = finalEvents.size();
+    case MidiEvent::Kind::Text:
+    case MidiEvent::Kind::TrackName: {
+      const std::string_view str = text(event);
+      const u8 metaType = event.kind == MidiEvent::Kind::Text ? 0x01 : 0x03;
+      return writeMetaEvent(buf, event, time, metaType, str.data(), str.size());
+    }
 
-  for (size_t i = 0; i < numEvents; i++)
-    time = finalEvents[i]->writeEvent(buf, time);  // write all events into the buffer
+    case MidiEvent::Kind::GlobalTranspose:
+      parentSeq->globalTranspose = event.semitones;
+      return time;
 
-  size_t trackSize = buf.size() - 8;  // -8 for MTrk and size that shouldn't be accounted for
-  buf[4] = static_cast<u8>((trackSize & 0xFF000000) >> 24);
-  buf[5] = static_cast<u8>((trackSize & 0x00FF0000) >> 16);
-  buf[6] = static_cast<u8>((trackSize & 0x0000FF00) >> 8);
-  buf[7] = static_cast<u8>(trackSize & 0x000000FF);
+    case MidiEvent::Kind::Marker:
+      return time;
+  }
+  return time;
 }
 
 void MidiTrack::setChannelGroup(int theChannelGroup) {
@@ -247,26 +520,26 @@ void MidiTrack::resetDelta() {
 }
 
 void MidiTrack::addNoteOn(u8 channel, s8 key, s8 vel) {
-  addEvent<NoteEvent>(this, channel, getDelta(), true, key, vel);
+  addNote(channel, key, vel, true, getDelta());
 }
 
 void MidiTrack::insertNoteOn(u8 channel, s8 key, s8 vel, u32 absTime) {
-  addEvent<NoteEvent>(this, channel, absTime, true, key, vel);
+  addNote(channel, key, vel, true, absTime);
 }
 
 void MidiTrack::addNoteOff(u8 channel, s8 key) {
-  addEvent<NoteEvent>(this, channel, getDelta(), false, key);
+  addNote(channel, key, 64, false, getDelta());
 }
 
 void MidiTrack::insertNoteOff(u8 channel, s8 key, u32 absTime) {
-  addEvent<NoteEvent>(this, channel, absTime, false, key);
+  addNote(channel, key, 64, false, absTime);
 }
 
 void MidiTrack::addNoteByDur(u8 channel, s8 key, s8 vel, u32 duration) {
   purgePrevNoteOffs(getDelta());
-  addEvent<NoteEvent>(this, channel, getDelta(), true, key, vel);  // add note on
-  NoteEvent *prevDurNoteOff = addEvent<NoteEvent>(this, channel, getDelta() + duration, false, key);
-  m_prevDurNoteOffs.push_back(prevDurNoteOff);
+  addNote(channel, key, vel, true, getDelta());  // add note on
+  addNote(channel, key, 64, false, getDelta() + duration);
+  m_prevDurNoteOffs.push_back(m_events.size() - 1);
 }
 
 //TODO: MOVE! This definitely doesn't belong here.
@@ -274,7 +547,7 @@ void MidiTrack::addNoteByDur_TriAce(u8 channel, s8 key, s8 vel, u32 duration) {
   u32 CurDelta = getDelta();
   size_t nNumEvents = m_events.size();
 
-  NoteEvent* ContNote = nullptr;  // Continuted Note
+  MidiEvent* ContNote = nullptr;  // Continuted Note
   for (size_t curEvt = 0; curEvt < nNumEvents; curEvt++) {
     // Check for a event on this track with the following conditions:
     //	1. Its Event Delta Time is > current Delta Time.
@@ -286,20 +559,19 @@ void MidiTrack::addNoteByDur_TriAce(u8 channel, s8 key, s8 vel, u32 duration) {
     // Note: In previous TriAce drivers (like MegaDrive and SNES versions),
     //       a Note gets extended by a Note On event at the tick where another note expires.
     //       Valkyrie Profile: 225 Fragments of the Heart confirms, that this is NOT the case in the PS1 version.
-    if (m_events[curEvt]->absTime > CurDelta) {
-      auto* noteEvt = dynamic_cast<NoteEvent*>(m_events[curEvt]);
-      if (noteEvt != nullptr && noteEvt->key == key && !noteEvt->bNoteDown) {
-        ContNote = noteEvt;
-        break;
-      }
+    MidiEvent &event = m_events[curEvt];
+    if (event.absTime > CurDelta && event.kind == MidiEvent::Kind::Note && event.note.key == key &&
+        !event.note.noteDown) {
+      ContNote = &event;
+      break;
     }
   }
 
   if (ContNote == nullptr) {
     purgePrevNoteOffs(CurDelta);
-    addEvent<NoteEvent>(this, channel, CurDelta, true, key, vel);  // add note on
-    NoteEvent *prevDurNoteOff = addEvent<NoteEvent>(this, channel, CurDelta + duration, false, key);
-    m_prevDurNoteOffs.push_back(prevDurNoteOff);
+    addNote(channel, key, vel, true, CurDelta);  // add note on
+    addNote(channel, key, 64, false, CurDelta + duration);
+    m_prevDurNoteOffs.push_back(m_events.size() - 1);
   } else {
     ContNote->absTime = CurDelta + duration;  // fix DeltaTime of the already inserted NoteOff event
   }
@@ -307,9 +579,9 @@ void MidiTrack::addNoteByDur_TriAce(u8 channel, s8 key, s8 vel, u32 duration) {
 
 void MidiTrack::insertNoteByDur(u8 channel, s8 key, s8 vel, u32 duration, u32 absTime) {
   purgePrevNoteOffs(std::max(getDelta(), absTime));
-  addEvent<NoteEvent>(this, channel, absTime, true, key, vel);  // add note on
-  NoteEvent *prevDurNoteOff = addEvent<NoteEvent>(this, channel, absTime + duration, false, key);
-  m_prevDurNoteOffs.push_back(prevDurNoteOff);
+  addNote(channel, key, vel, true, absTime);  // add note on
+  addNote(channel, key, 64, false, absTime + duration);
+  m_prevDurNoteOffs.push_back(m_events.size() - 1);
 }
 
 void MidiTrack::purgePrevNoteOffs() {
@@ -317,167 +589,171 @@ void MidiTrack::purgePrevNoteOffs() {
 }
 
 void MidiTrack::purgePrevNoteOffs(u32 absTime) {
-  m_prevDurNoteOffs.erase(std::remove_if(m_prevDurNoteOffs.begin(), m_prevDurNoteOffs.end(),
-    [absTime](const NoteEvent *e) { return e && e->absTime <= absTime; }),
-    m_prevDurNoteOffs.end());
+  std::erase_if(m_prevDurNoteOffs, [this, absTime](size_t index) {
+    return m_events[index].absTime <= absTime;
+  });
 }
 
 void MidiTrack::addControllerEvent(u8 channel, u8 controllerNum, u8 theDataByte) {
-  addEvent<ControllerEvent>(this, channel, getDelta(), controllerNum, theDataByte);
+  m_events.push_back(MidiEvent::makeController(getDelta(), channel, controllerNum, theDataByte));
 }
 
 void MidiTrack::insertControllerEvent(u8 channel, u8 controllerNum, u8 theDataByte, u32 absTime) {
-  addEvent<ControllerEvent>(this, channel, absTime, controllerNum, theDataByte);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, controllerNum, theDataByte));
 }
 
 void MidiTrack::addVol(u8 channel, u8 vol) {
-  addEvent<VolumeEvent>(this, channel, getDelta(), vol);
+  insertVol(channel, vol, getDelta());
 }
 
 void MidiTrack::insertVol(u8 channel, u8 vol, u32 absTime) {
-  addEvent<VolumeEvent>(this, channel, absTime, vol);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 7, vol, PRIORITY_MIDDLE, MIDIEVENT_VOLUME));
 }
 
 void MidiTrack::addVolumeFine(u8 channel, u8 volume_lsb) {
-  addEvent<VolumeFineEvent>(this, channel, getDelta(), volume_lsb);
+  insertVolumeFine(channel, volume_lsb, getDelta());
 }
 
 void MidiTrack::insertVolumeFine(u8 channel, u8 volume_lsb, u32 absTime) {
-  addEvent<VolumeFineEvent>(this, channel, absTime, volume_lsb);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 39, volume_lsb, PRIORITY_MIDDLE, MIDIEVENT_VOLUME));
 }
 
 //TODO: Master Volume sysex events are meant to be global to device, not per channel.
 // For per channel master volume, we should add a system for normalizing controller vol events.
 void MidiTrack::addMasterVol(u8 channel, u8 volMsb, u8 volLsb) {
-  addEvent<MasterVolEvent>(this, channel, getDelta(), volMsb, volLsb);
+  insertMasterVol(channel, volMsb, volLsb, getDelta());
 }
 
 void MidiTrack::insertMasterVol(u8 channel, u8 volMsb, u32 absTime) {
   insertMasterVol(channel, volMsb, 0, absTime);
 }
 
-void MidiTrack::insertMasterVol(u8 channel, u8 volMsb, u8 volLsb, u32 absTime) {
-  addEvent<MasterVolEvent>(this, channel, absTime, volMsb, volLsb);
+void MidiTrack::insertMasterVol(u8 /* channel */, u8 volMsb, u8 volLsb, u32 absTime) {
+  const u8 data[] = {0x07, 0x7F, 0x7F, 0x04, 0x01, volLsb, volMsb};
+  addBlobEvent(MidiEvent::Kind::Sysex, MIDIEVENT_MASTERVOL, absTime, PRIORITY_HIGHER, data, sizeof(data));
 }
 
 void MidiTrack::addExpression(u8 channel, u8 expression) {
-  addEvent<ExpressionEvent>(this, channel, getDelta(), expression);
+  insertExpression(channel, expression, getDelta());
 }
 
 void MidiTrack::insertExpression(u8 channel, u8 expression, u32 absTime) {
-  addEvent<ExpressionEvent>(this, channel, absTime, expression);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 11, expression, PRIORITY_MIDDLE, MIDIEVENT_EXPRESSION));
 }
 
 void MidiTrack::addExpressionFine(u8 channel, u8 expression_lsb) {
-  addEvent<ExpressionFineEvent>(this, channel, getDelta(), expression_lsb);
+  insertExpressionFine(channel, expression_lsb, getDelta());
 }
 
 void MidiTrack::insertExpressionFine(u8 channel, u8 expression_lsb, u32 absTime) {
-  addEvent<ExpressionFineEvent>(this, channel, absTime, expression_lsb);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 43, expression_lsb, PRIORITY_MIDDLE, MIDIEVENT_EXPRESSION));
 }
 
 void MidiTrack::addSustain(u8 channel, u8 depth) {
-  addEvent<SustainEvent>(this, channel, getDelta(), depth);
+  insertSustain(channel, depth, getDelta());
 }
 
 void MidiTrack::insertSustain(u8 channel, u8 depth, u32 absTime) {
-  addEvent<SustainEvent>(this, channel, absTime, depth);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 64, depth, PRIORITY_MIDDLE, MIDIEVENT_SUSTAIN));
 }
 
 void MidiTrack::addPortamento(u8 channel, bool bOn) {
-  addEvent<PortamentoEvent>(this, channel, getDelta(), bOn);
+  insertPortamento(channel, bOn, getDelta());
 }
 
 void MidiTrack::insertPortamento(u8 channel, bool bOn, u32 absTime) {
-  addEvent<PortamentoEvent>(this, channel, absTime, bOn);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 65, bOn ? 0x7F : 0, PRIORITY_MIDDLE, MIDIEVENT_PORTAMENTO));
 }
 
 void MidiTrack::addPortamentoTime(u8 channel, u8 time) {
-  addEvent<PortamentoTimeEvent>(this, channel, getDelta(), time);
+  insertPortamentoTime(channel, time, getDelta());
 }
 
 void MidiTrack::insertPortamentoTime(u8 channel, u8 time, u32 absTime) {
-  addEvent<PortamentoTimeEvent>(this, channel, absTime, time);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 5, time, PRIORITY_MIDDLE, MIDIEVENT_PORTAMENTOTIME));
 }
 
 void MidiTrack::addPortamentoTimeFine(u8 channel, u8 time) {
-  addEvent<PortamentoTimeFineEvent>(this, channel, getDelta(), time);
+  insertPortamentoTimeFine(channel, time, getDelta());
 }
 
 void MidiTrack::insertPortamentoTimeFine(u8 channel, u8 time, u32 absTime) {
-  addEvent<PortamentoTimeFineEvent>(this, channel, absTime, time);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 37, time, PRIORITY_MIDDLE, MIDIEVENT_PORTAMENTOTIMEFINE));
 }
 
 void MidiTrack::addPortamentoControl(u8 channel, u8 key) {
-  addEvent<PortamentoControlEvent>(this, channel, getDelta(), key);
+  insertPortamentoControl(channel, key, getDelta());
 }
 
 void MidiTrack::insertPortamentoControl(u8 channel, u8 key, u32 absTime) {
-  addEvent<PortamentoControlEvent>(this, channel, absTime, key);
+  MidiEvent event = MidiEvent::makeController(absTime, channel, 84, key, PRIORITY_MIDDLE, MIDIEVENT_PORTAMENTOCONTROL);
+  event.kind = MidiEvent::Kind::PortamentoControl;
+  m_events.push_back(event);
 }
 
 void MidiTrack::addMono(u8 channel) {
-  addEvent<MonoEvent>(this, channel, getDelta());
+  insertMono(channel, getDelta());
 }
 
 void MidiTrack::insertMono(u8 channel, u32 absTime) {
-  addEvent<MonoEvent>(this, channel, absTime);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 126, 0, PRIORITY_HIGHER, MIDIEVENT_MONO));
 }
 
 void MidiTrack::addLegatoPedal(u8 channel, bool bOn) {
-  addEvent<LegatoPedalEvent>(this, channel, getDelta(), bOn);
+  insertLegatoPedal(channel, bOn, getDelta());
 }
 
 void MidiTrack::insertLegatoPedal(u8 channel, bool bOn, u32 absTime) {
-  addEvent<LegatoPedalEvent>(this, channel, absTime, bOn);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 68, bOn ? 0x7F : 0, PRIORITY_HIGH, MIDIEVENT_LEGATOPEDAL));
 }
 
 void MidiTrack::addPan(u8 channel, u8 pan) {
-  addEvent<PanEvent>(this, channel, getDelta(), pan);
+  insertPan(channel, pan, getDelta());
 }
 
 void MidiTrack::insertPan(u8 channel, u8 pan, u32 absTime) {
-  addEvent<PanEvent>(this, channel, absTime, pan);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 10, pan, PRIORITY_MIDDLE, MIDIEVENT_PAN));
 }
 
 void MidiTrack::addReverb(u8 channel, u8 reverb) {
-  addEvent<ControllerEvent>(this, channel, getDelta(), 91, reverb);
+  insertReverb(channel, reverb, getDelta());
 }
 
 void MidiTrack::insertReverb(u8 channel, u8 reverb, u32 absTime) {
-  addEvent<ControllerEvent>(this, channel, absTime, 91, reverb);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 91, reverb));
 }
 
 void MidiTrack::addModulation(u8 channel, u8 depth) {
-  addEvent<ModulationEvent>(this, channel, getDelta(), depth);
+  m_events.push_back(MidiEvent::makeController(getDelta(), channel, 1, depth, PRIORITY_MIDDLE, MIDIEVENT_MODULATION));
 }
 
 void MidiTrack::insertModulation(u8 channel, u8 depth, u32 absTime) {
-  addEvent<ControllerEvent>(this, channel, absTime, 1, depth);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 1, depth));
 }
 
 void MidiTrack::addBreath(u8 channel, u8 depth) {
-  addEvent<BreathEvent>(this, channel, getDelta(), depth);
+  m_events.push_back(MidiEvent::makeController(getDelta(), channel, 2, depth, PRIORITY_MIDDLE, MIDIEVENT_BREATH));
 }
 
 void MidiTrack::insertBreath(u8 channel, u8 depth, u32 absTime) {
-  addEvent<ControllerEvent>(this, channel, absTime, 2, depth);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 2, depth));
 }
 
 void MidiTrack::addPitchBend(u8 channel, s16 bend) {
-  addEvent<PitchBendEvent>(this, channel, getDelta(), bend);
+  insertPitchBend(channel, bend, getDelta());
 }
 
 void MidiTrack::insertPitchBend(u8 channel, s16 bend, u32 absTime) {
-  addEvent<PitchBendEvent>(this, channel, absTime, bend);
+  addEvent(MidiEvent::Kind::PitchBend, MIDIEVENT_PITCHBEND, absTime, channel, PRIORITY_MIDDLE).bend = bend;
 }
 
 void MidiTrack::addChannelPressure(u8 channel, u8 pressure) {
-  addEvent<ChannelPressureEvent>(this, channel, getDelta(), pressure);
+  insertChannelPressure(channel, pressure, getDelta());
 }
 
 void MidiTrack::insertChannelPressure(u8 channel, u8 pressure, u32 absTime) {
-  addEvent<ChannelPressureEvent>(this, channel, absTime, pressure);
+  addEvent(MidiEvent::Kind::ChannelPressure, MIDIEVENT_CHANNELPRESSURE, absTime, channel, PRIORITY_MIDDLE)
+      .pressure = pressure;
 }
 
 void MidiTrack::addPitchBendRange(u8 channel, u16 cents) {
@@ -488,10 +764,10 @@ void MidiTrack::insertPitchBendRange(u8 channel, u16 cents, u32 absTime) {
   u8 semitones = cents / 100;
   u8 finetune_cents = cents % 100;
   // We push the LSB controller event first as somee virtual instruments only react upon receiving MSB
-  addEvent<ControllerEvent>(this, channel, absTime, 101, 0, PRIORITY_HIGHER - 1);
-  addEvent<ControllerEvent>(this, channel, absTime, 100, 0, PRIORITY_HIGHER - 1);
-  addEvent<ControllerEvent>(this, channel, absTime, 38, finetune_cents, PRIORITY_HIGHER - 1);
-  addEvent<ControllerEvent>(this, channel, absTime, 6, semitones, PRIORITY_HIGHER - 1);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 101, 0, PRIORITY_HIGHER - 1));
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 100, 0, PRIORITY_HIGHER - 1));
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 38, finetune_cents, PRIORITY_HIGHER - 1));
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 6, semitones, PRIORITY_HIGHER - 1));
 }
 
 void MidiTrack::addFineTuning(u8 channel, u8 msb, u8 lsb) {
@@ -500,10 +776,10 @@ void MidiTrack::addFineTuning(u8 channel, u8 msb, u8 lsb) {
 
 void MidiTrack::insertFineTuning(u8 channel, u8 msb, u8 lsb, u32 absTime) {
   // We push the LSB controller event first as somee virtual instruments only react upon receiving MSB
-  addEvent<ControllerEvent>(this, channel, absTime, 101, 0, PRIORITY_HIGHER - 1);
-  addEvent<ControllerEvent>(this, channel, absTime, 100, 1, PRIORITY_HIGHER - 1);
-  addEvent<ControllerEvent>(this, channel, absTime, 38, lsb, PRIORITY_HIGHER - 1);
-  addEvent<ControllerEvent>(this, channel, absTime, 6, msb, PRIORITY_HIGHER - 1);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 101, 0, PRIORITY_HIGHER - 1));
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 100, 1, PRIORITY_HIGHER - 1));
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 38, lsb, PRIORITY_HIGHER - 1));
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 6, msb, PRIORITY_HIGHER - 1));
 }
 
 void MidiTrack::addFineTuning(u8 channel, double cents) {
@@ -522,10 +798,10 @@ void MidiTrack::addCoarseTuning(u8 channel, u8 msb, u8 lsb) {
 }
 
 void MidiTrack::insertCoarseTuning(u8 channel, u8 msb, u8 lsb, u32 absTime) {
-  addEvent<ControllerEvent>(this, channel, absTime, 101, 0, PRIORITY_HIGHER - 1);
-  addEvent<ControllerEvent>(this, channel, absTime, 100, 2, PRIORITY_HIGHER - 1);
-  addEvent<ControllerEvent>(this, channel, absTime, 38, lsb, PRIORITY_HIGHER - 1);
-  addEvent<ControllerEvent>(this, channel, absTime, 6, msb, PRIORITY_HIGHER - 1);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 101, 0, PRIORITY_HIGHER - 1));
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 100, 2, PRIORITY_HIGHER - 1));
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 38, lsb, PRIORITY_HIGHER - 1));
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 6, msb, PRIORITY_HIGHER - 1));
 }
 
 void MidiTrack::addCoarseTuning(u8 channel, double semitones) {
@@ -543,10 +819,10 @@ void MidiTrack::addModulationDepthRange(u8 channel, u8 msb, u8 lsb) {
 }
 
 void MidiTrack::insertModulationDepthRange(u8 channel, u8 msb, u8 lsb, u32 absTime) {
-  addEvent<ControllerEvent>(this, channel, absTime, 101, 0, PRIORITY_HIGHER - 1);
-  addEvent<ControllerEvent>(this, channel, absTime, 100, 5, PRIORITY_HIGHER - 1);
-  addEvent<ControllerEvent>(this, channel, absTime, 38, lsb, PRIORITY_HIGHER - 1);
-  addEvent<ControllerEvent>(this, channel, absTime, 6, msb, PRIORITY_HIGHER - 1);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 101, 0, PRIORITY_HIGHER - 1));
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 100, 5, PRIORITY_HIGHER - 1));
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 38, lsb, PRIORITY_HIGHER - 1));
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 6, msb, PRIORITY_HIGHER - 1));
 }
 
 void MidiTrack::addModulationDepthRange(u8 channel, double semitones) {
@@ -560,125 +836,129 @@ void MidiTrack::insertModulationDepthRange(u8 channel, double semitones, u32 abs
 }
 
 void MidiTrack::addProgramChange(u8 channel, u8 progNum) {
-  addEvent<ProgChangeEvent>(this, channel, getDelta(), progNum);
+  addEvent(MidiEvent::Kind::ProgramChange, MIDIEVENT_PROGRAMCHANGE, getDelta(), channel, PRIORITY_HIGH)
+      .programNum = progNum;
 }
 
 void MidiTrack::addBankSelect(u8 channel, u8 bank) {
-  addEvent<BankSelectEvent>(this, channel, getDelta(), bank);
+  m_events.push_back(MidiEvent::makeController(getDelta(), channel, 0, bank, PRIORITY_HIGH, MIDIEVENT_BANKSELECT));
 }
 
 void MidiTrack::addBankSelectFine(u8 channel, u8 lsb) {
-  addEvent<BankSelectFineEvent>(this, channel, getDelta(), lsb);
+  m_events.push_back(MidiEvent::makeController(getDelta(), channel, 32, lsb, PRIORITY_HIGH, MIDIEVENT_BANKSELECTFINE));
 }
 
 void MidiTrack::insertBankSelect(u8 channel, u8 bank, u32 absTime) {
-  addEvent<ControllerEvent>(this, channel, absTime, 0, bank);
+  m_events.push_back(MidiEvent::makeController(absTime, channel, 0, bank));
 }
 
 void MidiTrack::addTempo(u32 microSeconds) {
-  addEvent<TempoEvent>(this, getDelta(), microSeconds);
+  insertTempo(microSeconds, getDelta());
   //bAddedTempo = true;
 }
 
 void MidiTrack::addTempoBPM(double BPM) {
-  u32 microSecs = static_cast<u32>(std::round(60000000.0 / BPM));
-  addEvent<TempoEvent>(this, getDelta(), microSecs);
+  insertTempoBPM(BPM, getDelta());
   //bAddedTempo = true;
 }
 
 void MidiTrack::insertTempo(u32 microSeconds, u32 absTime) {
-  addEvent<TempoEvent>(this, absTime, microSeconds);
+  addEvent(MidiEvent::Kind::Tempo, MIDIEVENT_TEMPO, absTime, 0, PRIORITY_HIGHEST).microSecs = microSeconds;
   //bAddedTempo = true;
 }
 
 void MidiTrack::insertTempoBPM(double BPM, u32 absTime) {
   u32 microSecs = static_cast<u32>(std::round(60000000.0 / BPM));
-  addEvent<TempoEvent>(this, absTime, microSecs);
+  insertTempo(microSecs, absTime);
   //bAddedTempo = true;
 }
 
 void MidiTrack::addMidiPort(u8 port) {
-  addEvent<MidiPortEvent>(this, getDelta(), port);
+  insertMidiPort(port, getDelta());
 }
 
 void MidiTrack::insertMidiPort(u8 port, u32 absTime) {
-  addEvent<MidiPortEvent>(this, absTime, port);
+  addEvent(MidiEvent::Kind::MidiPort, MIDIEVENT_MIDIPORT, absTime, 0, PRIORITY_HIGHEST).port = port;
 }
 
 void MidiTrack::addTimeSig(u8 numer, u8 denom, u8 ticksPerQuarter) {
-  addEvent<TimeSigEvent>(this, getDelta(), numer, denom, ticksPerQuarter);
+  insertTimeSig(numer, denom, ticksPerQuarter, getDelta());
   //bAddedTimeSig = true;
 }
 
 void MidiTrack::insertTimeSig(u8 numer, u8 denom, u8 ticksPerQuarter, u32 absTime) {
-  addEvent<TimeSigEvent>(this, absTime, numer, denom, ticksPerQuarter);
+  addEvent(MidiEvent::Kind::TimeSig, MIDIEVENT_TIMESIG, absTime, 0, PRIORITY_HIGHEST).timeSig =
+      {numer, denom, ticksPerQuarter};
   //bAddedTimeSig = true;
 }
 
 void MidiTrack::addEndOfTrack() {
-  addEvent<EndOfTrackEvent>(this, getDelta());
-  bHasEndOfTrack = true;
+  insertEndOfTrack(getDelta());
 }
 
 void MidiTrack::insertEndOfTrack(u32 absTime) {
-  addEvent<EndOfTrackEvent>(this, absTime);
+  addEvent(MidiEvent::Kind::EndOfTrack, MIDIEVENT_ENDOFTRACK, absTime, 0, PRIORITY_LOWEST);
   bHasEndOfTrack = true;
 }
 
 void MidiTrack::addText(const std::string &str) {
-  addEvent<TextEvent>(this, getDelta(), str);
+  insertText(str, getDelta());
 }
 
 void MidiTrack::insertText(const std::string &str, u32 absTime) {
-  addEvent<TextEvent>(this, absTime, str);
+  addBlobEvent(MidiEvent::Kind::Text, MIDIEVENT_TEXT, absTime, PRIORITY_LOWEST, str.data(), str.size());
 }
 
 void MidiTrack::addSeqName(const std::string &str) {
-  addEvent<SeqNameEvent>(this, getDelta(), str);
+  insertSeqName(str, getDelta());
 }
 
 void MidiTrack::insertSeqName(const std::string &str, u32 absTime) {
-  addEvent<SeqNameEvent>(this, absTime, str);
+  addBlobEvent(MidiEvent::Kind::TrackName, MIDIEVENT_TEXT, absTime, PRIORITY_LOWEST, str.data(), str.size());
 }
 
 void MidiTrack::addTrackName(const std::string &str) {
-  addEvent<TrackNameEvent>(this, getDelta(), str);
+  insertTrackName(str, getDelta());
 }
 
 void MidiTrack::insertTrackName(const std::string &str, u32 absTime) {
-  addEvent<TrackNameEvent>(this, absTime, str);
+  addBlobEvent(MidiEvent::Kind::TrackName, MIDIEVENT_TEXT, absTime, PRIORITY_LOWEST, str.data(), str.size());
 }
 
 void MidiTrack::addGMReset() {
-  addEvent<GMResetEvent>(this, getDelta());
+  insertGMReset(getDelta());
 }
 
 void MidiTrack::insertGMReset(u32 absTime) {
-  addEvent<GMResetEvent>(this, absTime);
+  const u8 data[] = {0x05, 0x7E, 0x7F, 0x09, 0x01};
+  addBlobEvent(MidiEvent::Kind::Sysex, MIDIEVENT_RESET, absTime, PRIORITY_HIGHEST, data, sizeof(data));
 }
 
 void MidiTrack::addGM2Reset() {
-  addEvent<GM2ResetEvent>(this, getDelta());
+  insertGM2Reset(getDelta());
 }
 
 void MidiTrack::insertGM2Reset(u32 absTime) {
-  addEvent<GM2ResetEvent>(this, absTime);
+  const u8 data[] = {0x05, 0x7E, 0x7F, 0x09, 0x03};
+  addBlobEvent(MidiEvent::Kind::Sysex, MIDIEVENT_RESET, absTime, PRIORITY_HIGHEST, data, sizeof(data));
 }
 
 void MidiTrack::addGSReset() {
-  addEvent<GSResetEvent>(this, getDelta());
+  insertGSReset(getDelta());
 }
 
 void MidiTrack::insertGSReset(u32 absTime) {
-  addEvent<GSResetEvent>(this, absTime);
+  const u8 data[] = {0x0A, 0x41, 0x10, 0x42, 0x12, 0x40, 0x00, 0x7F, 0x00, 0x41};
+  addBlobEvent(MidiEvent::Kind::Sysex, MIDIEVENT_RESET, absTime, PRIORITY_HIGHEST, data, sizeof(data));
 }
 
 void MidiTrack::addXGReset() {
-  addEvent<XGResetEvent>(this, getDelta());
+  insertXGReset(getDelta());
 }
 
 void MidiTrack::insertXGReset(u32 absTime) {
-  addEvent<XGResetEvent>(this, absTime);
+  const u8 data[] = {0x08, 0x43, 0x10, 0x4C, 0x00, 0x00, 0x7E, 0x00};
+  addBlobEvent(MidiEvent::Kind::Sysex, MIDIEVENT_RESET, absTime, PRIORITY_HIGHEST, data, sizeof(data));
 }
 
 // SPECIAL NON-MIDI EVENTS
@@ -686,13 +966,9 @@ void MidiTrack::insertXGReset(u32 absTime) {
 // Transpose events offset the key when we write the Midi file.
 //  used to implement global transpose events found in QSound
 
-//void MidiTrack::AddTranspose(s8 semitones)
-//{
-//	addEvent<TransposeEvent>(this, GetDelta(), semitones);
-//}
-
 void MidiTrack::insertGlobalTranspose(u32 absTime, s8 semitones) {
-  addEvent<GlobalTransposeEvent>(this, absTime, semitones);
+  addEvent(MidiEvent::Kind::GlobalTranspose, MIDIEVENT_GLOBALTRANSPOSE, absTime, 0, PRIORITY_HIGHEST)
+      .semitones = semitones;
 }
 
 
@@ -701,7 +977,7 @@ void MidiTrack::addMarker(u8 channel,
                           u8 databyte1,
                           u8 databyte2,
                           s8 priority) {
-  addEvent<MarkerEvent>(this, channel, getDelta(), markername, databyte1, databyte2, priority);
+  insertMarker(channel, markername, databyte1, databyte2, priority, getDelta());
 }
 
 void MidiTrack::insertMarker(u8 channel,
@@ -710,19 +986,17 @@ void MidiTrack::insertMarker(u8 channel,
                   u8 databyte2,
                   s8 priority,
                   u32 absTime) {
-  addEvent<MarkerEvent>(this, channel, absTime, markername, databyte1, databyte2, priority);
+  const auto nameLength = static_cast<u16>(std::min<size_t>(markername.size(), std::numeric_limits<u16>::max()));
+  const u32 nameOffset = storeBlob(markername.data(), nameLength);
+  addEvent(MidiEvent::Kind::Marker, MIDIEVENT_MARKER, absTime, channel, priority).marker =
+      {nameOffset, nameLength, databyte1, databyte2};
 }
 
 //  *********
 //  MidiEvent
 //  *********
 
-MidiEvent::MidiEvent(MidiTrack *track, u32 absoluteTime, u8 channel, s8 priority)
-    : prntTrk(track), channel(channel), absTime(absoluteTime), priority(priority) {
-}
-
-bool MidiEvent::isMetaEvent() {
-  MidiEventType type = eventType();
+bool MidiEvent::isMetaEvent() const {
   return type == MIDIEVENT_TEMPO ||
          type == MIDIEVENT_TEXT ||
          type == MIDIEVENT_MIDIPORT ||
@@ -730,8 +1004,7 @@ bool MidiEvent::isMetaEvent() {
          type == MIDIEVENT_ENDOFTRACK;
 }
 
-bool MidiEvent::isSysexEvent() {
-  MidiEventType type = eventType();
+bool MidiEvent::isSysexEvent() const {
   return type == MIDIEVENT_MASTERVOL ||
          type == MIDIEVENT_RESET;
 }
@@ -753,25 +1026,6 @@ void MidiEvent::writeVarLength(std::vector<u8> &buf, u32 value) {
   }
 }
 
-u32 MidiEvent::writeMetaEvent(std::vector<u8> &buf,
-                                   u32 time,
-                                   u8 metaType,
-                                   const u8* data,
-                                   size_t dataSize) const {
-  writeVarLength(buf, absTime - time);
-  buf.push_back(0xFF);
-  buf.push_back(metaType);
-  writeVarLength(buf, static_cast<u32>(dataSize));
-  for (size_t dataIndex = 0; dataIndex < dataSize; dataIndex++) {
-    buf.push_back(data[dataIndex]);
-  }
-  return absTime;
-}
-
-u32 MidiEvent::writeMetaTextEvent(std::vector<u8> &buf, u32 time, u8 metaType, const std::string& str) const {
-  return writeMetaEvent(buf, time, metaType, (u8 *)str.c_str(), str.length());
-}
-
 std::string MidiEvent::getNoteName(int noteNumber) {
   const char* noteNames[12] = {"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"};
 
@@ -788,314 +1042,3 @@ std::string MidiEvent::getNoteName(int noteNumber) {
 
   return fmt::format("{} {}", noteNames[key], octave);
 }
-
-bool MidiEvent::operator<(const MidiEvent &theMidiEvent) const {
-  return (absTime < theMidiEvent.absTime);
-}
-
-bool MidiEvent::operator>(const MidiEvent &theMidiEvent) const {
-  return (absTime > theMidiEvent.absTime);
-}
-
-//  *********
-//  NoteEvent
-//  *********
-
-
-NoteEvent::NoteEvent(MidiTrack *track,
-                     u8 channel,
-                     u32 absoluteTime,
-                     bool bNoteDown,
-                     u8 key,
-                     u8 vel)
-    : MidiEvent(track, absoluteTime, channel, PRIORITY_LOWER),
-      bNoteDown(bNoteDown),
-      key(key),
-      vel(vel) {
-}
-
-u32 NoteEvent::writeEvent(std::vector<u8> &buf, u32 time) {
-  writeVarLength(buf, absTime - time);
-
-  u8 finalKey = key + ((channel == 9) ? 0 : prntTrk->parentSeq->globalTranspose);
-
-  if (bNoteDown) {
-    buf.push_back(0x90 + channel);
-    if (prntTrk->activeNotes.contains(key)) {
-      L_WARN("During MIDI conversion, received note on event for a key with an already live note on event."
-        " Channel: {} Key: {}", channel, key);
-    }
-    prntTrk->activeNotes[key] = finalKey;
-  }
-  else {
-    buf.push_back(0x80 + channel);
-    if (prntTrk->activeNotes.contains(key)) {
-      finalKey = prntTrk->activeNotes[key];
-      prntTrk->activeNotes.erase(key);
-    } else {
-      L_WARN("During MIDI conversion, a note off event could not find a matching prior note on event."
-        " Channel: {} Key: {}", channel, key);
-    }
-  }
-
-  buf.push_back(finalKey);
-  buf.push_back(vel);
-
-  return absTime;
-}
-
-//  ************
-//  DurNoteEvent
-//  ************
-
-//DurNoteEvent::DurNoteEvent(MidiTrack* prntTrk, u8 channel, u32 absoluteTime, u8 theKey, u8 theVel, u32 theDur)
-//: MidiEvent(prntTrk, absoluteTime, channel, PRIORITY_LOWER), key(theKey), vel(theVel), duration(theDur)
-//{
-//}
-/*void DurNoteEvent::PrepareWrite(vector<MidiEvent*> & m_events)
-{
-	prntTrk->addEvent<NoteEvent>(prntTrk, channel, AbsTime, true, key, vel);	//add note on
-	prntTrk->addEvent<NoteEvent>(prntTrk, channel, AbsTime+duration, false, key, vel);  //add note off at end of dur
-}*/
-
-//u32 DurNoteEvent::WriteEvent(vector<u8> & buf, u32 time)		//we do note use WriteEvent on DurNoteEvents... this is what PrepareWrite is for, to create NoteEvents in substitute
-//{
-//	return false;
-//}
-
-//  ********
-//  VolEvent
-//  ********
-
-/*VolEvent::VolEvent(MidiTrack *prntTrk, u8 channel, u32 absoluteTime, u8 theVol, s8 thePriority)
-: ControllerEvent(prntTrk, channel, absoluteTime, 7), vol(theVol)
-{
-}
-
-*/
-
-//  ***************
-//  ControllerEvent
-//  ***************
-
-ControllerEvent::ControllerEvent(MidiTrack *track,
-                                 u8 channel,
-                                 u32 absoluteTime,
-                                 u8 controllerNum,
-                                 u8 dataByte,
-                                 s8 priority)
-    : MidiEvent(track, absoluteTime, channel, priority), controlNum(controllerNum), dataByte(dataByte) {
-}
-
-u32 ControllerEvent::writeEvent(std::vector<u8> &buf, u32 time) {
-  writeVarLength(buf, absTime - time);
-  buf.push_back(0xB0 + channel);
-  buf.push_back(controlNum & 0x7F);
-  buf.push_back(dataByte);
-  return absTime;
-}
-
-//  **********************
-//  PortamentoControlEvent
-//  **********************
-
-u32 PortamentoControlEvent::writeEvent(std::vector<u8> &buf, u32 time) {
-  // Add the global transpose into the starting key of the portamento control event
-  u8 originalDataByte = dataByte;
-  dataByte = std::clamp<s16>(dataByte + prntTrk->parentSeq->globalTranspose, 0, 127);
-  u32 result = ControllerEvent::writeEvent(buf, time);
-  dataByte = originalDataByte;
-  return result;
-}
-
-//  **********
-//  SysexEvent
-//  **********
-
-SysexEvent::SysexEvent(MidiTrack *track,
-                       u32 absoluteTime,
-                       const std::vector<u8>& sysexData,
-                       s8 priority)
-    : MidiEvent(track, absoluteTime, 0, priority), sysexData(sysexData) {
-}
-
-u32 SysexEvent::writeEvent(std::vector<u8> &buf, u32 time) {
-  writeVarLength(buf, absTime - time);
-  buf.push_back(0xF0);
-  buf.insert(buf.end(), sysexData.begin(), sysexData.end());
-  buf.push_back(0xF7);
-  return absTime;
-}
-
-//  ***************
-//  ProgChangeEvent
-//  ***************
-
-ProgChangeEvent::ProgChangeEvent(MidiTrack *track, u8 channel, u32 absoluteTime, u8 progNum)
-    : MidiEvent(track, absoluteTime, channel, PRIORITY_HIGH), programNum(progNum) {
-}
-
-u32 ProgChangeEvent::writeEvent(std::vector<u8> &buf, u32 time) {
-  writeVarLength(buf, absTime - time);
-  buf.push_back(0xC0 + channel);
-  buf.push_back(programNum & 0x7F);
-  return absTime;
-}
-
-//  **************
-//  PitchBendEvent
-//  **************
-
-PitchBendEvent::PitchBendEvent(MidiTrack *track, u8 channel, u32 absoluteTime, s16 bend)
-    : MidiEvent(track, absoluteTime, channel, PRIORITY_MIDDLE), bend(bend) {
-}
-
-u32 PitchBendEvent::writeEvent(std::vector<u8> &buf, u32 time) {
-  u8 loByte = (bend + 0x2000) & 0x7F;
-  u8 hiByte = ((bend + 0x2000) & 0x3F80) >> 7;
-  writeVarLength(buf, absTime - time);
-  buf.push_back(0xE0 + channel);
-  buf.push_back(loByte);
-  buf.push_back(hiByte);
-  return absTime;
-}
-
-//  ********************
-//  ChannelPressureEvent
-//  ********************
-
-ChannelPressureEvent::ChannelPressureEvent(MidiTrack *track,
-                                           u8 channel,
-                                           u32 absoluteTime,
-                                           u8 pressure)
-    : MidiEvent(track, absoluteTime, channel, PRIORITY_MIDDLE), pressure(pressure) {
-}
-
-u32 ChannelPressureEvent::writeEvent(std::vector<u8> &buf, u32 time) {
-  writeVarLength(buf, absTime - time);
-  buf.push_back(0xD0 + channel);
-  buf.push_back(pressure & 0x7F);
-  return absTime;
-}
-
-//  **********
-//  TempoEvent
-//  **********
-
-TempoEvent::TempoEvent(MidiTrack *track, u32 absoluteTime, u32 microSeconds)
-    : MidiEvent(track, absoluteTime, 0, PRIORITY_HIGHEST), microSecs(microSeconds) {
-}
-
-u32 TempoEvent::writeEvent(std::vector<u8> &buf, u32 time) {
-  u8 data[3] = {
-      static_cast<u8>((microSecs & 0xFF0000) >> 16),
-      static_cast<u8>((microSecs & 0x00FF00) >> 8),
-      static_cast<u8>(microSecs & 0x0000FF)
-  };
-  return writeMetaEvent(buf, time, 0x51, data, 3);
-}
-
-
-//  *************
-//  MidiPortEvent
-//  *************
-
-MidiPortEvent::MidiPortEvent(MidiTrack *track, u32 absoluteTime, u8 port)
-    : MidiEvent(track, absoluteTime, 0, PRIORITY_HIGHEST), port(port) {
-}
-
-u32 MidiPortEvent::writeEvent(std::vector<u8> &buf, u32 time) {
-  return writeMetaEvent(buf, time, 0x21, &port, 1);
-}
-
-
-//  ************
-//  TimeSigEvent
-//  ************
-
-TimeSigEvent::TimeSigEvent(MidiTrack *track,
-                           u32 absoluteTime,
-                           u8 numerator,
-                           u8 denominator,
-                           u8 clicksPerQuarter)
-    : MidiEvent(track, absoluteTime, 0, PRIORITY_HIGHEST), numer(numerator), denom(denominator),
-      ticksPerQuarter(clicksPerQuarter) {
-}
-
-u32 TimeSigEvent::writeEvent(std::vector<u8> &buf, u32 time) {
-  //denom is expressed in power of 2... so if we have 6/8 time.  it's 6 = 2^x  ==  ln6 / ln2
-  u8 data[4] = {
-      numer,
-      static_cast<u8>(log(static_cast<double>(denom)) / 0.69314718055994530941723212145818),
-      ticksPerQuarter,
-      8
-  };
-  return writeMetaEvent(buf, time, 0x58, data, 4);
-}
-
-//  ***************
-//  EndOfTrackEvent
-//  ***************
-
-EndOfTrackEvent::EndOfTrackEvent(MidiTrack *track, u32 absoluteTime)
-    : MidiEvent(track, absoluteTime, 0, PRIORITY_LOWEST) {
-}
-
-
-u32 EndOfTrackEvent::writeEvent(std::vector<u8> &buf, u32 time) {
-  return writeMetaEvent(buf, time, 0x2F, nullptr, 0);
-}
-
-//  *********
-//  TextEvent
-//  *********
-
-TextEvent::TextEvent(MidiTrack *track, u32 absoluteTime, std::string str)
-    : MidiEvent(track, absoluteTime, 0, PRIORITY_LOWEST), text(std::move(str)) {
-}
-
-u32 TextEvent::writeEvent(std::vector<u8> &buf, u32 time) {
-  return writeMetaTextEvent(buf, time, 0x01, text);
-}
-
-//  ************
-//  SeqNameEvent
-//  ************
-
-SeqNameEvent::SeqNameEvent(MidiTrack *track, u32 absoluteTime, std::string str)
-    : MidiEvent(track, absoluteTime, 0, PRIORITY_LOWEST), text(std::move(str)) {
-}
-
-u32 SeqNameEvent::writeEvent(std::vector<u8> &buf, u32 time) {
-  return writeMetaTextEvent(buf, time, 0x03, text);
-}
-
-//  **************
-//  TrackNameEvent
-//  **************
-
-TrackNameEvent::TrackNameEvent(MidiTrack *track, u32 absoluteTime, std::string str)
-    : MidiEvent(track, absoluteTime, 0, PRIORITY_LOWEST), text(std::move(str)) {
-}
-
-u32 TrackNameEvent::writeEvent(std::vector<u8> &buf, u32 time) {
-  return writeMetaTextEvent(buf, time, 0x03, text);
-}
-
-//***************
-// SPECIAL EVENTS
-//***************
-
-//  **************
-//  TransposeEvent
-//  **************
-
-
-GlobalTransposeEvent::GlobalTransposeEvent(MidiTrack *track, u32 absoluteTime, s8 semitones)
-    : MidiEvent(track, absoluteTime, 0, PRIORITY_HIGHEST), semitones(semitones) {
-}
-
-u32 GlobalTransposeEvent::writeEvent(std::vector<u8>& /*buf*/, u32 time) {
-  this->prntTrk->parentSeq->globalTranspose = this->semitones;
-  return time;
-}
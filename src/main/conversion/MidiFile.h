@@ -11,6 +11,8 @@
 #include <memory>
 #include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -19,9 +21,7 @@ class VGMSeq;
 
 class MidiFile;
 class MidiTrack;
-class MidiEvent;
-class DurNoteEvent;
-class NoteEvent;
+struct MidiEvent;
 
 #define PRIORITY_LOWEST 127
 #define PRIORITY_LOWER 96
@@ -31,7 +31,7 @@ class NoteEvent;
 #define PRIORITY_HIGHER -96
 #define PRIORITY_HIGHEST -128
 
-typedef enum {
+enum MidiEventType : u8 {
   MIDIEVENT_UNDEFINED,
   MIDIEVENT_MASTERVOL,
   MIDIEVENT_GLOBALTRANSPOSE,
@@ -67,26 +67,134 @@ typedef enum {
   MIDIEVENT_TEXT,
   MIDIEVENT_RESET,
   MIDIEVENT_MIDIPORT
-} MidiEventType;
+};
+
+// A MIDI event as stored in its MidiTrack: a fixed-size record kept by value in the track's event
+// array. Text, marker names and sysex data live in the track's blob area (see MidiTrack::text),
+// so adding an event never allocates on its own.
+struct MidiEvent {
+  // How the event is written out, and so which member of the union holds its data
+  enum class Kind : u8 {
+    Note,               // note
+    Controller,         // controller
+    PortamentoControl,  // controller, its key is shifted by the global transpose
+    ProgramChange,      // programNum
+    PitchBend,          // bend
+    ChannelPressure,    // pressure
+    Sysex,              // blob
+    Tempo,              // microSecs
+    MidiPort,           // port
+    TimeSig,            // timeSig
+    EndOfTrack,
+    Text,               // blob
+    TrackName,          // blob, for sequence names too
+    GlobalTranspose,    // semitones. Not written, transposes the notes after it
+    Marker,             // marker. Not written, read back by format-specific post-processing
+  };
+
+  struct NoteData {
+    s8 key;
+    s8 vel;
+    bool noteDown;
+  };
+  struct ControllerData {
+    u8 controlNum;
+    u8 dataByte;
+  };
+  struct TimeSigData {
+    u8 numer;
+    u8 denom;
+    u8 ticksPerQuarter;
+  };
+  struct BlobRef {
+    u32 offset;
+    u32 length;
+  };
+  struct MarkerData {
+    u32 nameOffset;
+    u16 nameLength;
+    u8 databyte1;
+    u8 databyte2;
+  };
+
+  static MidiEvent makeController(u32 absTime, u8 channel, u8 controlNum, u8 dataByte,
+                                  s8 priority = PRIORITY_MIDDLE,
+                                  MidiEventType type = MIDIEVENT_UNDEFINED) {
+    MidiEvent event{};
+    event.absTime = absTime;
+    event.type = type;
+    event.kind = Kind::Controller;
+    event.priority = priority;
+    event.channel = channel;
+    event.controller = {controlNum, dataByte};
+    return event;
+  }
+
+  [[nodiscard]] bool isMetaEvent() const;
+  [[nodiscard]] bool isSysexEvent() const;
+  static void writeVarLength(std::vector<u8> &buf, u32 value);
+  static std::string getNoteName(int noteNumber);
+
+  u32 absTime;            //absolute time... the number of ticks from the very beginning of the sequence at which this event occurs
+  MidiEventType type;
+  Kind kind;
+  s8 priority;
+  u8 channel;
+  union {
+    NoteData note;
+    ControllerData controller;
+    u8 programNum;
+    s16 bend;
+    u8 pressure;
+    u32 microSecs;
+    u8 port;
+    TimeSigData timeSig;
+    s8 semitones;
+    BlobRef blob;
+    MarkerData marker;
+  };
+};
+
+static_assert(sizeof(MidiEvent) == 16);
+static_assert(std::is_trivially_copyable_v<MidiEvent>);
+
+class PriorityCmp {
+ public:
+  bool operator()(const MidiEvent &a, const MidiEvent &b) const {
+    return (a.priority < b.priority);
+  }
+};
+
+class AbsTimeCmp {
+ public:
+  bool operator()(const MidiEvent &a, const MidiEvent &b) const {
+    return (a.absTime < b.absTime);
+  }
+};
 
 class MidiTrack {
  public:
   MidiTrack(MidiFile *parentSeq, bool bMonophonic);
   virtual ~MidiTrack();
 
+  // Orders the events by time, then priority, then insertion order
+  void sortEvents();
+  // Sorts the events and terminates the track with an end of track event
   void sort();
-  void writeTrack(std::vector<u8> &buf) const;
-  MidiEvent* sinkEvent(std::unique_ptr<MidiEvent>&& event);
-  void prependEvents(std::vector<std::unique_ptr<MidiEvent>> events);
-  std::vector<std::unique_ptr<MidiEvent>> releaseEvents();
-  [[nodiscard]] std::span<MidiEvent* const> events() const { return m_events; }
+  // Appends the MTrk chunk to buf. Both this track and the global track must be sorted
+  void writeTrack(std::vector<u8> &buf);
+  // Inserts events ahead of all the track's events. They can't carry text or sysex data
+  void prependEvents(std::span<const MidiEvent> events);
+  // Moves all of source's events, with their text and sysex data, to the end of this track
+  void appendEvents(MidiTrack &source);
+  [[nodiscard]] std::span<const MidiEvent> events() const { return m_events; }
+  [[nodiscard]] std::span<MidiEvent> events() { return m_events; }
+  [[nodiscard]] MidiEvent &event(size_t index) { return m_events[index]; }
   [[nodiscard]] bool hasEvents() const { return !m_events.empty(); }
-  [[nodiscard]] std::span<NoteEvent* const> previousDurNoteOffs() const { return m_prevDurNoteOffs; }
-
-  template <class EventType, class... Args>
-  EventType* addEvent(Args&&... args) {
-    return static_cast<EventType*>(sinkEvent(std::make_unique<EventType>(std::forward<Args>(args)...)));
-  }
+  // Indices of the note offs added by the NoteByDur functions that haven't been purged yet
+  [[nodiscard]] std::span<const size_t> previousDurNoteOffs() const { return m_prevDurNoteOffs; }
+  // Text of a text, name or marker event, or the data of a sysex event
+  [[nodiscard]] std::string_view text(const MidiEvent &event) const;
 
   //void setChannel(int theChannel);
   void setChannelGroup(int theChannelGroup);
@@ -217,7 +325,6 @@ class MidiTrack {
 
   // state
   u32 DeltaTime;            //a time value to be used for AddEvent
-  DurNoteEvent *prevDurEvent;
   bool bSustain;
 
   // activeNotes tracks which keys are on during conversion. It maps the note's original key to the
@@ -227,9 +334,16 @@ class MidiTrack {
   std::unordered_map<u8, u8> activeNotes;
 
  private:
-  std::vector<std::unique_ptr<MidiEvent>> m_ownedEvents;
-  std::vector<MidiEvent *> m_events;
-  std::vector<NoteEvent *> m_prevDurNoteOffs;
+  MidiEvent &addEvent(MidiEvent::Kind kind, MidiEventType type, u32 absTime, u8 channel, s8 priority);
+  void addNote(u8 channel, s8 key, s8 vel, bool noteDown, u32 absTime);
+  void addBlobEvent(MidiEvent::Kind kind, MidiEventType type, u32 absTime, s8 priority,
+                    const void *data, size_t size);
+  u32 storeBlob(const void *data, size_t size);
+  u32 writeEvent(std::vector<u8> &buf, const MidiEvent &event, u32 time);
+
+  std::vector<MidiEvent> m_events;
+  std::vector<u8> m_blob;
+  std::vector<size_t> m_prevDurNoteOffs;
 };
 
 class MidiFile {
@@ -262,478 +376,10 @@ class MidiFile {
   bool bMonophonicTracks;
 
 private:
+  // Sorts the tracks and appends the MThd chunk. Returns the number of MTrk chunks that follow
+  size_t writeHeader(std::vector<u8> &buf);
+
   u16 m_ppqn;
   std::vector<std::unique_ptr<MidiTrack>> m_ownedTracks;
   std::vector<MidiTrack *> m_tracks;
 };
-
-class MidiEvent {
- public:
-  MidiEvent(MidiTrack *track, u32 absoluteTime, u8 channel, s8 priority);
-  virtual ~MidiEvent() = default;
-  virtual MidiEventType eventType() = 0;
-  bool isMetaEvent();
-  bool isSysexEvent();
-  static void writeVarLength(std::vector<u8> &buf, u32 value);
-  virtual u32 writeEvent(std::vector<u8> &buf, u32 time) = 0;
-  u32 writeMetaEvent(std::vector<u8> &buf, u32 time, u8 metaType,
-    const u8* data, size_t dataSize) const;
-  u32 writeMetaTextEvent(std::vector<u8> &buf, u32 time, u8 metaType,
-    const std::string& str) const;
-
-  static std::string getNoteName(int noteNumber);
-
-  bool operator<(const MidiEvent &) const;
-  bool operator>(const MidiEvent &) const;
-
-  MidiTrack *prntTrk;
-  u8 channel;
-  u32 absTime;            //absolute time... the number of ticks from the very beginning of the sequence at which this event occurs
-  s8 priority;
-};
-
-class PriorityCmp {
- public:
-  bool operator()(const MidiEvent *a, const MidiEvent *b) const {
-    return (a->priority < b->priority);
-  }
-};
-
-class AbsTimeCmp {
- public:
-  bool operator()(const MidiEvent *a, const MidiEvent *b) const {
-    return (a->absTime < b->absTime);
-  }
-};
-
-class NoteEvent
-    : public MidiEvent {
- public:
-  NoteEvent(MidiTrack *track, u8 channel, u32 absoluteTime, bool bNoteDown, u8 key,
-            u8 vel = 64);
-  MidiEventType eventType() override { return MIDIEVENT_NOTEON; }
-  u32 writeEvent(std::vector<u8> &buf, u32 time) override;
-
-  bool bNoteDown;
-  s8 key;
-  s8 vel;
-};
-
-//class DurNoteEvent
-//	: public MidiEvent
-//{
-//public:
-//	DurNoteEvent(MidiTrack* prntTrk, u8 channel, u32 absoluteTime, u8 theKey, u8 theVel, u32 theDur);
-//	//virtual void PrepareWrite(std::vector<MidiEvent*> & events);
-//	virtual u32 WriteEvent(std::vector<u8> & buf, u32 time);
-//
-//	bool bNoteDown;
-//	s8 key;
-//	s8 vel;
-//	u32 duration;
-//};
-
-class ControllerEvent
-    : public MidiEvent {
- public:
-  ControllerEvent(MidiTrack *track,
-                  u8 channel,
-                  u32 absoluteTime,
-                  u8 controllerNum,
-                  u8 dataByte,
-                  s8 priority = PRIORITY_MIDDLE);
-  MidiEventType eventType() override { return MIDIEVENT_UNDEFINED; }
-  u32 writeEvent(std::vector<u8> &buf, u32 time) override;
-
-  u8 controlNum;
-  u8 dataByte;
-};
-
-class SysexEvent
-    : public MidiEvent {
-public:
-  SysexEvent(MidiTrack *track,
-             u32 absoluteTime,
-             const std::vector<u8>& sysexData,
-             s8 priority = PRIORITY_MIDDLE);
-  MidiEventType eventType() override { return MIDIEVENT_UNDEFINED; }
-  u32 writeEvent(std::vector<u8> &buf, u32 time) override;
-
-  std::vector<u8> sysexData;
-};
-
-class VolumeEvent
-    : public ControllerEvent {
- public:
-  VolumeEvent(MidiTrack *track, u8 channel, u32 absoluteTime, u8 volume)
-      : ControllerEvent(track, channel, absoluteTime, 7, volume, PRIORITY_MIDDLE) { }
-  MidiEventType eventType() override { return MIDIEVENT_VOLUME; }
-};
-
-class VolumeFineEvent
-    : public ControllerEvent {
-public:
-  VolumeFineEvent(MidiTrack *track, u8 channel, u32 absoluteTime, u8 volume_lsb)
-      : ControllerEvent(track, channel, absoluteTime, 39, volume_lsb, PRIORITY_MIDDLE) { }
-  MidiEventType eventType() override { return MIDIEVENT_VOLUME; }
-};
-
-class ExpressionEvent
-    : public ControllerEvent {
- public:
-  ExpressionEvent(MidiTrack *track, u8 channel, u32 absoluteTime, u8 expression)
-      : ControllerEvent(track, channel, absoluteTime, 11, expression, PRIORITY_MIDDLE) { }
-  MidiEventType eventType() override { return MIDIEVENT_EXPRESSION; }
-};
-
-class ExpressionFineEvent
-    : public ControllerEvent {
-public:
-  ExpressionFineEvent(MidiTrack *track, u8 channel, u32 absoluteTime, u8 expression_lsb)
-      : ControllerEvent(track, channel, absoluteTime, 43, expression_lsb, PRIORITY_MIDDLE) { }
-  MidiEventType eventType() override { return MIDIEVENT_EXPRESSION; }
-};
-
-class SustainEvent
-    : public ControllerEvent {
- public:
-  SustainEvent(MidiTrack *track, u8 channel, u32 absoluteTime, u8 depth)
-      : ControllerEvent(track, channel, absoluteTime, 64, depth, PRIORITY_MIDDLE) { }
-  MidiEventType eventType() override { return MIDIEVENT_SUSTAIN; }
-};
-
-class PortamentoEvent
-    : public ControllerEvent {
- public:
-  PortamentoEvent(MidiTrack *track, u8 channel, u32 absoluteTime, u8 bOn)
-      : ControllerEvent(track, channel, absoluteTime, 65, (bOn) ? 0x7F : 0, PRIORITY_MIDDLE) { }
-  MidiEventType eventType() override { return MIDIEVENT_PORTAMENTO; }
-};
-
-class PortamentoTimeEvent
-    : public ControllerEvent {
- public:
-  PortamentoTimeEvent(MidiTrack *track, u8 channel, u32 absoluteTime, u8 time)
-      : ControllerEvent(track, channel, absoluteTime, 5, time, PRIORITY_MIDDLE) { }
-  MidiEventType eventType() override { return MIDIEVENT_PORTAMENTOTIME; }
-};
-
-class PortamentoTimeFineEvent
-    : public ControllerEvent {
-public:
-  PortamentoTimeFineEvent(MidiTrack *track, u8 channel, u32 absoluteTime, u8 time)
-      : ControllerEvent(track, channel, absoluteTime, 37, time, PRIORITY_MIDDLE) { }
-  MidiEventType eventType() override { return MIDIEVENT_PORTAMENTOTIMEFINE; }
-};
-
-class PortamentoControlEvent
-    : public ControllerEvent {
-public:
-  PortamentoControlEvent(MidiTrack *track, u8 channel, u32 absoluteTime, u8 key)
-      : ControllerEvent(track, channel, absoluteTime, 84, key, PRIORITY_MIDDLE) { }
-  MidiEventType eventType() override { return MIDIEVENT_PORTAMENTOCONTROL; }
-  u32 writeEvent(std::vector<u8> &buf, u32 time) override;
-};
-
-class LegatoPedalEvent
-    : public ControllerEvent {
-public:
-  LegatoPedalEvent(MidiTrack *track, u8 channel, u32 absoluteTime, bool bOn)
-      : ControllerEvent(track, channel, absoluteTime, 68, (bOn) ? 0x7F : 0, PRIORITY_HIGH) { }
-  MidiEventType eventType() override { return MIDIEVENT_LEGATOPEDAL; }
-};
-
-class PanEvent
-    : public ControllerEvent {
- public:
-  PanEvent(MidiTrack *track, u8 channel, u32 absoluteTime, u8 pan)
-      : ControllerEvent(track, channel, absoluteTime, 10, pan, PRIORITY_MIDDLE) { }
-  MidiEventType eventType() override { return MIDIEVENT_PAN; }
-};
-
-class ModulationEvent
-    : public ControllerEvent {
- public:
-  ModulationEvent(MidiTrack *track, u8 channel, u32 absoluteTime, u8 depth)
-      : ControllerEvent(track, channel, absoluteTime, 1, depth, PRIORITY_MIDDLE) { }
-  MidiEventType eventType() override { return MIDIEVENT_MODULATION; }
-};
-
-class BreathEvent
-    : public ControllerEvent {
- public:
-  BreathEvent(MidiTrack *track, u8 channel, u32 absoluteTime, u8 depth)
-      : ControllerEvent(track, channel, absoluteTime, 2, depth, PRIORITY_MIDDLE) { }
-  MidiEventType eventType() override { return MIDIEVENT_BREATH; }
-};
-
-class BankSelectEvent
-    : public ControllerEvent {
- public:
-  BankSelectEvent(MidiTrack *track, u8 channel, u32 absoluteTime, u8 bank)
-      : ControllerEvent(track, channel, absoluteTime, 0, bank, PRIORITY_HIGH) { }
-  MidiEventType eventType() override { return MIDIEVENT_BANKSELECT; }
-};
-
-class BankSelectFineEvent
-    : public ControllerEvent {
- public:
-  BankSelectFineEvent(MidiTrack *track, u8 channel, u32 absoluteTime, u8 bank)
-      : ControllerEvent(track, channel, absoluteTime, 32, bank, PRIORITY_HIGH) { }
-  MidiEventType eventType() override { return MIDIEVENT_BANKSELECTFINE; }
-};
-
-/*
-class VolEvent
-	: public ControllerEvent
-{
-public:
-	VolEvent(MidiTrack* prntTrk, u8 channel, u32 absoluteTime, u8 theVol, s8 thePriority = PRIORITY_MIDDLE);
-	virtual VolEvent* MakeCopy();
-	//virtual u32 WriteEvent(std::vector<u8> & buf, u32 time);
-
-	u8 vol;
-};
-
-class VolMarkerEvent
-	: public MidiEvent
-{
-public:
-	VolMarkerEvent(MidiTrack* prntTrk, u8 channel, u32 absoluteTime, u8 theVol, s8 thePriority = PRIORITY_HIGHER);
-	virtual VolMarkerEvent* MakeCopy();
-	virtual u32 WriteEvent(std::vector<u8> & buf, u32 time);
-
-	u8 vol;
-};*/
-
-class MasterVolEvent
-    : public SysexEvent {
-public:
-  MasterVolEvent(MidiTrack *track, u8 /* channel */, u32 absoluteTime, u8 msb, u8 lsb)
-      : SysexEvent(track, absoluteTime, {0x07, 0x7F, 0x7F, 0x04, 0x01, lsb, msb }, PRIORITY_HIGHER) { }
-  MidiEventType eventType() override { return MIDIEVENT_MASTERVOL; }
-};
-
-/*
-class ExpressionEvent
-	: public MidiEvent
-{
-public:
-	ExpressionEvent(MidiTrack* prntTrk, u8 channel, u32 absoluteTime, u8 expression, s8 thePriority = PRIORITY_HIGHER);
-	virtual ExpressionEvent* MakeCopy();
-	virtual u32 WriteEvent(std::vector<u8> & buf, u32 time);
-
-	u8 expression;
-};*/
-
-class MonoEvent
-    : public ControllerEvent {
- public:
-  MonoEvent(MidiTrack *track, u8 channel, u32 absoluteTime)
-      : ControllerEvent(track, channel, absoluteTime, 126, 0, PRIORITY_HIGHER) { }
-  MidiEventType eventType() override { return MIDIEVENT_MONO; }
-};
-
-class ProgChangeEvent
-    : public MidiEvent {
- public:
-  ProgChangeEvent(MidiTrack *track, u8 channel, u32 absoluteTime, u8 progNum);
-  MidiEventType eventType() override { return MIDIEVENT_PROGRAMCHANGE; }
-  //virtual ProgChangeEvent* MakeCopy();
-  u32 writeEvent(std::vector<u8> &buf, u32 time) override;
-
-  u8 programNum;
-};
-
-class PitchBendEvent
-    : public MidiEvent {
- public:
-  PitchBendEvent(MidiTrack *track, u8 channel, u32 absoluteTime, s16 bend);
-  MidiEventType eventType() override { return MIDIEVENT_PITCHBEND; }
-  //virtual PitchBendEvent* MakeCopy();
-  u32 writeEvent(std::vector<u8> &buf, u32 time) override;
-
-  s16 bend;
-};
-
-class ChannelPressureEvent
-    : public MidiEvent {
- public:
-  ChannelPressureEvent(MidiTrack *track, u8 channel, u32 absoluteTime, u8 pressure);
-  MidiEventType eventType() override { return MIDIEVENT_CHANNELPRESSURE; }
-  u32 writeEvent(std::vector<u8> &buf, u32 time) override;
-
-  u8 pressure;
-};
-
-class TempoEvent
-    : public MidiEvent {
- public:
-  TempoEvent(MidiTrack *track, u32 absoluteTime, u32 microSeconds);
-  MidiEventType eventType() override { return MIDIEVENT_TEMPO; }
-  //virtual TempoEvent* MakeCopy();
-  u32 writeEvent(std::vector<u8> &buf, u32 time) override;
-
-  u32 microSecs;
-};
-
-class MidiPortEvent : public MidiEvent {
-public:
-  MidiPortEvent(MidiTrack *track, u32 absoluteTime, u8 port);
-  MidiEventType eventType() override { return MIDIEVENT_MIDIPORT; }
-  // virtual TimeSigEvent* MakeCopy();
-  u32 writeEvent(std::vector<u8> &buf, u32 time) override;
-
-  u8 port;
-};
-
-class TimeSigEvent
-    : public MidiEvent {
- public:
-  TimeSigEvent
-      (MidiTrack *track, u32 absoluteTime, u8 numerator, u8 denominator, u8 clicksPerQuarter);
-  MidiEventType eventType() override { return MIDIEVENT_TIMESIG; }
-  //virtual TimeSigEvent* MakeCopy();
-  u32 writeEvent(std::vector<u8> &buf, u32 time) override;
-
-  u8 numer;
-  u8 denom;
-  u8 ticksPerQuarter;
-};
-
-class EndOfTrackEvent
-    : public MidiEvent {
- public:
-  EndOfTrackEvent(MidiTrack *track, u32 absoluteTime);
-  MidiEventType eventType() override { return MIDIEVENT_ENDOFTRACK; }
-  //virtual EndOfTrackEvent* MakeCopy();
-  u32 writeEvent(std::vector<u8> &buf, u32 time) override;
-};
-
-class TextEvent
-    : public MidiEvent {
- public:
-  TextEvent(MidiTrack *track, u32 absoluteTime, std::string str);
-  MidiEventType eventType() override { return MIDIEVENT_TEXT; }
-  u32 writeEvent(std::vector<u8> &buf, u32 time) override;
-
-  std::string text;
-};
-
-class SeqNameEvent
-    : public MidiEvent {
- public:
-  SeqNameEvent(MidiTrack *track, u32 absoluteTime, std::string str);
-  MidiEventType eventType() override { return MIDIEVENT_TEXT; }
-  u32 writeEvent(std::vector<u8> &buf, u32 time) override;
-
-  std::string text;
-};
-
-class TrackNameEvent
-    : public MidiEvent {
- public:
-  TrackNameEvent(MidiTrack *track, u32 absoluteTime, std::string str);
-  MidiEventType eventType() override { return MIDIEVENT_TEXT; }
-  u32 writeEvent(std::vector<u8> &buf, u32 time) override;
-
-  std::string text;
-};
-
-// SPECIAL EVENTS THAT AFFECT OTHER MIDI EVENTS RATHER THAN DIRECTLY OUTPUT TO THE FILE
-class GlobalTransposeEvent
-    : public MidiEvent {
- public:
-  GlobalTransposeEvent(MidiTrack *track, u32 absoluteTime, s8 semitones);
-  MidiEventType eventType() override { return MIDIEVENT_GLOBALTRANSPOSE; }
-  u32 writeEvent(std::vector<u8> &buf, u32 time) override;
-
-  s8 semitones;
-};
-
-class MarkerEvent
-    : public MidiEvent {
- public:
-  MarkerEvent(MidiTrack *track,
-              u8 channel,
-              u32 absoluteTime,
-              const std::string &name,
-              u8 databyte1,
-              u8 databyte2,
-              s8 priority = PRIORITY_MIDDLE)
-      : MidiEvent(track, absoluteTime, channel, priority), name(name), databyte1(databyte1),
-        databyte2(databyte2) { }
-  MidiEventType eventType() override { return MIDIEVENT_MARKER; }
-  u32 writeEvent(std::vector<u8>& /*buf*/, u32 time) override { return time; }
-
-  std::string name;
-  u8 databyte1, databyte2;
-};
-
-class GMResetEvent
-    : public SysexEvent {
- public:
-  GMResetEvent(MidiTrack *track, u32 absoluteTime)
-       : SysexEvent(track, absoluteTime, { 0x05, 0x7E, 0x7F, 0x09, 0x01 }, PRIORITY_HIGHEST) { }
-  MidiEventType eventType() override { return MIDIEVENT_RESET; }
-};
-
-class GM2ResetEvent
-    : public SysexEvent {
- public:
-  GM2ResetEvent(MidiTrack *track, u32 absoluteTime)
-       : SysexEvent(track, absoluteTime, { 0x05, 0x7E, 0x7F, 0x09, 0x03 }, PRIORITY_HIGHEST) { }
-  MidiEventType eventType() override { return MIDIEVENT_RESET; }
-};
-
-class GSResetEvent
-    : public SysexEvent {
- public:
-  GSResetEvent(MidiTrack *track, u32 absoluteTime)
-       : SysexEvent(track, absoluteTime, { 0x0A, 0x41, 0x10, 0x42, 0x12, 0x40, 0x00, 0x7F, 0x00, 0x41 },
-                    PRIORITY_HIGHEST) { }
-  MidiEventType eventType() override { return MIDIEVENT_RESET; }
-};
-
-class XGResetEvent
-    : public SysexEvent {
- public:
-  XGResetEvent(MidiTrack *track, u32 absoluteTime)
-       : SysexEvent(track, absoluteTime,  { 0x08, 0x43, 0x10, 0x4C, 0x00, 0x00, 0x7E, 0x00 },
-                    PRIORITY_HIGHEST) { }
-  MidiEventType eventType() override { return MIDIEVENT_RESET; }
-};
-
-
-
-/*
-class AFX_EXT_CLASS ProgChangeEvent
-	: public MidiEvent
-{
-	ProgChangeEvent(void);
-	~ProgramChangeEvent(void);
-
-	u8 progNum;
-}
-
-class AFX_EXT_CLASS ControllerEvent
-	: public MidiEvent
-{
-public:
-	NoteEvent(void);
-	~NoteEvent(void);
-
-	s8 key;
-	s8 vel;
-};*/
-
-/*class AFX_EXT_CLASS NoteEventDur
-	: public MidiEvent
-{
-public:
-	NoteEvent(void);
-	~NoteEvent(void);
-
-	s8 key;
-	s8 vel;
-}*/
@@ -8,15 +8,18 @@
 
 #include "base/Types.h"
 #include "ConversionContext.h"
+#include "LogItem.h"
 #include "LogManager.h"
 #include "MidiFile.h"
 #include "Options.h"
+#include "Root.h"
 #include "SF2Conversion.h"
 #include "SF2File.h"
 #include "SynthFile.h"
 #include "VGMColl.h"
 #include "VGMInstrSet.h"
 #include "VGMSeq.h"
+#include "util/Parallel.h"
 
 #include <algorithm>
 #include <array>
@@ -57,17 +60,13 @@ u32 getMidiDurationTicks(const MidiFile& midi) {
       continue;
     }
 
-    for (const MidiEvent* event : track->events()) {
-      if (event) {
-        maxTick = std::max(maxTick, event->absTime);
-      }
+    for (const MidiEvent& event : track->events()) {
+      maxTick = std::max(maxTick, event.absTime);
     }
   }
 
-  for (const MidiEvent* event : midi.globalTrack.events()) {
-    if (event) {
-      maxTick = std::max(maxTick, event->absTime);
-    }
+  for (const MidiEvent& event : midi.globalTrack.events()) {
+    maxTick = std::max(maxTick, event.absTime);
   }
 
   return maxTick;
@@ -78,12 +77,8 @@ void retimeTrack(MidiTrack* track, u16 srcPPQN, u16 dstPPQN, u32 startTick) {
     return;
   }
 
-  for (MidiEvent* event : track->events()) {
-    if (!event) {
-      continue;
-    }
-
-    event->absTime = static_cast<u32>(rescaleTick(event->absTime, srcPPQN, dstPPQN) + startTick);
+  for (MidiEvent& event : track->events()) {
+    event.absTime = static_cast<u32>(rescaleTick(event.absTime, srcPPQN, dstPPQN) + startTick);
   }
 }
 
@@ -136,33 +131,28 @@ bool applyBankOffsetToTrack(MidiTrack* track,
     return true;
   };
 
-  for (MidiEvent* event : track->events()) {
-    if (!event) {
-      continue;
-    }
-
-    if (!event->isMetaEvent() && !event->isSysexEvent()) {
-      usedChannels[event->channel & 0x0F] = true;
+  for (MidiEvent& event : track->events()) {
+    if (!event.isMetaEvent() && !event.isSysexEvent()) {
+      usedChannels[event.channel & 0x0F] = true;
     }
 
-    const MidiEventType eventType = event->eventType();
+    const MidiEventType eventType = event.type;
     if (eventType != MIDIEVENT_BANKSELECT && eventType != MIDIEVENT_BANKSELECTFINE) {
       continue;
     }
 
-    auto* controller = dynamic_cast<ControllerEvent*>(event);
-    if (!controller) {
+    if (event.kind != MidiEvent::Kind::Controller) {
       continue;
     }
 
-    const u8 channel = controller->channel & 0x0F;
-    updateSourceBank(sourceBanks[channel], eventType, controller->dataByte);
-    if (!remapBankByte(sourceBanks[channel], eventType, controller->dataByte)) {
+    const u8 channel = event.channel & 0x0F;
+    updateSourceBank(sourceBanks[channel], eventType, event.controller.dataByte);
+    if (!remapBankByte(sourceBanks[channel], eventType, event.controller.dataByte)) {
       return false;
     }
   }
 
-  std::vector<std::unique_ptr<MidiEvent>> injectedBankEvents;
+  std::vector<MidiEvent> injectedBankEvents;
   injectedBankEvents.reserve(32);
   u8 remappedBankMsb = 0;
   u8 remappedBankLsb = 0;
@@ -175,12 +165,14 @@ bool applyBankOffsetToTrack(MidiTrack* track,
     if (!usedChannels[channel]) {
       continue;
     }
-    injectedBankEvents.push_back(std::make_unique<BankSelectEvent>(track, channel, startTick, remappedBankMsb));
-    injectedBankEvents.push_back(std::make_unique<BankSelectFineEvent>(track, channel, startTick, remappedBankLsb));
+    injectedBankEvents.push_back(MidiEvent::makeController(
+        startTick, channel, 0, remappedBankMsb, PRIORITY_HIGH, MIDIEVENT_BANKSELECT));
+    injectedBankEvents.push_back(MidiEvent::makeController(
+        startTick, channel, 32, remappedBankLsb, PRIORITY_HIGH, MIDIEVENT_BANKSELECTFINE));
   }
 
   // Keep injected bank selects ahead of same-tick program changes when priorities are equal
-  track->prependEvents(std::move(injectedBankEvents));
+  track->prependEvents(injectedBankEvents);
 
   return true;
 }
@@ -327,23 +319,37 @@ std::unique_ptr<MidiFile> mergeMidiSequences(const std::vector<MidiMergeEntry>&
 
   const auto context = ConversionContext::fromOptions(ConversionOptions::the(), SynthTarget::SoundFont);
 
-  u16 targetPPQN = 0;
-
-  for (size_t i = 0; i < entries.size(); ++i) {
-    const MidiMergeEntry& entry = entries[i];
-    const VGMColl* coll = entry.collection;
-    if (!coll) {
+  for (const MidiMergeEntry& entry : entries) {
+    if (!entry.collection) {
       L_ERROR("Encountered an entry with no collection while preparing merge.");
       return nullptr;
     }
-
-    VGMSeq* seq = coll->seq();
-    if (!seq) {
+    if (!entry.collection->seq()) {
       L_ERROR("Encountered a collection with no sequence while preparing merge.");
       return nullptr;
     }
+  }
 
-    auto midi = seq->convertToMidi(coll, context);
+  // Entries are independent until retiming, so convert them all up front. Conversions of the
+  // same sequence queue up on its conversion lock. Their log items are handed to the UI from
+  // this thread afterwards, in entry order
+  std::vector<std::unique_ptr<MidiFile>> converted(entries.size());
+  std::vector<std::vector<LogItem>> conversionLogs(entries.size());
+  vgmtrans::parallelFor(entries.size(), vgmtrans::defaultThreadCount(), [&](size_t i) {
+    VGMRoot::LogCapture logCapture(conversionLogs[i]);
+    const VGMColl* coll = entries[i].collection;
+    converted[i] = coll->seq()->convertToMidi(coll, context);
+  });
+  for (auto& logs : conversionLogs) {
+    for (auto& logItem : logs) {
+      pRoot->log(&logItem);
+    }
+  }
+
+  u16 targetPPQN = 0;
+
+  for (size_t i = 0; i < entries.size(); ++i) {
+    auto midi = std::move(converted[i]);
     if (!midi) {
       L_ERROR("Failed to convert one of the source sequences to MIDI.");
       return nullptr;
@@ -408,15 +414,7 @@ std::unique_ptr<MidiFile> mergeMidiSequences(const std::vector<MidiMergeEntry>&
     const u8 bankOffset = options.bankOffsets.empty() ? 0 : options.bankOffsets[i];
 
     retimeTrack(&source->globalTrack, sourcePPQN, targetPPQN, startTick);
-    auto globalEvents = source->globalTrack.releaseEvents();
-    for (auto& event : globalEvents) {
-      if (!event) {
-        continue;
-      }
-
-      event->prntTrk = &mergedMidi->globalTrack;
-      mergedMidi->globalTrack.sinkEvent(std::move(event));
-    }
+    mergedMidi->globalTrack.appendEvents(source->globalTrack);
 
     auto tracks = source->releaseTracks();
     for (auto& track : tracks) {
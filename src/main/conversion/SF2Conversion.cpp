@@ -50,7 +50,7 @@ std::unique_ptr<SF2File> createSF2File(
     L_ERROR("SF2 conversion failed");
     return nullptr;
   }
-  return std::make_unique<SF2File>(synthfile.get(), context);
+  return std::make_unique<SF2File>(std::move(synthfile), context);
 }
 
 std::unique_ptr<SynthFile> createSynthFile(
@@ -253,18 +253,20 @@ void unpackSampColl(SynthFile &synthfile, const VGMSampColl *sampColl, std::vect
   for (size_t i = 0; i < nSamples; i++) {
     VGMSamp *samp = sampColl->sample(i);
 
-    std::vector<u8> uncompSampBuf = samp->toPcm(Signedness::Signed, Endianness::Little, BPS::PCM16);
-
+    // The PCM data is decoded when the SF2 is written, one sample at a time
     u16 blockAlign = 2 * samp->channels;
     SynthWave *wave = synthfile.addWave(1, samp->channels, samp->rate, samp->rate * blockAlign, blockAlign,
-                                        16, static_cast<u32>(uncompSampBuf.size()),
-                                        std::move(uncompSampBuf), samp->name());
+                                        16, 0, {}, samp->name());
+    wave->source = samp;
     finalSamps.push_back(samp);
 
+    // Decoding is deferred, so pick up the loop points stored in the sample data now
+    samp->readLoopInfo();
+
     // If we don't have any loop information, then don't create a sampInfo structure for the Wave
     if (samp->loop.loopStatus == -1) {
       L_ERROR("No loop information for {} - some parameters might be incorrect", samp->name());
-      return;
+      continue;
     }
 
     SynthSampInfo *sampInfo = wave->addSampInfo();
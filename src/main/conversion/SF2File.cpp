@@ -7,7 +7,7 @@
 
 #include "base/Types.h"
 #include "ConversionContext.h"
-#include "Root.h"
+#include "LogManager.h"
 #include "ScaleConversion.h"
 #include "SynthFile.h"
 #include "version.h"
@@ -16,15 +16,20 @@
 
 #include <algorithm>
 #include <cmath>
+#include <fstream>
 #include <limits>
 #include <memory>
 #include <optional>
 
+#include <spdlog/fmt/std.h>
+
 namespace {
 
 constexpr double kEmu8000InitialAttenuationScale = 2.5;
 constexpr double kSoundFontCentibelsPerDecibel = 10.0;
 constexpr double kSoundFontMaxInitialAttenuationCentibels = 1440.0;
+// The sf2 spec requires 46 zero samples after each sample
+constexpr u32 kSamplePaddingBytes = 46 * 2;
 
 std::optional<SFModulator> sf2SourceForModSource(ModSource source) {
   constexpr u16 midiContinuousController = 1u << 7;
@@ -132,8 +137,13 @@ int SF2File::numOfGeneratorsForRgn(SynthRgn* rgn) {
   return numOfGenerators;
 }
 
+SF2File::SF2File(std::unique_ptr<SynthFile> synthfile, const ConversionContext& context)
+    : SF2File(synthfile.get(), context) {
+  m_ownedSynthfile = std::move(synthfile);
+}
+
 SF2File::SF2File(SynthFile* synthfile, const ConversionContext& context)
-    : RiffFile(synthfile->m_name, "sfbk") {
+    : RiffFile(synthfile->m_name, "sfbk"), m_synthfile(synthfile) {
 
   //***********
   // INFO chunk
@@ -144,23 +154,9 @@ SF2File::SF2File(SynthFile* synthfile, const ConversionContext& context)
   auto* sdtaCk = addChildChunk<LISTChunk>("sdta");
   auto* smplCk = sdtaCk->addChildChunk<Chunk>("smpl");
 
-  // Concatanate all of the samples together and add the result to the smpl chunk data
-  size_t numWaves = synthfile->waveCount();
-  u32 smplCkSize = 0;
-  for (size_t i = 0; i < numWaves; i++) {
-    SynthWave *wave = synthfile->waves()[i];
-    smplCkSize += wave->dataSize + (46 * 2);    // plus the 46 padding samples required by sf2 spec
-  }
-  smplCk->setSize(smplCkSize);
-  smplCk->data = std::make_unique<u8[]>(smplCkSize);
-  u32 bufPtr = 0;
-  for (size_t i = 0; i < numWaves; i++) {
-    SynthWave *wave = synthfile->waves()[i];
-
-    memcpy(smplCk->data.get() + bufPtr, wave->data.data(), wave->dataSize);
-    memset(smplCk->data.get() + bufPtr + wave->dataSize, 0, 46 * 2);
-    bufPtr += wave->dataSize + (46 * 2);        // plus the 46 padding samples required by sf2 spec
-  }
+  // The sample data is added when the file is saved, see saveToMem() and saveSF2File()
+  m_sdtaCk = sdtaCk;
+  m_smplCk = smplCk;
 
   //***********
   // pdta chunk
@@ -544,10 +540,20 @@ SF2File::SF2File(SynthFile* synthfile, const ConversionContext& context)
   size_t numSamps = synthfile->waveCount();
   shdrCk->setSize(static_cast<u32>((numSamps + 1) * sizeof(sfSample)));
   shdrCk->data = std::make_unique<u8[]>(shdrCk->size());
+  m_shdrCk = shdrCk;
+}
+
+SF2File::~SF2File() = default;
+
+// Fills in the shdr chunk. Sample offsets depend on the decoded size of every wave, so this
+// runs once all of the sample data has been laid out.
+void SF2File::writeSampleHeaders() {
+  size_t numInstrs = m_synthfile->instrCount();
+  size_t numSamps = m_synthfile->waveCount();
 
   u32 sampOffset = 0;
   for (size_t i = 0; i < numSamps; i++) {
-    SynthWave *wave = synthfile->waves()[i];
+    SynthWave *wave = m_synthfile->waves()[i];
 
     sfSample samp{};
     memcpy(samp.achSampleName, wave->name.c_str(), std::min(wave->name.length(), static_cast<size_t>(20)));
@@ -558,7 +564,7 @@ SF2File::SF2File(SynthFile* synthfile, const ConversionContext& context)
     // Search through all regions for an associated sampInfo structure with this sample
     SynthSampInfo *sampInfo = nullptr;
     for (size_t j = 0; j < numInstrs; j++) {
-      SynthInstr *instr = synthfile->instrs()[j];
+      SynthInstr *instr = m_synthfile->instrs()[j];
 
       size_t numRgns = instr->regions().size();
       for (size_t k = 0; k < numRgns; k++) {
@@ -587,21 +593,107 @@ SF2File::SF2File(SynthFile* synthfile, const ConversionContext& context)
     samp.wSampleLink = 0;
     samp.sfSampleType = monoSample;
 
-    memcpy(shdrCk->data.get() + (i * sizeof(sfSample)), &samp, sizeof(sfSample));
+    memcpy(m_shdrCk->data.get() + (i * sizeof(sfSample)), &samp, sizeof(sfSample));
   }
 
   //  add terminal sfSample
-  memset(shdrCk->data.get() + (numSamps * sizeof(sfSample)), 0, sizeof(sfSample));
+  memset(m_shdrCk->data.get() + (numSamps * sizeof(sfSample)), 0, sizeof(sfSample));
 }
 
 std::vector<u8> SF2File::saveToMem() {
+  // Concatenate all of the samples together and add the result to the smpl chunk data
+  size_t numWaves = m_synthfile->waveCount();
+  u32 smplCkSize = 0;
+  for (size_t i = 0; i < numWaves; i++) {
+    SynthWave *wave = m_synthfile->waves()[i];
+    wave->decode();
+    smplCkSize += wave->dataSize + kSamplePaddingBytes;
+  }
+  m_smplCk->setSize(smplCkSize);
+  m_smplCk->data = std::make_unique<u8[]>(smplCkSize);
+  u32 bufPtr = 0;
+  for (size_t i = 0; i < numWaves; i++) {
+    SynthWave *wave = m_synthfile->waves()[i];
+
+    memcpy(m_smplCk->data.get() + bufPtr, wave->sampleData(), wave->dataSize);
+    memset(m_smplCk->data.get() + bufPtr + wave->dataSize, 0, kSamplePaddingBytes);
+    bufPtr += wave->dataSize + kSamplePaddingBytes;
+    wave->releaseDecoded();
+  }
+  writeSampleHeaders();
+
   std::vector<u8> buf(size());
   write(buf.data());
+
+  m_smplCk->data.reset();
+  m_smplCk->setSize(0);
   return buf;
 }
 
+// Writes the file without holding the sample data in memory: each wave is decoded, written
+// and released in turn, and the sizes that depend on the sample data are patched in afterwards.
 bool SF2File::saveSF2File(const std::filesystem::path &filepath) {
-  auto buf = saveToMem();
-  bool result = pRoot->UI_writeBufferToFile(filepath, buf.data(), buf.size());
-  return result;
+  std::ofstream out(filepath, std::ios::out | std::ios::trunc | std::ios::binary);
+  if (!out.is_open()) {
+    L_ERROR("Error: could not open file {} for writing", filepath);
+    return false;
+  }
+
+  auto writeChunk = [&out](Chunk& chunk) {
+    std::vector<u8> buf(chunk.size());
+    chunk.write(buf.data());
+    out.write(reinterpret_cast<const char *>(buf.data()), static_cast<std::streamsize>(buf.size()));
+  };
+  auto writeU32 = [&out](u32 value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+
+  // RIFF header and INFO list
+  out.write(id, 4);
+  writeU32(0);
+  out.write(type, 4);
+  auto child = childChunks.begin();
+  writeChunk(**child++);
+
+  // sdta list, streaming the smpl chunk
+  const std::streamoff sdtaPos = out.tellp();
+  out.write(m_sdtaCk->id, 4);
+  writeU32(0);
+  out.write(m_sdtaCk->type, 4);
+  out.write(m_smplCk->id, 4);
+  writeU32(0);
+
+  static constexpr char padding[kSamplePaddingBytes] = {};
+  u32 smplCkSize = 0;
+  for (auto *wave : m_synthfile->waves()) {
+    wave->decode();
+    out.write(reinterpret_cast<const char *>(wave->sampleData()), wave->dataSize);
+    out.write(padding, kSamplePaddingBytes);
+    smplCkSize += wave->dataSize + kSamplePaddingBytes;
+    wave->releaseDecoded();
+  }
+  if (smplCkSize % 2) {
+    out.put(0);
+    smplCkSize++;
+  }
+  child++;
+
+  // pdta list
+  writeSampleHeaders();
+  writeChunk(**child++);
+
+  const std::streamoff endPos = out.tellp();
+  out.seekp(4);
+  writeU32(static_cast<u32>(endPos - 8));
+  out.seekp(sdtaPos + 4);
+  writeU32(smplCkSize + 12);
+  out.seekp(sdtaPos + 16);
+  writeU32(smplCkSize);
+
+  out.close();
+  if (out.fail()) {
+    L_ERROR("Error: failed writing {}", filepath);
+    return false;
+  }
+  return true;
 }
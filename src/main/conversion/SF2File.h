@@ -4,6 +4,7 @@
 #include "RiffFile.h"
 
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -267,11 +268,23 @@ struct ConversionContext;
 
 class SF2File: public RiffFile {
  public:
+  // Sample data is only decoded when the file is saved, so the SynthFile (and the VGMSamps its
+  // waves were created from) must stay alive until then. The first form takes ownership of it.
+  SF2File(std::unique_ptr<SynthFile> synthfile, const ConversionContext& context);
   SF2File(SynthFile* synthfile, const ConversionContext& context);
-  ~SF2File() override = default;
+  ~SF2File() override;
 
   static int numOfGeneratorsForRgn(SynthRgn* rgn);
 
   std::vector<u8> saveToMem();
   bool saveSF2File(const std::filesystem::path &filepath);
+
+ private:
+  void writeSampleHeaders();
+
+  std::unique_ptr<SynthFile> m_ownedSynthfile;
+  SynthFile* m_synthfile;
+  LISTChunk* m_sdtaCk{};
+  Chunk* m_smplCk{};
+  Chunk* m_shdrCk{};
 };
@@ -363,6 +363,17 @@ void SynthWave::convertTo16bit() {
   }
 }
 
+void SynthWave::decode() {
+  if (isDecoded())
+    return;
+  m_decoded = source->toPcm(Signedness::Signed, Endianness::Little, BPS::PCM16);
+  dataSize = static_cast<u32>(m_decoded->size());
+}
+
+void SynthWave::releaseDecoded() {
+  m_decoded.reset();
+}
+
 SynthSampInfo *SynthWave::addSampInfo() {
   m_sampinfo = std::make_unique<SynthSampInfo>();
   sampinfo = m_sampinfo.get();
@@ -208,8 +208,17 @@ class SynthWave {
 
   void convertTo16bit();
 
+  // Waves created with a source sample hold no data until decode() is called; writers decode
+  // them one at a time and release the data again once it has been written.
+  [[nodiscard]] bool isDecoded() const { return source == nullptr || m_decoded != nullptr; }
+  void decode();
+  void releaseDecoded();
+  // The wave's sample data: the decoded source sample, or `data` for waves without one
+  [[nodiscard]] const u8 *sampleData() const { return m_decoded ? m_decoded->data() : data.data(); }
+
 public:
   SynthSampInfo *sampinfo {nullptr};
+  VGMSamp *source {nullptr};
 
   u16 wFormatTag;
   u16 wChannels;
@@ -225,4 +234,5 @@ public:
 
 private:
   std::unique_ptr<SynthSampInfo> m_sampinfo;
+  std::shared_ptr<const std::vector<u8>> m_decoded;
 };
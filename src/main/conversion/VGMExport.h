@@ -53,33 +53,41 @@ void saveAllAsWav(const VGMSampColl &coll, const std::filesystem::path &save_dir
 bool saveAsOriginal(const VGMFile& file, const std::filesystem::path& filepath);
 bool saveAsOriginal(const RawFile& rawfile, const std::filesystem::path& filepath);
 
+// Writes the requested files for the collection into dir_path. Returns false if any of them
+// could not be created or written.
 template <Target options>
-void saveAs(const VGMColl &coll, const std::filesystem::path &dir_path) {
+bool saveAs(const VGMColl &coll, const std::filesystem::path &dir_path) {
   auto filename = makeSafeFileName(coll.name());
   auto filepath = dir_path / filename;
   const auto context = ConversionContext::fromOptions(ConversionOptions::the(), modulationSynthTargetFor(options));
+  bool saved = true;
 
   if constexpr (hasTarget(options, Target::MIDI)) {
     auto midiPath = filepath;
     midiPath.replace_extension(".mid");
-    coll.seq()->saveAsMidi(midiPath, &coll, context);
+    if (!coll.seq()->saveAsMidi(midiPath, &coll, context)) {
+      saved = false;
+    }
   }
 
   if constexpr (hasTarget(options, Target::DLS)) {
     DLSFile dlsfile;
-    if (createDLSFile(dlsfile, coll, context)) {
-      auto dlsPath = filepath;
-      dlsPath.replace_extension(".dls");
-      dlsfile.saveDLSFile(dlsPath);
+    auto dlsPath = filepath;
+    dlsPath.replace_extension(".dls");
+    if (!createDLSFile(dlsfile, coll, context) || !dlsfile.saveDLSFile(dlsPath)) {
+      saved = false;
     }
   }
 
   if constexpr (hasTarget(options, Target::SF2)) {
-    if (auto sf2file = createSF2File(coll, context)) {
-      auto sf2Path = filepath;
-      sf2Path.replace_extension(".sf2");
-      sf2file->saveSF2File(sf2Path);
+    auto sf2file = createSF2File(coll, context);
+    auto sf2Path = filepath;
+    sf2Path.replace_extension(".sf2");
+    if (!sf2file || !sf2file->saveSF2File(sf2Path)) {
+      saved = false;
     }
   }
+
+  return saved;
 }
 }
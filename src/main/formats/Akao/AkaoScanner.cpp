@@ -16,12 +16,14 @@ ScannerRegistration<AkaoScanner> s_akao("Akao");
 void AkaoScanner::scan(RawFile* file, void* /*info*/) {
   const AkaoPs1Version file_version = determineVersionFromTag(file);
 
-  for (u32 offset = 0; offset + 0x60 < file->size(); offset++) {
-    //sig must match ascii characters "AKAO"
-    if (file->readWordBE(offset) != 0x414B414F)
-      continue;
+  const ByteView view = file->view();
 
-    const u16 seq_length = file->readShort(offset + 6);
+  //sig must match ascii characters "AKAO"
+  for (u32 offset : file->magicIndex().offsets("AKAO")) {
+    if (offset + 0x60 >= view.size())
+      break;
+
+    const u16 seq_length = view.load<u16>(offset + 6);
     if (seq_length != 0) {
       // Sequence
       if (!AkaoSeq::isPossibleAkaoSeq(file, offset))
@@ -31,7 +33,7 @@ void AkaoScanner::scan(RawFile* file, void* /*info*/) {
       if (version == AkaoPs1Version::UNKNOWN)
         version = AkaoSeq::guessVersion(file, offset);
 
-      u16 id = file->readShort(offset + 4);
+      u16 id = view.load<u16>(offset + 4);
       auto name = fmt::format("Akao Seq {:02X}", id);
 
       auto* seq = pRoot->loadVGMFile<AkaoSeq>(file, offset, version, name);
@@ -53,7 +55,7 @@ void AkaoScanner::scan(RawFile* file, void* /*info*/) {
       if (version == AkaoPs1Version::UNKNOWN)
         version = AkaoSampColl::guessVersion(file, offset);
 
-      u16 id = file->readShort(offset + 4);
+      u16 id = view.load<u16>(offset + 4);
       auto name = fmt::format("Akao Sample Collection {:02X}", id);
 
       pRoot->loadVGMFile<AkaoSampColl>(file, offset, version, name);
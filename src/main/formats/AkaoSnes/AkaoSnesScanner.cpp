@@ -324,6 +324,27 @@ BytePattern AkaoSnesScanner::ptnReadPercussionTableV4(
   ,
   24);
 
+const BytePatternSet& AkaoSnesScanner::signaturePatterns() {
+  static const BytePatternSet patterns{
+      &ptnReadNoteLengthV1,
+      &ptnReadNoteLengthV2,
+      &ptnReadNoteLengthV4,
+      &ptnVCmdExecFF4,
+      &ptnVCmdExecRS3,
+      &ptnReadSeqHeaderV1,
+      &ptnReadSeqHeaderV2,
+      &ptnReadSeqHeaderFFMQ,
+      &ptnReadSeqHeaderV4,
+      &ptnLoadDIRV1,
+      &ptnLoadDIRV3,
+      &ptnLoadInstrV1,
+      &ptnLoadInstrV2,
+      &ptnLoadInstrV3,
+      &ptnReadPercussionTableV4,
+  };
+  return patterns;
+}
+
 void AkaoSnesScanner::scan(RawFile* file, void* /*info*/) {
   size_t nFileLength = file->size();
   if (nFileLength == 0x10000) {
@@ -334,6 +355,7 @@ void AkaoSnesScanner::scan(RawFile* file, void* /*info*/) {
 }
 
 void AkaoSnesScanner::searchForAkaoSnesFromARAM(RawFile *file) {
+  const BytePatternMatches matches = file->searchBytePatterns(signaturePatterns());
   AkaoSnesVersion version;
   AkaoSnesMinorVersion minorVersion = AKAOSNES_NOMINORVERSION;
   std::string name = file->tag.hasTitle() ? file->tag.title : file->stem();
@@ -341,15 +363,15 @@ void AkaoSnesScanner::searchForAkaoSnesFromARAM(RawFile *file) {
   // search for note length table
   u32 ofsReadNoteLength;
   AkaoSnesVersion verReadNoteLength;
-  if (file->searchBytePattern(ptnReadNoteLengthV4, ofsReadNoteLength)) {
+  if (matches.find(ptnReadNoteLengthV4, ofsReadNoteLength)) {
     // V4 stores the note length table address at ofsReadNoteLength + 6.
     verReadNoteLength = AKAOSNES_V4;
   }
-  else if (file->searchBytePattern(ptnReadNoteLengthV2, ofsReadNoteLength)) {
+  else if (matches.find(ptnReadNoteLengthV2, ofsReadNoteLength)) {
     // V1/V2 store the note length table address at ofsReadNoteLength + 8.
     verReadNoteLength = AKAOSNES_V2;
   }
-  else if (file->searchBytePattern(ptnReadNoteLengthV1, ofsReadNoteLength)) {
+  else if (matches.find(ptnReadNoteLengthV1, ofsReadNoteLength)) {
     // V1/V2 store the note length table address at ofsReadNoteLength + 8.
     verReadNoteLength = AKAOSNES_V1;
   }
@@ -362,12 +384,12 @@ void AkaoSnesScanner::searchForAkaoSnesFromARAM(RawFile *file) {
   u8 firstVCmd;
   u16 addrVCmdAddressTable;
   u16 addrVCmdLengthTable;
-  if (file->searchBytePattern(ptnVCmdExecRS3, ofsVCmdExec)) {
+  if (matches.find(ptnVCmdExecRS3, ofsVCmdExec)) {
     firstVCmd = file->readByte(ofsVCmdExec + 1);
     addrVCmdAddressTable = file->readShort(ofsVCmdExec + 11);
     addrVCmdLengthTable = file->readShort(ofsVCmdExec + 17);
   }
-  else if (file->searchBytePattern(ptnVCmdExecFF4, ofsVCmdExec)) {
+  else if (matches.find(ptnVCmdExecFF4, ofsVCmdExec)) {
     firstVCmd = file->readByte(ofsVCmdExec + 1);
     addrVCmdAddressTable = file->readShort(ofsVCmdExec + 9);
     addrVCmdLengthTable = file->readShort(ofsVCmdExec + 16);
@@ -381,23 +403,23 @@ void AkaoSnesScanner::searchForAkaoSnesFromARAM(RawFile *file) {
   u16 addrSeqHeader;
   u16 addrAPURelocBase;
   bool relocatable;
-  if (file->searchBytePattern(ptnReadSeqHeaderV4, ofsReadSeqHeader)) {
+  if (matches.find(ptnReadSeqHeaderV4, ofsReadSeqHeader)) {
     addrSeqHeader = file->readShort(ofsReadSeqHeader + 1);
     addrAPURelocBase = (file->readByte(ofsReadSeqHeader + 13) << 8) | file->readByte(ofsReadSeqHeader + 11);
     relocatable = true;
   }
-  else if (file->searchBytePattern(ptnReadSeqHeaderFFMQ, ofsReadSeqHeader)) {
+  else if (matches.find(ptnReadSeqHeaderFFMQ, ofsReadSeqHeader)) {
     addrSeqHeader = file->readShort(ofsReadSeqHeader + 3) + 1; // don't miss +1
     addrAPURelocBase = (file->readByte(ofsReadSeqHeader + 13) << 8) | file->readByte(ofsReadSeqHeader + 11);
     relocatable = true;
     minorVersion = AKAOSNES_V3_FFMQ;
   }
-  else if (file->searchBytePattern(ptnReadSeqHeaderV2, ofsReadSeqHeader)) {
+  else if (matches.find(ptnReadSeqHeaderV2, ofsReadSeqHeader)) {
     addrSeqHeader = file->readShort(ofsReadSeqHeader + 18);
     addrAPURelocBase = addrSeqHeader;
     relocatable = false;
   }
-  else if (file->searchBytePattern(ptnReadSeqHeaderV1, ofsReadSeqHeader)) {
+  else if (matches.find(ptnReadSeqHeaderV1, ofsReadSeqHeader)) {
     addrSeqHeader = file->readShort(ofsReadSeqHeader + 7);
     addrAPURelocBase = addrSeqHeader;
     relocatable = false;
@@ -540,10 +562,10 @@ void AkaoSnesScanner::searchForAkaoSnesFromARAM(RawFile *file) {
 
   u32 ofsLoadDIR;
   u16 spcDirAddr;
-  if (file->searchBytePattern(ptnLoadDIRV1, ofsLoadDIR)) {
+  if (matches.find(ptnLoadDIRV1, ofsLoadDIR)) {
     spcDirAddr = file->readByte(ofsLoadDIR + 1) << 8;
   }
-  else if (file->searchBytePattern(ptnLoadDIRV3, ofsLoadDIR)) {
+  else if (matches.find(ptnLoadDIRV3, ofsLoadDIR)) {
     spcDirAddr = file->readByte(ofsLoadDIR + 3) << 8;
   }
   else {
@@ -554,15 +576,15 @@ void AkaoSnesScanner::searchForAkaoSnesFromARAM(RawFile *file) {
   u16 addrTuningTable;
   u16 addrADSRTable;
   u16 addrPercussionTable;
-  if (version == AKAOSNES_V1 && file->searchBytePattern(ptnLoadInstrV1, ofsLoadInstr)) {
+  if (version == AKAOSNES_V1 && matches.find(ptnLoadInstrV1, ofsLoadInstr)) {
     addrTuningTable = file->readShort(ofsLoadInstr + 5);
     addrADSRTable = 0; // N/A
   }
-  else if (version == AKAOSNES_V2 && file->searchBytePattern(ptnLoadInstrV2, ofsLoadInstr)) {
+  else if (version == AKAOSNES_V2 && matches.find(ptnLoadInstrV2, ofsLoadInstr)) {
     addrTuningTable = file->readShort(ofsLoadInstr + 4);
     addrADSRTable = file->readShort(ofsLoadInstr + 34);
   }
-  else if (file->searchBytePattern(ptnLoadInstrV3, ofsLoadInstr)) {
+  else if (matches.find(ptnLoadInstrV3, ofsLoadInstr)) {
     addrTuningTable = file->readShort(ofsLoadInstr + 3);
     addrADSRTable = file->readShort(ofsLoadInstr + 15);
   }
@@ -571,7 +593,7 @@ void AkaoSnesScanner::searchForAkaoSnesFromARAM(RawFile *file) {
   }
 
   u32 ofsReadPercussionTable;
-  if (file->searchBytePattern(ptnReadPercussionTableV4, ofsReadPercussionTable))
+  if (matches.find(ptnReadPercussionTableV4, ofsReadPercussionTable))
   {
     addrPercussionTable = file->readShort(ofsReadPercussionTable + 19);
   }
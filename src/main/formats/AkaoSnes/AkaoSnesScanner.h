@@ -7,6 +7,7 @@
 
 #include "base/Types.h"
 #include "BytePattern.h"
+#include "BytePatternSet.h"
 #include "Scanner.h"
 
 enum AkaoSnesVersion : u8;  // see AkaoSnesFormat.h
@@ -19,6 +20,8 @@ class AkaoSnesScanner : public VGMScanner {
   static void searchForAkaoSnesFromARAM(RawFile *file);
 
  private:
+  static const BytePatternSet& signaturePatterns();
+
   static BytePattern ptnReadNoteLengthV1;
   static BytePattern ptnReadNoteLengthV2;
   static BytePattern ptnReadNoteLengthV4;
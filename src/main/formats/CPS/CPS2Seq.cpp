@@ -91,27 +91,24 @@ bool CPS2Seq::postLoad() {
   //  tempo, always updating at the rate of the driver irq.  We will have to convert
   //  ticks in our sequence into absolute elapsed time, which means we also need to keep
   //  track of any tempo events that change the absolute time per tick.
-  std::vector<MidiEvent *> tempoEvents;
+  std::vector<MidiEvent> tempoEvents;
   const auto &miditracks = midi->tracks();
 
   // First get all tempo events, we assume they occur on track 1
-  const auto& firstTrackEvents = miditracks[0]->events();
-  for (unsigned int i = 0; i < firstTrackEvents.size(); i++) {
-    MidiEvent *event = firstTrackEvents[i];
-    if (event->eventType() == MIDIEVENT_TEMPO)
+  for (const MidiEvent &event : miditracks[0]->events()) {
+    if (event.type == MIDIEVENT_TEMPO)
       tempoEvents.push_back(event);
   }
 
-  // For each track, gather all vibrato events, lfo events, pitch bend events and track end events
+  // For each track, gather all vibrato events, lfo events, pitch bend events and track end events.
+  // The events are copied, as the track's events move when the LFO events are inserted below
   for (unsigned int i = 0; i < miditracks.size(); i++) {
-    std::vector<MidiEvent *> events(tempoEvents);
+    std::vector<MidiEvent> events(tempoEvents);
     MidiTrack *track = miditracks[i];
     int channel = this->track(i)->channel;
 
-    const auto& trackEvents = track->events();
-    for (unsigned int j = 0; j < trackEvents.size(); j++) {
-      MidiEvent *event = trackEvents[j];
-      MidiEventType type = event->eventType();
+    for (const MidiEvent &event : track->events()) {
+      MidiEventType type = event.type;
       if (type == MIDIEVENT_MARKER || type == MIDIEVENT_PITCHBEND || type == MIDIEVENT_ENDOFTRACK)
         events.push_back(event);
     }
@@ -143,8 +140,8 @@ bool CPS2Seq::postLoad() {
 
     size_t numEvents = events.size();
     for (size_t j = 0; j < numEvents; j++) {
-      MidiEvent *event = events[j];
-      u32 curTicks = event->absTime;            //current absolute ticks
+      const MidiEvent &event = events[j];
+      u32 curTicks = event.absTime;            //current absolute ticks
 
       // For the span of time since the prior event, fill in any pitch and expression events that
       // should occur as a result of LFO fluctuation when vibrato and/or tremelo depth are set.
@@ -194,20 +191,20 @@ bool CPS2Seq::postLoad() {
 
       // We just handled LFO-induced events in the span between the prior event up to this one. Now,
       // check if the event is a tempo or marker event, which require special handling.
-      switch (event->eventType()) {
+      switch (event.type) {
         case MIDIEVENT_TEMPO: {
-          TempoEvent *tempoevent = static_cast<TempoEvent*>(event);
-          mpqn = tempoevent->microSecs;
+          mpqn = event.microSecs;
           mpt = mpqn / ppqn();
           break;
         }
 
         case MIDIEVENT_MARKER: {
-          MarkerEvent *marker = static_cast<MarkerEvent*>(event);
+          const MidiEvent::MarkerData &marker = event.marker;
+          const std::string_view name = track->text(event);
 
           // A vibrato event, it will provide us the frequency range of the lfo
-          if (marker->name == "vibrato") {
-            vibratoCents = vibrato_depth_table[marker->databyte1] * (100 / 256.0);
+          if (name == "vibrato") {
+            vibratoCents = vibrato_depth_table[marker.databyte1] * (100 / 256.0);
             u8 pitchBendRangeMSB = static_cast<u8>(ceil(static_cast<double>(vibratoCents + fmtPitchBendRange) / 100.0));
             pitchbendRange = pitchBendRangeMSB * 100;
 
@@ -223,16 +220,16 @@ bool CPS2Seq::postLoad() {
                                      static_cast<s16>((lfoCents + pitchbendCents) / static_cast<double>(pitchbendRange) * 8192),
                                      curTicks);
           }
-          else if (marker->name == "tremelo") {
-            tremelo = tremelo_depth_table[marker->databyte1];
+          else if (name == "tremelo") {
+            tremelo = tremelo_depth_table[marker.databyte1];
             if (tremelo == 0)
               track->insertExpression(channel, 127, curTicks);
           }
-          else if (marker->name == "lfo") {
-            lfoRate = lfo_rate_table[marker->databyte1];
+          else if (name == "lfo") {
+            lfoRate = lfo_rate_table[marker.databyte1];
           }
-          else if (marker->name == "resetlfo") {
-            if (marker->databyte1 != 1)
+          else if (name == "resetlfo") {
+            if (marker.databyte1 != 1)
               break;
             lfoVal = 0;
             effectiveLfoVal = 0;
@@ -243,8 +240,8 @@ bool CPS2Seq::postLoad() {
             if (tremelo > 0)
               track->insertExpression(channel, 127, curTicks);
           }
-          else if (marker->name == "pitchbend") {
-            pitchbendCents = static_cast<s16>((static_cast<s8>(marker->databyte1) / 128.0) * fmtPitchBendRange);
+          else if (name == "pitchbend") {
+            pitchbendCents = static_cast<s16>((static_cast<s8>(marker.databyte1) / 128.0) * fmtPitchBendRange);
             track->insertPitchBend(channel, static_cast<s16>((lfoCents + pitchbendCents) / static_cast<double>(pitchbendRange) * 8192), curTicks);
           }
           break;
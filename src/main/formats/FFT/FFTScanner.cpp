@@ -47,20 +47,20 @@ void FFTScanner::searchForFFTSeq(RawFile *file) {
 //		object "SampColl" は、class "WdsInstrSet"内で生成する。
 //--------------------------------------------------------------
 void FFTScanner::searchForFFTwds(RawFile *file) {
-  size_t nFileLength = file->size();
-  for (u32 i = 0; i + 0x30 < nFileLength; i++) {
-    u32 sig = file->readWordBE(i);
+  const ByteView view = file->view();
+  for (u32 i = 0; i + 0x30 < view.size(); i++) {
+    u32 sig = view.loadBE<u32>(i);
     if (sig != 0x64776473 && sig != 0x77647320)
       continue;
 
     // The sample collection size must not be impossibly large
-    if (file->readWord(i + 0x14) > 0x100000)
+    if (view.load<u32>(i + 0x14) > 0x100000)
       continue;
 
-    u32 hdrSize = file->readWord(i + 0x10);
+    u32 hdrSize = view.load<u32>(i + 0x10);
     // First 0x10 bytes of sample section should be 0s
-    if (file->readWord(i + hdrSize) != 0 || file->readWord(i + hdrSize + 4) != 0 ||
-        file->readWord(i + hdrSize + 8) != 0 || file->readWord(i + hdrSize + 12) != 0)
+    static constexpr u8 zeros[0x10] = {};
+    if (!view.matches(static_cast<size_t>(i) + hdrSize, zeros, sizeof(zeros)))
       continue;
 
     //if (size <= file->GetWord(i+0x10) || size <= file->GetWord(i+0x18))
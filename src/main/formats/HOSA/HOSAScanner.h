@@ -17,6 +17,8 @@ class HOSAScanner : public VGMScanner {
   explicit HOSAScanner(Format* format) : VGMScanner(format) {}
 
   void scan(RawFile *file, void *info) override;
+  // Reuses PSXSampColls already found by other scanners and removes the ones it doesn't need
+  bool canScanConcurrently() const override { return false; }
   static HOSASeq* searchForHOSASeq(RawFile *file);
   static HOSAInstrSet* searchForHOSAInstrSet(RawFile *file, const PSXSampColl *sampcoll);
   static bool recursiveRgnCompare(RawFile *file, int i, int sampNum, int numSamples, int numFinds, u32 *sampOffsets);
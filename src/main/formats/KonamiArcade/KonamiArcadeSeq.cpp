@@ -209,8 +209,7 @@ void KonamiArcadeTrack::makeTrulyPrevDurNoteEnd(u32 absTime) const {
   if (readMode == READMODE_CONVERT_TO_MIDI) {
     const auto& previousDurNoteOffs = pMidiTrack->previousDurNoteOffs();
     if (!previousDurNoteOffs.empty()) {
-      auto* prevDurNoteOff = previousDurNoteOffs.back();
-      prevDurNoteOff->absTime = absTime;
+      pMidiTrack->event(previousDurNoteOffs.back()).absTime = absTime;
     }
   }
 }
@@ -493,6 +493,28 @@ BytePattern KonamiSnesScanner::ptnLoadPercInstrGG4(
 	,
 	13);
 
+const BytePatternSet& KonamiSnesScanner::signaturePatterns() {
+  static const BytePatternSet patterns{
+      &ptnSetSongHeaderAddressGG4,
+      &ptnReadSongListPNTB,
+      &ptnReadSongListAXE,
+      &ptnReadSongListCNTR3,
+      &ptnJumpToVcmdGG4,
+      &ptnJumpToVcmdCNTR3,
+      &ptnBranchForVcmd6xMDR2,
+      &ptnBranchForVcmd6xCNTR3,
+      &ptnSetDIRGG4,
+      &ptnSetDIRCNTR3,
+      &ptnLoadInstrJOP,
+      &ptnLoadInstrGP,
+      &ptnLoadInstrGG4,
+      &ptnLoadInstrPNTB,
+      &ptnLoadInstrCNTR3,
+      &ptnLoadPercInstrGG4,
+  };
+  return patterns;
+}
+
 void KonamiSnesScanner::scan(RawFile *file, void *info) {
   size_t nFileLength = file->size();
   if (nFileLength == 0x10000) {
@@ -504,6 +526,7 @@ void KonamiSnesScanner::scan(RawFile *file, void *info) {
 }
 
 void KonamiSnesScanner::searchForKonamiSnesFromARAM(RawFile *file) {
+  const BytePatternMatches matches = file->searchBytePatterns(signaturePatterns());
   KonamiSnesVersion version = KONAMISNES_NONE;
 
   bool hasSongList = false;
@@ -522,24 +545,24 @@ void KonamiSnesScanner::searchForKonamiSnesFromARAM(RawFile *file) {
   u16 addrSongList = 0;
   s8 primarySongIndex = 0;
   u8 vcmdLenItemSize = 0;
-  if (file->searchBytePattern(ptnSetSongHeaderAddressGG4, ofsSetSongHeaderAddress)) {
+  if (matches.find(ptnSetSongHeaderAddressGG4, ofsSetSongHeaderAddress)) {
     addrSongHeader = file->readByte(ofsSetSongHeaderAddress + 1) | (file->readByte(ofsSetSongHeaderAddress + 4) << 8);
     vcmdLenItemSize = 2;
     hasSongList = false;
   }
-  else if (file->searchBytePattern(ptnReadSongListPNTB, ofsReadSongList)) {
+  else if (matches.find(ptnReadSongListPNTB, ofsReadSongList)) {
     addrSongList = file->readByte(ofsReadSongList + 3) | (file->readByte(ofsReadSongList + 6) << 8);
     primarySongIndex = file->readByte(ofsReadSongList + 31);
     vcmdLenItemSize = 1;
     hasSongList = true;
   }
-  else if (file->searchBytePattern(ptnReadSongListAXE, ofsReadSongList)) {
+  else if (matches.find(ptnReadSongListAXE, ofsReadSongList)) {
     addrSongList = file->readByte(ofsReadSongList + 3) | (file->readByte(ofsReadSongList + 6) << 8);
     primarySongIndex = file->readByte(ofsReadSongList + 32);
     vcmdLenItemSize = 2;
     hasSongList = true;
   }
-  else if (file->searchBytePattern(ptnReadSongListCNTR3, ofsReadSongList)) {
+  else if (matches.find(ptnReadSongListCNTR3, ofsReadSongList)) {
     addrSongList = file->readByte(ofsReadSongList + 3) | (file->readByte(ofsReadSongList + 6) << 8);
     primarySongIndex = file->readByte(ofsReadSongList + 32);
     vcmdLenItemSize = 1;
@@ -553,7 +576,7 @@ void KonamiSnesScanner::searchForKonamiSnesFromARAM(RawFile *file) {
   u32 ofsJumpToVcmd;
   u16 addrVcmdLengthTable;
   u8 vcmd6XCountInList;
-  if (file->searchBytePattern(ptnJumpToVcmdGG4, ofsJumpToVcmd)) {
+  if (matches.find(ptnJumpToVcmdGG4, ofsJumpToVcmd)) {
     addrVcmdLengthTable = file->readShort(ofsJumpToVcmd + 11);
     vcmd6XCountInList = 0;
 
@@ -562,15 +585,15 @@ void KonamiSnesScanner::searchForKonamiSnesFromARAM(RawFile *file) {
       return;
     }
   }
-  else if (file->searchBytePattern(ptnJumpToVcmdCNTR3, ofsJumpToVcmd)) {
+  else if (matches.find(ptnJumpToVcmdCNTR3, ofsJumpToVcmd)) {
     addrVcmdLengthTable = file->readShort(ofsJumpToVcmd + 17);
 
     u32 ofsBranchForVcmd6x;
-    if (file->searchBytePattern(ptnBranchForVcmd6xCNTR3, ofsBranchForVcmd6x)) {
+    if (matches.find(ptnBranchForVcmd6xCNTR3, ofsBranchForVcmd6x)) {
       // vcmd 60-64 is in the list
       vcmd6XCountInList = 5;
     }
-    else if (file->searchBytePattern(ptnBranchForVcmd6xMDR2, ofsBranchForVcmd6x)) {
+    else if (matches.find(ptnBranchForVcmd6xMDR2, ofsBranchForVcmd6x)) {
       // vcmd 60-61 is in the list
       vcmd6XCountInList = 2;
     }
@@ -642,10 +665,10 @@ void KonamiSnesScanner::searchForKonamiSnesFromARAM(RawFile *file) {
   u32 ofsSetDIR;
   u16 spcDirAddr;
   std::map<std::string, std::vector<u8>>::iterator itrDSP;
-  if (file->searchBytePattern(ptnSetDIRGG4, ofsSetDIR)) {
+  if (matches.find(ptnSetDIRGG4, ofsSetDIR)) {
     spcDirAddr = file->readByte(ofsSetDIR + 4) << 8;
   }
-  else if (file->searchBytePattern(ptnSetDIRCNTR3, ofsSetDIR)) {
+  else if (matches.find(ptnSetDIRCNTR3, ofsSetDIR)) {
     spcDirAddr = file->readByte(ofsSetDIR + 1) << 8;
   }
   else if ((itrDSP = file->tag.binaries.find("dsp")) != file->tag.binaries.end()) {
@@ -662,7 +685,7 @@ void KonamiSnesScanner::searchForKonamiSnesFromARAM(RawFile *file) {
   u16 addrBankedInstrTable;
   u8 firstBankedInstr;
   u16 addrPercInstrTable;
-  if (file->searchBytePattern(ptnLoadInstrJOP, ofsLoadInstr)) {
+  if (matches.find(ptnLoadInstrJOP, ofsLoadInstr)) {
     addrCommonInstrTable = file->readByte(ofsLoadInstr + 8) | (file->readByte(ofsLoadInstr + 11) << 8);
     firstBankedInstr = file->readByte(ofsLoadInstr + 4);
 
@@ -672,14 +695,14 @@ void KonamiSnesScanner::searchForKonamiSnesFromARAM(RawFile *file) {
 
     // scan for percussive instrument table
     u32 ofsLoadPercInstr;
-    if (file->searchBytePattern(ptnLoadPercInstrGG4, ofsLoadPercInstr)) {
+    if (matches.find(ptnLoadPercInstrGG4, ofsLoadPercInstr)) {
       addrPercInstrTable = file->readByte(ofsLoadPercInstr + 1) | (file->readByte(ofsLoadPercInstr + 4) << 8);
     }
     else {
       return;
     }
   }
-  else if (file->searchBytePattern(ptnLoadInstrGP, ofsLoadInstr)) {
+  else if (matches.find(ptnLoadInstrGP, ofsLoadInstr)) {
     addrCommonInstrTable = file->readByte(ofsLoadInstr + 14) | (file->readByte(ofsLoadInstr + 17) << 8);
     firstBankedInstr = file->readByte(ofsLoadInstr + 10);
 
@@ -689,14 +712,14 @@ void KonamiSnesScanner::searchForKonamiSnesFromARAM(RawFile *file) {
 
     // scan for percussive instrument table
     u32 ofsLoadPercInstr;
-    if (file->searchBytePattern(ptnLoadPercInstrGG4, ofsLoadPercInstr)) {
+    if (matches.find(ptnLoadPercInstrGG4, ofsLoadPercInstr)) {
       addrPercInstrTable = file->readByte(ofsLoadPercInstr + 1) | (file->readByte(ofsLoadPercInstr + 4) << 8);
     }
     else {
       return;
     }
   }
-  else if (file->searchBytePattern(ptnLoadInstrGG4, ofsLoadInstr)) {
+  else if (matches.find(ptnLoadInstrGG4, ofsLoadInstr)) {
     addrCommonInstrTable = file->readByte(ofsLoadInstr + 15) | (file->readByte(ofsLoadInstr + 18) << 8);
     firstBankedInstr = file->readByte(ofsLoadInstr + 11);
 
@@ -706,14 +729,14 @@ void KonamiSnesScanner::searchForKonamiSnesFromARAM(RawFile *file) {
 
     // scan for percussive instrument table
     u32 ofsLoadPercInstr;
-    if (file->searchBytePattern(ptnLoadPercInstrGG4, ofsLoadPercInstr)) {
+    if (matches.find(ptnLoadPercInstrGG4, ofsLoadPercInstr)) {
       addrPercInstrTable = file->readByte(ofsLoadPercInstr + 1) | (file->readByte(ofsLoadPercInstr + 4) << 8);
     }
     else {
       return;
     }
   }
-  else if (file->searchBytePattern(ptnLoadInstrPNTB, ofsLoadInstr)) {
+  else if (matches.find(ptnLoadInstrPNTB, ofsLoadInstr)) {
     addrCommonInstrTable = file->readByte(ofsLoadInstr + 12) | (file->readByte(ofsLoadInstr + 15) << 8);
     firstBankedInstr = file->readByte(ofsLoadInstr + 8);
 
@@ -723,7 +746,7 @@ void KonamiSnesScanner::searchForKonamiSnesFromARAM(RawFile *file) {
 
     addrPercInstrTable = file->readByte(ofsLoadInstr + 46) | (file->readByte(ofsLoadInstr + 49) << 8);
   }
-  else if (file->searchBytePattern(ptnLoadInstrCNTR3, ofsLoadInstr)) {
+  else if (matches.find(ptnLoadInstrCNTR3, ofsLoadInstr)) {
     addrCommonInstrTable = file->readByte(ofsLoadInstr + 15) | (file->readByte(ofsLoadInstr + 19) << 8);
     firstBankedInstr = file->readByte(ofsLoadInstr + 11);
 
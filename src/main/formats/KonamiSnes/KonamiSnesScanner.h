@@ -7,6 +7,7 @@
 
 #include "base/Types.h"
 #include "BytePattern.h"
+#include "BytePatternSet.h"
 #include "Scanner.h"
 
 enum KonamiSnesVersion : u8;  // see KonamiSnesFormat.h
@@ -19,6 +20,9 @@ class KonamiSnesScanner : public VGMScanner {
   void searchForKonamiSnesFromARAM(RawFile *file);
 
  private:
+  // Every pattern below, searched for in a single pass
+  static const BytePatternSet& signaturePatterns();
+
   static BytePattern ptnSetSongHeaderAddressGG4;
   static BytePattern ptnReadSongListPNTB;
   static BytePattern ptnReadSongListAXE;
@@ -70,19 +70,15 @@ void NDSScanner::scan(RawFile* file, void* /*info*/) {
 }
 
 void NDSScanner::searchForSDAT(RawFile *file) {
-  using namespace std::string_literals;
-  const std::string signature = "SDAT\xFF\xFE\x00\x01"s;
+  static constexpr u8 signatureTail[] = {0xFF, 0xFE, 0x00, 0x01};  // follows "SDAT"
 
-  auto it = std::search(file->begin(), file->end(),
-    std::boyer_moore_searcher(signature.begin(), signature.end()));
-  while (it != file->end()) {
-    size_t offset = it - file->begin();
+  for (u32 offset : file->magicIndex().offsets("SDAT")) {
+    if (offset + 8 > file->size() || !file->matchBytes(signatureTail, offset + 4, 4)) {
+      continue;
+    }
     if (file->get<u32>(offset + 0x10) < 0x10000) {
       loadFromSDAT(file, offset);
     }
-
-    it = std::search(std::next(it), file->end(),
-      std::boyer_moore_searcher(signature.begin(), signature.end()));
   }
 }
 
@@ -114,6 +114,7 @@ void NinSnesScanner::loadFromScanResult(RawFile* file, const NinSnesScanResult&
 }
 
 void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
+  const BytePatternMatches matches = file->searchBytePatterns(signaturePatterns());
   NinSnesProfileId profileId = NinSnesProfileId::Unknown;
   NinSnesSignatureId signature = NinSnesSignatureId::None;
 
@@ -126,20 +127,20 @@ void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
   u16 konamiBaseAddress = 0xffff;
   u16 falcomBaseAddress = 0xffff;
   u16 falcomBaseOffset = 0;
-  if (file->searchBytePattern(ptnIncSectionPtr, ofsIncSectionPtr)) {
+  if (matches.find(ptnIncSectionPtr, ofsIncSectionPtr)) {
     signature = NinSnesSignatureId::Standard;
     addrSectionPtr = file->readByte(ofsIncSectionPtr + 3);
   }
   // DERIVED VERSIONS
-  else if (file->searchBytePattern(ptnIncSectionPtrGD3, ofsIncSectionPtr)) {
+  else if (matches.find(ptnIncSectionPtrGD3, ofsIncSectionPtr)) {
     signature = NinSnesSignatureId::Konami;
     u8 konamiBaseAddressPtr = file->readByte(ofsIncSectionPtr + 16);
     addrSectionPtr = file->readByte(ofsIncSectionPtr + 3);
     konamiBaseAddress = file->readShort(konamiBaseAddressPtr);
-  } else if (file->searchBytePattern(ptnIncSectionPtrYSFR, ofsIncSectionPtr)) {
+  } else if (matches.find(ptnIncSectionPtrYSFR, ofsIncSectionPtr)) {
     signature = NinSnesSignatureId::Tose;
     addrSectionPtr = file->readByte(ofsIncSectionPtr + 3);
-  } else if (file->searchBytePattern(ptnIncSectionPtrYs4, ofsIncSectionPtr)) {
+  } else if (matches.find(ptnIncSectionPtrYs4, ofsIncSectionPtr)) {
     signature = NinSnesSignatureId::FalcomYs4;
     addrSectionPtr = file->readByte(ofsIncSectionPtr + 3);
   } else {
@@ -158,8 +159,8 @@ void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
     u32 ofsInitSectionPtr;
     NinSnesSongListInfo info;
 
-    if (file->searchBytePattern(ptnInitSectionPtr, ofsInitSectionPtr)) {
-      if (file->searchBytePattern(ptnInitSectionPtrYs4, ofsInitSectionPtr)) {
+    if (matches.find(ptnInitSectionPtr, ofsInitSectionPtr)) {
+      if (matches.find(ptnInitSectionPtrYs4, ofsInitSectionPtr)) {
         info.signature = NinSnesSignatureId::FalcomYs4;
         info.profileId = NinSnesProfileId::FalcomYs4;
         info.address = file->readShort(ofsInitSectionPtr + 5);
@@ -170,18 +171,18 @@ void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
       return info;
     }
 
-    if (file->searchBytePattern(ptnInitSectionPtrYI, ofsInitSectionPtr)) {
+    if (matches.find(ptnInitSectionPtrYI, ofsInitSectionPtr)) {
       info.address = file->readShort(ofsInitSectionPtr + 12);
       return info;
     }
 
-    if (file->searchBytePattern(ptnInitSectionPtrSMW, ofsInitSectionPtr)) {
+    if (matches.find(ptnInitSectionPtrSMW, ofsInitSectionPtr)) {
       info.signature = NinSnesSignatureId::Earlier;
       info.address = file->readShort(ofsInitSectionPtr + 3);
       return info;
     }
 
-    if (file->searchBytePattern(ptnInitSectionPtrGD3, ofsInitSectionPtr)) {
+    if (matches.find(ptnInitSectionPtrGD3, ofsInitSectionPtr)) {
       info.address = file->readShort(ofsInitSectionPtr + 8);
       if (konamiBaseAddress == 0xffff) {
         // Parodius Da! does not have base address
@@ -190,24 +191,24 @@ void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
       return info;
     }
 
-    if (file->searchBytePattern(ptnInitSectionPtrTS, ofsInitSectionPtr)) {
+    if (matches.find(ptnInitSectionPtrTS, ofsInitSectionPtr)) {
       info.signature = NinSnesSignatureId::Quintet;
       const u16 addrSongListPtr = file->readShort(ofsInitSectionPtr + 1);
       info.address = file->readShort(addrSongListPtr);
       return info;
     }
 
-    if (file->searchBytePattern(ptnInitSectionPtrHE4, ofsInitSectionPtr)) {
+    if (matches.find(ptnInitSectionPtrHE4, ofsInitSectionPtr)) {
       info.address = file->readByte(ofsInitSectionPtr + 4) << 8;
       return info;
     }
 
-    if (file->searchBytePattern(ptnInitSectionPtrYSFR, ofsInitSectionPtr)) {
+    if (matches.find(ptnInitSectionPtrYSFR, ofsInitSectionPtr)) {
       const u8 addrSongListPtr = file->readByte(ofsInitSectionPtr + 2);
       const BytePattern ptnInitSongListPtrYSFR = makeInitSongListPtrYSFRPattern(addrSongListPtr);
 
       u32 ofsInitSongListPtr;
-      if (!file->searchBytePattern(ptnInitSongListPtrYSFR, ofsInitSongListPtr)) {
+      if (!matches.find(ptnInitSongListPtrYSFR, ofsInitSongListPtr)) {
         return std::nullopt;
       }
 
@@ -244,11 +245,11 @@ void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
     u32 ofsBranchForVcmd;
     NinSnesVoiceCommandInfo info;
 
-    if (file->searchBytePattern(ptnJumpToVcmdYSFR, ofsBranchForVcmd)) {
+    if (matches.find(ptnJumpToVcmdYSFR, ofsBranchForVcmd)) {
       info.addressTable = file->readShort(ofsBranchForVcmd + 9);
 
       u32 ofsReadVcmdLength;
-      if (!file->searchBytePattern(ptnReadVcmdLengthYSFR, ofsReadVcmdLength)) {
+      if (!matches.find(ptnReadVcmdLengthYSFR, ofsReadVcmdLength)) {
         return std::nullopt;
       }
 
@@ -261,11 +262,11 @@ void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
       return info;
     }
 
-    if (file->searchBytePattern(ptnJumpToVcmdYs4, ofsBranchForVcmd)) {
+    if (matches.find(ptnJumpToVcmdYs4, ofsBranchForVcmd)) {
       info.addressTable = file->readShort(ofsBranchForVcmd + 10);
 
       u32 ofsReadVcmdLength;
-      if (!file->searchBytePattern(ptnReadVcmdLengthYs4, ofsReadVcmdLength)) {
+      if (!matches.find(ptnReadVcmdLengthYs4, ofsReadVcmdLength)) {
         return std::nullopt;
       }
 
@@ -276,9 +277,9 @@ void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
       return info;
     }
 
-    if (file->searchBytePattern(ptnBranchForVcmdReadahead, ofsBranchForVcmd)) {
+    if (matches.find(ptnBranchForVcmdReadahead, ofsBranchForVcmd)) {
       info.firstVoiceCmd = file->readByte(ofsBranchForVcmd + 5);
-    } else if (file->searchBytePattern(ptnBranchForVcmd, ofsBranchForVcmd)) {
+    } else if (matches.find(ptnBranchForVcmd, ofsBranchForVcmd)) {
       // this search often finds a wrong code, but some games still need it (for example, Human
       // games)
       info.firstVoiceCmd = file->readByte(ofsBranchForVcmd + 1);
@@ -287,8 +288,8 @@ void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
     }
 
     u32 ofsJumpToVcmd;
-    if (file->searchBytePattern(ptnJumpToVcmd, ofsJumpToVcmd)) {
-      if (file->searchBytePattern(ptnJumpToVcmdCTOW, ofsJumpToVcmd)) {
+    if (matches.find(ptnJumpToVcmd, ofsJumpToVcmd)) {
+      if (matches.find(ptnJumpToVcmdCTOW, ofsJumpToVcmd)) {
         info.signature = NinSnesSignatureId::Human;
         info.profileId = NinSnesProfileId::Human;
         info.addressTable = file->readShort(ofsJumpToVcmd + 10);
@@ -298,9 +299,9 @@ void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
         info.addressTable = file->readShort(ofsJumpToVcmd + 7) + ((info.firstVoiceCmd * 2) & 0xff);
         info.lengthTable = file->readShort(ofsJumpToVcmd + 14) + (info.firstVoiceCmd & 0x7f);
       }
-    } else if (file->searchBytePattern(ptnJumpToVcmdSMW, ofsJumpToVcmd)) {
+    } else if (matches.find(ptnJumpToVcmdSMW, ofsJumpToVcmd)) {
       u32 ofsReadVcmdLength;
-      if (!file->searchBytePattern(ptnReadVcmdLengthSMW, ofsReadVcmdLength)) {
+      if (!matches.find(ptnReadVcmdLengthSMW, ofsReadVcmdLength)) {
         return std::nullopt;
       }
 
@@ -340,7 +341,7 @@ void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
   std::vector<u8> volumeTable;
   auto loadNoteTable = [&](const BytePattern& pattern, u8 durTableOffset,
                            u8 volumeTableOffset) -> bool {
-    if (!file->searchBytePattern(pattern, ofsDispatchNote)) {
+    if (!matches.find(pattern, ofsDispatchNote)) {
       return false;
     }
 
@@ -358,18 +359,18 @@ void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
   u32 ofsInstrVCmd = 0;
   auto classifyIntelligentProfile = [&]() -> NinSnesProfileId {
     u32 ofsIntelliVCmdFA;
-    if (!file->searchBytePattern(ptnIntelliVCmdFA, ofsIntelliVCmdFA)) {
+    if (!matches.find(ptnIntelliVCmdFA, ofsIntelliVCmdFA)) {
       return NinSnesProfileId::Unknown;
     }
 
-    if (file->searchBytePattern(ptnDispatchNoteFE3, ofsDispatchNote)) {
+    if (matches.find(ptnDispatchNoteFE3, ofsDispatchNote)) {
       return firstVoiceCmd == 0xd6 && matchNinSnesByteTable(file, addrVoiceCmdLengthTable,
                                                             kIntelliFe3VcmdLengthTable)
                  ? NinSnesProfileId::IntelliFe3
                  : NinSnesProfileId::Unknown;
     }
 
-    if (file->searchBytePattern(ptnDispatchNoteFE4, ofsDispatchNote)) {
+    if (matches.find(ptnDispatchNoteFE4, ofsDispatchNote)) {
       return firstVoiceCmd == 0xda && matchNinSnesByteTable(file, addrVoiceCmdLengthTable,
                                                             kIntelliFe4VcmdLengthTable)
                  ? NinSnesProfileId::IntelliFe4
@@ -387,7 +388,7 @@ void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
       return NinSnesProfileId::Konami;
     }
 
-    if (file->searchBytePattern(ptnDispatchNoteLEM, ofsDispatchNote)) {
+    if (matches.find(ptnDispatchNoteLEM, ofsDispatchNote)) {
       return firstVoiceCmd == 0xe0 ? NinSnesProfileId::Lemmings : NinSnesProfileId::Unknown;
     }
 
@@ -401,13 +402,13 @@ void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
     if (canonicalVcmdLayout) {
       u32 ofsWriteVolume;
 
-      if (file->searchBytePattern(ptnWriteVolumeKSS, ofsWriteVolume)) {
+      if (matches.find(ptnWriteVolumeKSS, ofsWriteVolume)) {
         return NinSnesProfileId::Hal;
       }
-      if (file->searchBytePattern(ptnInstrVCmdACTR, ofsInstrVCmd)) {
+      if (matches.find(ptnInstrVCmdACTR, ofsInstrVCmd)) {
         return NinSnesProfileId::QuintetActR;
       }
-      if (file->searchBytePattern(ptnInstrVCmdACTR2, ofsInstrVCmd)) {
+      if (matches.find(ptnInstrVCmdACTR2, ofsInstrVCmd)) {
         return NinSnesProfileId::QuintetActR2;
       }
       return NinSnesProfileId::Standard;
@@ -418,16 +419,16 @@ void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
     const bool hasQuintetLookupTail =
         numOfVoiceCmd == 32 && file->readByte(addrVoiceCmdLengthTable + 31) == 1;
 
-    if (file->searchBytePattern(ptnRD1VCmd_FA_FE, ofsRD1VCmd_FA_FE)) {
+    if (matches.find(ptnRD1VCmd_FA_FE, ofsRD1VCmd_FA_FE)) {
       return NinSnesProfileId::Rd1;
     }
-    if (file->searchBytePattern(ptnRD2VCmdInstrADSR, ofsRD2VCmdInstrADSR)) {
+    if (matches.find(ptnRD2VCmdInstrADSR, ofsRD2VCmdInstrADSR)) {
       return NinSnesProfileId::Rd2;
     }
-    if (hasQuintetLookupTail && file->searchBytePattern(ptnInstrVCmdACTR2, ofsInstrVCmd)) {
+    if (hasQuintetLookupTail && matches.find(ptnInstrVCmdACTR2, ofsInstrVCmd)) {
       return NinSnesProfileId::QuintetIog;
     }
-    if (hasQuintetLookupTail && file->searchBytePattern(ptnInstrVCmdTS, ofsInstrVCmd)) {
+    if (hasQuintetLookupTail && matches.find(ptnInstrVCmdTS, ofsInstrVCmd)) {
       return NinSnesProfileId::QuintetTs;
     }
     return NinSnesProfileId::Standard;
@@ -593,23 +594,23 @@ void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
 
   auto findDirAddress = [&]() -> std::optional<u16> {
     u32 ofsSetDIR;
-    if (file->searchBytePattern(ptnSetDIR, ofsSetDIR)) {
+    if (matches.find(ptnSetDIR, ofsSetDIR)) {
       return static_cast<u16>(file->readByte(ofsSetDIR + 4) << 8);
     }
-    if (file->searchBytePattern(ptnSetDIRYI, ofsSetDIR)) {
+    if (matches.find(ptnSetDIRYI, ofsSetDIR)) {
       return static_cast<u16>(file->readByte(ofsSetDIR + 1) << 8);
     }
-    if (file->searchBytePattern(ptnSetDIRVS, ofsSetDIR)) {
+    if (matches.find(ptnSetDIRVS, ofsSetDIR)) {
       const u16 spcDirAddrPtr = file->readShort(ofsSetDIR + 1);
       return static_cast<u16>(file->readByte(spcDirAddrPtr) << 8);
     }
-    if (file->searchBytePattern(ptnSetDIRSMW, ofsSetDIR)) {
+    if (matches.find(ptnSetDIRSMW, ofsSetDIR)) {
       return static_cast<u16>(file->readByte(ofsSetDIR + 9) << 8);
     }
-    if (file->searchBytePattern(ptnSetDIRCTOW, ofsSetDIR)) {
+    if (matches.find(ptnSetDIRCTOW, ofsSetDIR)) {
       return static_cast<u16>(file->readByte(ofsSetDIR + 3) << 8);
     }
-    if (file->searchBytePattern(ptnSetDIRTS, ofsSetDIR)) {
+    if (matches.find(ptnSetDIRTS, ofsSetDIR)) {
       return static_cast<u16>(file->readByte(ofsSetDIR + 1) << 8);
     }
     return std::nullopt;
@@ -622,24 +623,23 @@ void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
 
     u32 ofsLoadInstrTableAddressASM;
     NinSnesInstrumentProbeInfo info;
-    if (file->searchBytePattern(ptnLoadInstrTableAddress, ofsLoadInstrTableAddressASM)) {
+    if (matches.find(ptnLoadInstrTableAddress, ofsLoadInstrTableAddressASM)) {
       info.tableAddress = file->readByte(ofsLoadInstrTableAddressASM + 7) |
                           (file->readByte(ofsLoadInstrTableAddressASM + 10) << 8);
       const u32 firstWord = file->readWord(info.tableAddress);
       if (firstWord == 0 || firstWord == 0xFFFFFFFF) {
         info.tableAddress += 4;
       }
-    } else if (file->searchBytePattern(ptnLoadInstrTableAddressSMW, ofsLoadInstrTableAddressASM)) {
+    } else if (matches.find(ptnLoadInstrTableAddressSMW, ofsLoadInstrTableAddressASM)) {
       info.tableAddress = file->readByte(ofsLoadInstrTableAddressASM + 3) |
                           (file->readByte(ofsLoadInstrTableAddressASM + 6) << 8);
     } else {
       switch (profile.instrTableAddressModel) {
         case NinSnesInstrTableAddressModelId::Human:
-          if (file->searchBytePattern(ptnLoadInstrTableAddressCTOW, ofsLoadInstrTableAddressASM)) {
+          if (matches.find(ptnLoadInstrTableAddressCTOW, ofsLoadInstrTableAddressASM)) {
             info.tableAddress = file->readByte(ofsLoadInstrTableAddressASM + 7) |
                                 (file->readByte(ofsLoadInstrTableAddressASM + 10) << 8);
-          } else if (file->searchBytePattern(ptnLoadInstrTableAddressSOS,
-                                             ofsLoadInstrTableAddressASM)) {
+          } else if (matches.find(ptnLoadInstrTableAddressSOS, ofsLoadInstrTableAddressASM)) {
             info.tableAddress = file->readByte(ofsLoadInstrTableAddressASM + 1) |
                                 (file->readByte(ofsLoadInstrTableAddressASM + 4) << 8);
           } else {
@@ -648,7 +648,7 @@ void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
           break;
 
         case NinSnesInstrTableAddressModelId::Tose:
-          if (!file->searchBytePattern(ptnLoadInstrTableAddressYSFR, ofsLoadInstrTableAddressASM)) {
+          if (!matches.find(ptnLoadInstrTableAddressYSFR, ofsLoadInstrTableAddressASM)) {
             return std::nullopt;
           }
           info.dirAddress = file->readByte(ofsLoadInstrTableAddressASM + 3) << 8;
@@ -685,7 +685,7 @@ void NinSnesScanner::searchForNinSnesFromARAM(RawFile* file) {
   u16 konamiTuningTableAddress = 0;
   u8 konamiTuningTableSize = 0;
   if (profile.instrumentLayout == NinSnesInstrumentLayoutId::KonamiTuningTable) {
-    if (file->searchBytePattern(ptnInstrVCmdGD3, ofsInstrVCmd)) {
+    if (matches.find(ptnInstrVCmdGD3, ofsInstrVCmd)) {
       u16 konamiAddrTuningTableLow = file->readShort(ofsInstrVCmd + 10);
       u16 konamiAddrTuningTableHigh = file->readShort(ofsInstrVCmd + 14);
 
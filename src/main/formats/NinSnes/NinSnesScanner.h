@@ -7,6 +7,7 @@
 
 #include "base/Types.h"
 #include "BytePattern.h"
+#include "BytePatternSet.h"
 #include "NinSnesScanResult.h"
 #include "Scanner.h"
 
@@ -28,6 +29,10 @@ private:
   static BytePattern makeInitSectionPtrYs4Pattern(u8 addrSectionPtr);
   static BytePattern makeInitSongListPtrYSFRPattern(u8 addrSongListPtr);
 
+  // The fixed patterns below, compiled so one pass over the ARAM finds them all.
+  // The song list patterns above depend on the ARAM contents and are searched on their own.
+  static const BytePatternSet& signaturePatterns();
+
   static BytePattern ptnBranchForVcmd;
   static BytePattern ptnBranchForVcmdReadahead;
   static BytePattern ptnJumpToVcmd;
@@ -853,3 +853,50 @@ BytePattern NinSnesScanner::ptnInstrVCmdTS("\xd5\x17\x02\xd0\x12\xfd\x10\x07"
                                            "xxxxxxx?"
                                            "?",
                                            33);
+
+const BytePatternSet& NinSnesScanner::signaturePatterns() {
+  static const BytePatternSet patterns{
+      &ptnBranchForVcmd,
+      &ptnBranchForVcmdReadahead,
+      &ptnJumpToVcmd,
+      &ptnJumpToVcmdSMW,
+      &ptnReadVcmdLengthSMW,
+      &ptnDispatchNoteYI,
+      &ptnIncSectionPtr,
+      &ptnLoadInstrTableAddress,
+      &ptnLoadInstrTableAddressSMW,
+      &ptnSetDIR,
+      &ptnSetDIRYI,
+      &ptnSetDIRVS,
+      &ptnSetDIRSMW,
+      &ptnIncSectionPtrGD3,
+      &ptnIncSectionPtrYSFR,
+      &ptnIncSectionPtrYs4,
+      &ptnInitSectionPtrHE4,
+      &ptnJumpToVcmdCTOW,
+      &ptnJumpToVcmdYSFR,
+      &ptnJumpToVcmdYs4,
+      &ptnReadVcmdLengthYSFR,
+      &ptnReadVcmdLengthYs4,
+      &ptnDispatchNoteGD3,
+      &ptnDispatchNoteYSFR,
+      &ptnDispatchNoteLEM,
+      &ptnDispatchNoteFE3,
+      &ptnDispatchNoteFE4,
+      &ptnDispatchNoteYs4,
+      &ptnWriteVolumeKSS,
+      &ptnRD1VCmd_FA_FE,
+      &ptnRD2VCmdInstrADSR,
+      &ptnIntelliVCmdFA,
+      &ptnInstrVCmdGD3,
+      &ptnLoadInstrTableAddressSOS,
+      &ptnLoadInstrTableAddressCTOW,
+      &ptnLoadInstrTableAddressYSFR,
+      &ptnSetDIRCTOW,
+      &ptnSetDIRTS,
+      &ptnInstrVCmdACTR,
+      &ptnInstrVCmdACTR2,
+      &ptnInstrVCmdTS,
+  };
+  return patterns;
+}
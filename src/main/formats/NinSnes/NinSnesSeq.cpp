@@ -56,7 +56,7 @@ NinSnesSeq::NinSnesSeq(RawFile* file, const NinSnesScanResult& scanResult)
   falcomBaseOffset = scanResult.falcomBaseOffset;
 }
 
-bool NinSnesSeq::load() {
+bool NinSnesSeq::parse() {
   readMode = READMODE_ADD_TO_UI;
 
   if (!parseHeader()) {
@@ -124,7 +124,7 @@ bool NinSnesSeq::loadTracks(ReadMode readMode, u32 stopTime) {
   curOffset = dwStartOffset;
 
   if (readMode == READMODE_CONVERT_TO_MIDI) {
-    timedEventIndex().clear();
+    conversionTimeline().clear();
   }
 
   resetVars();
@@ -162,7 +162,7 @@ bool NinSnesSeq::postLoad() {
     }
   } else if (readMode == READMODE_CONVERT_TO_MIDI) {
     midi->sort();
-    timedEventIndex().finalize();
+    conversionTimeline().finalize();
   }
 
   return true;
@@ -31,7 +31,7 @@ public:
   NinSnesSeq(RawFile* file, const NinSnesScanResult& scanResult);
   ~NinSnesSeq() override = default;
 
-  bool load() override;
+  bool parse() override;
   bool parseHeader() override;
   void resetVars() override;
   void onTickEnd() override;
@@ -10,8 +10,6 @@
 #include "PSXSPU.h"
 #include "ScannerManager.h"
 
-#include <algorithm>
-#include <functional>
 
 namespace vgmtrans::scanners {
 ScannerRegistration<PS1SeqScanner> s_ps1seq("PS1");
@@ -26,19 +24,12 @@ void PS1SeqScanner::scan(RawFile* file, void* /*info*/) {
 std::vector<PS1Seq *> PS1SeqScanner::searchForPS1Seq(RawFile *file) {
   std::vector<PS1Seq *> loadedFiles;
 
-  using namespace std::string_literals;
-  const std::string signature = "SEQp"s;
-  auto it = std::search(file->begin(), file->end(),
-                        std::boyer_moore_searcher(signature.rbegin(), signature.rend()));
-
-  while (it != file->end()) {
-    auto* newPS1Seq = pRoot->loadVGMFile<PS1Seq>(file, it - file->begin());
+  // "SEQp" is stored little-endian
+  for (u32 offset : file->magicIndex().offsets("pQES")) {
+    auto* newPS1Seq = pRoot->loadVGMFile<PS1Seq>(file, offset);
     if (newPS1Seq) {
       loadedFiles.push_back(newPS1Seq);
     }
-
-    it = std::search(std::next(it), file->end(),
-                     std::boyer_moore_searcher(signature.rbegin(), signature.rend()));
   }
 
   return loadedFiles;
@@ -47,19 +38,12 @@ std::vector<PS1Seq *> PS1SeqScanner::searchForPS1Seq(RawFile *file) {
 std::vector<Vab *> PS1SeqScanner::searchForVab(RawFile *file) {
   std::vector<Vab *> loadedFiles;
 
-  using namespace std::string_literals;
-  const std::string signature = "VABp"s;
-  auto it = std::search(file->begin(), file->end(),
-                        std::boyer_moore_searcher(signature.rbegin(), signature.rend()));
-
-  while (it != file->end()) {
-    auto* newVab = pRoot->loadVGMFile<Vab>(file, it - file->begin());
+  // "VABp" is stored little-endian
+  for (u32 offset : file->magicIndex().offsets("pBAV")) {
+    auto* newVab = pRoot->loadVGMFile<Vab>(file, offset);
     if (newVab) {
       loadedFiles.push_back(newVab);
     }
-
-    it = std::search(std::next(it), file->end(),
-                     std::boyer_moore_searcher(signature.rbegin(), signature.rend()));
   }
 
   return loadedFiles;
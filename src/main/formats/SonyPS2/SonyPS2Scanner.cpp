@@ -24,20 +24,21 @@ void SonyPS2Scanner::scan(RawFile *file, void *info) {
 }
 
 void SonyPS2Scanner::searchForSeq(RawFile *file) {
-  size_t nFileLength = file->size();
-  for (u32 i = 0; i + 0x40 < nFileLength; i++) {
-    u32 sig1 = file->readWord(i);
-    u32 sig2 = file->readWord(i + 4);
-    if (sig1 != 0x53434549 || sig2 != 0x56657273)  // "SCEIVers" in ASCII
+  const ByteView view = file->view();
+  for (u32 i : file->magicIndex().offsets("IECS")) {
+    if (i + 0x40 >= view.size())
+      break;
+    // the index only yields offsets that start with "SCEI"
+    if (view.load<u32>(i + 4) != 0x56657273)  // "SCEIVers" in ASCII
       continue;
 
-    sig1 = file->readWord(i + 0x10);
-    sig2 = file->readWord(i + 0x14);
+    auto sig1 = view.readWord(i + 0x10);
+    auto sig2 = view.readWord(i + 0x14);
     if (sig1 != 0x53434549 || sig2 != 0x53657175)  // "SCEISequ" in ASCII
       continue;
 
-    sig1 = file->readWord(i + 0x30);
-    sig2 = file->readWord(i + 0x34);
+    sig1 = view.readWord(i + 0x30);
+    sig2 = view.readWord(i + 0x34);
     if (sig1 != 0x53434549 || sig2 != 0x4D696469)  // "SCEIMidi" in ASCII
       continue;
 
@@ -46,20 +47,21 @@ void SonyPS2Scanner::searchForSeq(RawFile *file) {
 }
 
 void SonyPS2Scanner::searchForInstrSet(RawFile *file) {
-  size_t nFileLength = file->size();
-  for (u32 i = 0; i + 0x40 < nFileLength; i++) {
-    u32 sig1 = file->readWord(i);
-    u32 sig2 = file->readWord(i + 4);
-    if (sig1 != 0x53434549 || sig2 != 0x56657273)  // "SCEIVers" in ASCII
+  const ByteView view = file->view();
+  for (u32 i : file->magicIndex().offsets("IECS")) {
+    if (i + 0x40 >= view.size())
+      break;
+    // the index only yields offsets that start with "SCEI"
+    if (view.load<u32>(i + 4) != 0x56657273)  // "SCEIVers" in ASCII
       continue;
 
-    sig1 = file->readWord(i + 0x10);
-    sig2 = file->readWord(i + 0x14);
+    auto sig1 = view.readWord(i + 0x10);
+    auto sig2 = view.readWord(i + 0x14);
     if (sig1 != 0x53434549 || sig2 != 0x48656164)  // "SCEIHead" in ASCII
       continue;
 
-    sig1 = file->readWord(i + 0x50);
-    sig2 = file->readWord(i + 0x54);
+    sig1 = view.readWord(i + 0x50);
+    sig2 = view.readWord(i + 0x54);
     if (sig1 != 0x53434549 || sig2 != 0x56616769)  // "SCEIVagi" in ASCII
       continue;
 
@@ -81,7 +83,7 @@ void SonyPS2Scanner::searchForSampColl(RawFile *file) {
       u32 newFileSize = file->size() + 16;
       std::vector<u8> newdataBuf(newFileSize);
       file->readBytes(0, file->size(), newdataBuf.data() + 16);
-      pRoot->createVirtFile(newdataBuf.data(), newFileSize, file->name(), file->path());
+      pRoot->createVirtFile(std::move(newdataBuf), file->name(), file->path());
       return;
     }
 
@@ -11,6 +11,7 @@
 #include "VGMColl.h"
 
 #include <memory>
+#include <vector>
 
 namespace vgmtrans::scanners {
 ScannerRegistration<TriAcePS1Scanner> s_triace_ps1("TriAcePS1");
@@ -24,9 +25,9 @@ void TriAcePS1Scanner::scan(RawFile *file, void *info) {
 }
 
 void TriAcePS1Scanner::searchForSLZSeq(RawFile *file) {
-  size_t nFileLength = file->size();
-  for (u32 i = 0; i + 0x40 < nFileLength; i++) {
-    u32 sig1 = file->readWordBE(i);
+  const ByteView view = file->view();
+  for (u32 i = 0; i + 0x40 < view.size(); i++) {
+    u32 sig1 = view.loadBE<u32>(i);
     u8 slzMode;
 
     slzMode = sig1 & 0xFF;
@@ -37,14 +38,14 @@ void TriAcePS1Scanner::searchForSLZSeq(RawFile *file) {
       continue;    // only SLZ v0-3 is supported
     // Note: SLZ v2 is used by a few tracks in Valkyrie Profile.
 
-    u16 headerBytes = file->readShort(i + 0x11);
+    u16 headerBytes = view.load<u16>(i + 0x11);
 
     if (headerBytes != 0xFFFF)        //First two bytes of the sequence is always 0xFFFF
       continue;
 
-    u32 size1 = file->readWord(i + 4);     //unknown.  compressed size or something
-    u32 size2 = file->readWord(i + 8);     //uncompressed file size (size of resulting file after decompression)
-    u32 size3 = file->readWord(i + 12);    //unknown compressed file size or something
+    u32 size1 = view.load<u32>(i + 4);     //unknown.  compressed size or something
+    u32 size2 = view.load<u32>(i + 8);     //uncompressed file size (size of resulting file after decompression)
+    u32 size3 = view.load<u32>(i + 12);    //unknown compressed file size or something
 
     if (size1 > 0x30000 || size2 > 0x30000 || size3 > 0x30000)    //sanity check.  Sequences won't be > 0x30000 bytes
       continue;
@@ -128,12 +129,12 @@ TriAcePS1Seq *TriAcePS1Scanner::decompressTriAceSLZFile(RawFile *file, u32 cfOff
   if (ufSize == 0)
     ufSize = DEFAULT_UFSIZE;
 
-  u8 *uf = new u8[ufSize];
+  std::vector<u8> uf(ufSize);
 
   u32 ufOff = 0;
   cfOff += 0x10;
   if (cmode == 0) {
-    ufOff += file->readBytes(cfOff, ufSize, uf);
+    ufOff += file->readBytes(cfOff, ufSize, uf.data());
   } else {
     // The decompression code is based on CUE's SLZ decompressor.
     // compression mode: 0/STORE, 1/LZSS, 2/LZSS+RLE, 3/LZSS16
@@ -190,19 +191,16 @@ TriAcePS1Seq *TriAcePS1Scanner::decompressTriAceSLZFile(RawFile *file, u32 cfOff
   }
 
   // If we had to use DEFAULT_UFSIZE because the uncompressed file size was not given (Valkyrie Profile),
-  // then create a new buffer of the correct size now that we know it, and delete the old one.
+  // then trim the buffer to the correct size now that we know it.
+  uf.resize(ufOff);
   if (ufSize == DEFAULT_UFSIZE) {
-    u8 *newUF = new u8[ufOff];
-    memcpy(newUF, uf, ufOff);
-    delete[] uf;
-    uf = newUF;
+    uf.shrink_to_fit();
   }
-  // pRoot->UI_WriteBufferToFile("uncomp.raw", uf, ufOff);
+  // pRoot->UI_WriteBufferToFile("uncomp.raw", uf.data(), ufOff);
 
   // Create the new virtual file, and analyze the sequence
   std::string name = file->tag.hasTitle() ? file->tag.title : file->stem();
-  auto newVirtFile = std::make_unique<VirtFile>(uf, ufOff, fmt::format("{} Sequence", name), file->path());
-  delete[] uf;
+  auto newVirtFile = std::make_unique<VirtFile>(std::move(uf), fmt::format("{} Sequence", name), file->path());
 
   auto* rawVirtFile = newVirtFile.get();
   rawVirtFile->setUseLoaders(false);
@@ -7,13 +7,20 @@
 #include "base/Types.h"
 #include "formats/PS1/PS1Format.h"
 #include "Root.h"
+#include "util/Parallel.h"
+#include "util/Simd.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 
 using namespace std;
 
 
+static bool isValidSampleStart(const u8* data, size_t size, u32 offset, bool allowShort);
 static bool isValidSampleStart(const RawFile* file, u32 offset, bool allowShort);
+static bool isZero16(const u8* data, size_t size, u32 ofs);
 static bool isZero16(const RawFile* f, u32 ofs);
 static bool isValidFilterShiftByte(u8 b);
 static bool isValidFlagByte(u8 b);
@@ -215,16 +222,18 @@ constexpr int MAX_RANGE_FILTER_DIFF_SUM = NUM_CHUNKS_READAHEAD * 3.2;
 constexpr int MIN_UNIQUE_BYTES_STRICT   = NUM_CHUNKS_READAHEAD * 4;
 constexpr int MAX_BYTE_REPETITION       = NUM_CHUNKS_READAHEAD * 5.5;
 constexpr u32 BACK_SCAN_LIMIT           = 0x5000;
+constexpr size_t CANDIDATE_SCAN_CHUNK   = 0x100000;
 
 /// Check for a sequence of 16 null bytes - an empty ADPCM frame
+static inline bool isZero16(const u8* data, size_t size, u32 ofs) {
+  if (ofs > size || size - ofs < 16) return false;
+  u64 halves[2];
+  memcpy(halves, data + ofs, 16);
+  return (halves[0] | halves[1]) == 0;
+}
+
 static inline bool isZero16(const RawFile* f, u32 ofs) {
-  if (ofs > f->size() || f->size() - ofs < 16) return false;
-  for (u32 i = 0; i < 16; i++) {
-    if (f->readByte(ofs + i) != 0) {
-      return false;
-    }
-  }
-  return true;
+  return isZero16(reinterpret_cast<const u8*>(f->data()), f->size(), ofs);
 }
 
 static inline bool isValidFilterShiftByte(u8 b) {
@@ -241,14 +250,13 @@ static inline bool isValidFlagByte(u8 b) {
 /// Determine whether the offset is the start of a PSX ADPCM sample.
 /// when allowShort is false, the algorithm is stricter and reads 10 frames of data (forward pass)
 /// when allowShort is true, the algorithm is less strict and allows samples of any size (back scan)
-static bool isValidSampleStart(const RawFile* file, u32 offset, bool allowShort) {
-  if (!isZero16(file, offset)) return false;
+static bool isValidSampleStart(const u8* data, size_t size, u32 offset, bool allowShort) {
+  if (!isZero16(data, size, offset)) return false;
 
   const u32 first = offset + 16;
-  if (!file->isValidOffset(first + 15)) return false;
-  if (file->readShort(first) == 0)      return false;
+  if (static_cast<size_t>(first) + 15 >= size) return false;
+  if (data[first] == 0 && data[first + 1] == 0) return false;
 
-  u8  chunk[16];
   int byteCount[256]     = {};
   int uniqueBytes        = 0;
   int sumFilterDiff      = 0;
@@ -259,16 +267,18 @@ static bool isValidSampleStart(const RawFile* file, u32 offset, bool allowShort)
 
   for (u32 j = 0; j < NUM_CHUNKS_READAHEAD; ++j) {
     const u32 cur = first + j * 16;
-    file->readBytes(cur, 16, &chunk);
-
-    if (isZero16(file, cur)) {
+    if (isZero16(data, size, cur)) {
       if (!allowShort)          // disallow any null frames in the readahead range in strict mode
         ok = false;
       if (cur == offset + 16)   // always disallow two consecutive 16 null frames
         ok = false;
       break;
     }
+    // the readahead stops at the end of the file
+    if (static_cast<size_t>(cur) + 16 > size)
+      break;
     ++framesSeen;
+    const u8* chunk = data + cur;
 
     // check flag byte and filter/shift byte validity
     const u8 filterShift = chunk[0];
@@ -334,50 +344,95 @@ static bool isValidSampleStart(const RawFile* file, u32 offset, bool allowShort)
   return true;
 }
 
-std::vector<PSXSampColl*> PSXSampColl::searchForPSXADPCMs(RawFile* file, const std::string& format) {
-  std::vector<PSXSampColl*> sampColls;
-  const size_t len = file->size();
+static bool isValidSampleStart(const RawFile* file, u32 offset, bool allowShort) {
+  return isValidSampleStart(reinterpret_cast<const u8*>(file->data()), file->size(), offset,
+                            allowShort);
+}
+
+struct ADPCMCandidate {
+  u32 offset;  // silent frame that passed strict validation in the forward pass
+  u32 start;   // offset extended backward over any shorter samples preceding it
+};
+
+/// Back scan from a validated sample start to check for shorter samples we might have skipped
+static u32 backScanSampleStart(const u8* data, size_t size, u32 i) {
+  u32 start   = i;
+  u32 scanned = 16;
+  while (scanned < BACK_SCAN_LIMIT && i >= scanned + 16)
+  {
+    const u32 offset = i - scanned;
+    scanned += 16;
+
+    // Look for a 16 null byte frame which usually prefixes a sample
+    if (!isZero16(data, size, offset)) {
+      // Make sure the data we scan past is still potentially valid frames
+      if (!isValidFilterShiftByte(data[offset]) || !isValidFlagByte(data[offset + 1])) {
+        break;
+      }
+      continue;
+    }
+
+    if (!isValidSampleStart(data, size, offset, true))
+      break;
 
-  for (u32 i = 0; i + 16 + NUM_CHUNKS_READAHEAD * 16 < len; ++i)
+    start = offset; // extend the start of the sample collection backward
+  }
+  return start;
+}
+
+/// Forward pass over the offsets [begin, end). Validation reads whatever data it needs on either
+/// side of the range, so a sample straddling the range boundaries is found all the same.
+static void findSampleCandidates(const u8* data, size_t size, u32 begin, u32 end,
+                                 std::vector<ADPCMCandidate>& candidates) {
+  for (u32 i = begin; i < end; ++i)
   {
     // Look for a 16-byte silent frame which usually indicates the start of a sample
-    if (!isZero16(file, i))
+    if (!isZero16(data, size, i))
     {
-      u8 buf[16]; file->readBytes(i, 16, &buf);
-      int nz = 15; while (nz && buf[nz] == 0) --nz;
+      // no silent frame can begin before the last non-zero byte of this one
+      int nz = 15; while (nz && data[i + nz] == 0) --nz;
       i += nz;
       continue;
     }
 
     // Use strict validation for the forward pass (10 frame readahead)
-    if (!isValidSampleStart(file, i, false))
+    if (!isValidSampleStart(data, size, i, false))
       continue;
 
-    // We found a valid sample. Now back scan to check for shorter samples we might have skipped
-    u32 origOffset = i;
-    u32 start   = i;
-    u32 scanned = 16;
-    while (scanned < BACK_SCAN_LIMIT && i >= scanned + 16)
-    {
-      const u32 offset = i - scanned;
-      scanned += 16;
-
-      // Look for a 16 null byte frame which usually prefixes a sample
-      if (!isZero16(file, offset)) {
-        // Make sure the data we scan past is still potentially valid frames
-        u8 filterShiftByte = file->readByte(offset);
-        u8 flagByte = file->readByte(offset + 1);
-        if (!isValidFilterShiftByte(filterShiftByte) || !isValidFlagByte(flagByte)) {
-          break;
-        }
-        continue;
-      }
+    candidates.push_back({i, backScanSampleStart(data, size, i)});
+  }
+}
 
-      if (!isValidSampleStart(file, offset, true))
-        break;
+std::vector<PSXSampColl*> PSXSampColl::searchForPSXADPCMs(RawFile* file, const std::string& format) {
+  std::vector<PSXSampColl*> sampColls;
+  const auto* data = reinterpret_cast<const u8*>(file->data());
+  const size_t len = file->size();
+  constexpr size_t READAHEAD_LENGTH = 16 + NUM_CHUNKS_READAHEAD * 16;
+  if (len <= READAHEAD_LENGTH)
+    return sampColls;
+  const auto scanEnd = static_cast<u32>(std::min<size_t>(len - READAHEAD_LENGTH, UINT32_MAX));
+
+  // Candidate detection only reads the file, so it is split over the scan threads by chunks of
+  // offsets. When this scan already runs on a scan worker, the chunks are searched serially.
+  const size_t chunkCount = (scanEnd + CANDIDATE_SCAN_CHUNK - 1) / CANDIDATE_SCAN_CHUNK;
+  std::vector<std::vector<ADPCMCandidate>> chunkCandidates(chunkCount);
+  vgmtrans::parallelFor(chunkCount, pRoot->scanThreadCount(), [&](size_t c) {
+    const u32 begin = static_cast<u32>(c * CANDIDATE_SCAN_CHUNK);
+    const u32 end = static_cast<u32>(std::min<size_t>(begin + CANDIDATE_SCAN_CHUNK, scanEnd));
+    findSampleCandidates(data, len, begin, end, chunkCandidates[c]);
+  });
+
+  std::vector<ADPCMCandidate> candidates;
+  for (auto& chunk : chunkCandidates) {
+    candidates.insert(candidates.end(), chunk.begin(), chunk.end());
+  }
 
-      start = offset; // extend the start of the sample collection backward
-    }
+  // Load serially in file order, skipping candidates inside an already loaded collection
+  u32 nextOffset = 0;
+  for (const auto& [origOffset, start] : candidates) {
+    if (origOffset < nextOffset)
+      continue;
+    nextOffset = origOffset + 1;
 
     auto coll = std::make_unique<PSXSampColl>(format, file, start);
     auto* rawColl = coll.get();
@@ -389,9 +444,9 @@ std::vector<PSXSampColl*> PSXSampColl::searchForPSXADPCMs(RawFile* file, const s
 
     // Sanity check that the detected sampcoll isn't smaller than the back scanned distance
     if ((start + rawColl->length() - 1) < origOffset) {
-      i = origOffset + 32;
+      nextOffset = origOffset + 33;
     } else {
-      i = start + rawColl->length() - 1;                      // skip parsed area
+      nextOffset = start + rawColl->length();                 // skip parsed area
     }
   }
   return sampColls;
@@ -416,49 +471,64 @@ double PSXSamp::compressionRatio() const {
   return ((28.0 / 16.0) * 2);
 }
 
-std::vector<u8> PSXSamp::decodeToNativePcm() {
-  const u32 sampleCount = uncompressedSize() / sizeof(s16);
-  std::vector<u8> samples(sampleCount * sizeof(s16));
-  auto *uncompBuf = reinterpret_cast<s16 *>(samples.data());
-  VAGBlk theBlock;
-  s32  prev[2] = {0, 0};
+void PSXSamp::readLoopInfo() {
+  walkBlockHeaders(false);
+}
 
+u32 PSXSamp::walkBlockHeaders(bool warn) {
   if (this->bSetLoopOnConversion)
     setLoopStatus(0); //loopStatus is initiated to -1.  We should default it now to not loop
 
+  const u8 *blocks = reinterpret_cast<const u8 *>(rawFile()->data()) + offset();
+  u32 blockCount = 0;
   bool addrOutOfVirtFile = false;
   for (u32 k = 0; k < dataLength; k += 0x10)                //for every adpcm chunk
   {
     if (offset() + k + 16 > vgmFile()->endOffset()) {
-      L_WARN("\"{}\" unexpected EOF.", name());
+      if (warn)
+        L_WARN("\"{}\" unexpected EOF.", name());
       break;
     }
     else if (!addrOutOfVirtFile && k + 16 > length()) {
-      L_WARN("\"{}\" unexpected end of PSXSamp.", name());
+      if (warn)
+        L_WARN("\"{}\" unexpected end of PSXSamp.", name());
       addrOutOfVirtFile = true;
     }
 
-    theBlock.range = readByte(offset() + k) & 0xF;
-    theBlock.filter = (readByte(offset() + k) & 0xF0) >> 4;
-    theBlock.flag.end = readByte(offset() + k + 1) & 1;
-    theBlock.flag.looping = (readByte(offset() + k + 1) & 2) > 0;
-
     //this can be the loop point, but in wd, this info is stored in the instrset
-    theBlock.flag.loop = (readByte(offset() + k + 1) & 4) > 0;
+    const u8 flags = blocks[k + 1];
     if (this->bSetLoopOnConversion) {
-      if (theBlock.flag.loop) {
+      if (flags & 4) {
         this->setLoopOffset(k);
         this->setLoopLength(dataLength - k);
       }
-      if (theBlock.flag.end && theBlock.flag.looping) {
+      if ((flags & 1) && (flags & 2)) {
         setLoopStatus(1);
       }
     }
+    blockCount++;
+  }
+  return blockCount;
+}
 
-    rawFile()->readBytes(offset() + k + 2, 14, theBlock.brr);
+std::vector<u8> PSXSamp::decodeToNativePcm() {
+  const u32 sampleCount = uncompressedSize() / sizeof(s16);
+  std::vector<u8> samples(sampleCount * sizeof(s16));
+  auto *uncompBuf = reinterpret_cast<s16 *>(samples.data());
+  s32  prev[2] = {0, 0};
 
-    //each decompressed pcm block is 56 bytes (28 samples, 16-bit each)
-    decompVAGBlk(uncompBuf + ((k / 16) * 28), &theBlock, prev);
+  const u8 *blocks = reinterpret_cast<const u8 *>(rawFile()->data()) + offset();
+  const u32 blockCount = walkBlockHeaders(true);
+
+  // The buffer is sized from the data length, which needn't be a whole number of blocks;
+  // a trailing block that only partly fits is decoded aside and truncated
+  const u32 wholeBlocks = std::min<u32>(blockCount, sampleCount / VAG_BLOCK_SAMPLES);
+  decodeVAGBlocks(blocks, wholeBlocks, uncompBuf, prev);
+  if (wholeBlocks < blockCount) {
+    s16 tail[VAG_BLOCK_SAMPLES];
+    decodeVAGBlocks(blocks + wholeBlocks * VAG_BLOCK_SIZE, 1, tail, prev);
+    std::copy_n(tail, sampleCount - wholeBlocks * VAG_BLOCK_SAMPLES,
+                uncompBuf + wholeBlocks * VAG_BLOCK_SAMPLES);
   }
 
   return samples;
@@ -486,40 +556,68 @@ u32 PSXSamp::getSampleLength(const RawFile *file, u32 offset, u32 endOffset, boo
   }
 }
 
-inline void PSXSamp::decompVAGBlk(s16* pSmp, const VAGBlk* pVBlk, s32 prev[2]) {
-  static constexpr s16 COEF[5][2] = {
+// Expands the 28 nibbles of a VAG block (low nibble first) into (nibble << 12) >> shift.
+// out must have room for 32 samples; the last 4 are scratch.
+static inline void unpackVAGNibbles(const u8 *block, int shift, s16 *out) {
+#if VGMTRANS_SSE2
+  // Move each nibble into the top of a 16-bit lane so the arithmetic shift sign-extends it
+  const __m128i bytes = _mm_srli_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block)), 2);
+  const __m128i mask = _mm_set1_epi8(static_cast<char>(0xF0));
+  const __m128i lo = _mm_and_si128(_mm_slli_epi16(bytes, 4), mask);
+  const __m128i hi = _mm_and_si128(bytes, mask);
+  const __m128i first = _mm_unpacklo_epi8(lo, hi);
+  const __m128i second = _mm_unpackhi_epi8(lo, hi);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i count = _mm_cvtsi32_si128(shift);
+
+  auto *dst = reinterpret_cast<__m128i *>(out);
+  _mm_storeu_si128(dst, _mm_sra_epi16(_mm_unpacklo_epi8(zero, first), count));
+  _mm_storeu_si128(dst + 1, _mm_sra_epi16(_mm_unpackhi_epi8(zero, first), count));
+  _mm_storeu_si128(dst + 2, _mm_sra_epi16(_mm_unpacklo_epi8(zero, second), count));
+  _mm_storeu_si128(dst + 3, _mm_sra_epi16(_mm_unpackhi_epi8(zero, second), count));
+#else
+  const u8 *brr = block + 2;
+  for (int i = 0; i < 28; ++i) {
+    const u8 byte = brr[i >> 1];
+    const s32 sn = static_cast<s8>((i & 1) ? (byte & 0xF0) : (byte << 4)) >> 4;
+    out[i] = static_cast<s16>((sn << 12) >> shift);
+  }
+#endif
+}
+
+void PSXSamp::decodeVAGBlocks(const u8 *blocks, size_t blockCount, s16 *out, s32 prev[2]) {
+  static constexpr s32 COEF[5][2] = {
     {   0,   0 }, {  60,   0 },
     { 115, -52 }, {  98, -55 },
     { 122, -60 }
   };
 
-  const u8 shift  = pVBlk->range & 0x0F;          // 0–12
-  const u8 filt   = std::min<u8>(pVBlk->filter, 4);
-
-  const s16 c0 = COEF[filt][0];
-  const s16 c1 = COEF[filt][1];
-
   s32 s1 = prev[0];
   s32 s2 = prev[1];
+  s16 residual[32];
 
-  // iterate over every nibble sample in the 14 bytes of compressed samples
-  for (int i = 0; i < 28; ++i) {
-    // fetch 4-bit nibble and sign-extend to 8 bits
-    const u8 byte   = static_cast<u8>(pVBlk->brr[i >> 1]);
-    const s8 nibble = (i & 1) ? (byte >> 4) : (byte & 0x0F);
-    const s8 sn     = static_cast<s8>(nibble << 4) >> 4;
+  for (size_t b = 0; b < blockCount; ++b) {
+    const u8 *block = blocks + b * VAG_BLOCK_SIZE;
+    const int shift = block[0] & 0x0F;          // 0–12
+    const int filt = std::min(block[0] >> 4, 4);
+    const s32 c0 = COEF[filt][0];
+    const s32 c1 = COEF[filt][1];
 
-    // core formula: ((sn << 12) >> shift) + predictor
-    s32 sample      = (static_cast<s32>(sn) << 12) >> shift;
-    sample         += ((c0 * s1 + c1 * s2) >> 6);
+    unpackVAGNibbles(block, shift, residual);
 
-    // saturate to signed 16-bit
-    sample = std::clamp(sample, -0x8000, 0x7FFF);
+    // the prediction depends on the previous outputs, so the filter stays scalar
+    s16 *pSmp = out + b * VAG_BLOCK_SAMPLES;
+    for (size_t i = 0; i < VAG_BLOCK_SAMPLES; ++i) {
+      s32 sample = residual[i] + ((c0 * s1 + c1 * s2) >> 6);
 
-    pSmp[i] = static_cast<s16>(sample);
+      // saturate to signed 16-bit
+      sample = std::clamp(sample, -0x8000, 0x7FFF);
 
-    s2 = s1;
-    s1 = sample;
+      pSmp[i] = static_cast<s16>(sample);
+
+      s2 = s1;
+      s1 = sample;
+    }
   }
 
   prev[0] = s1;
@@ -357,9 +357,19 @@ class PSXSamp : public VGMSamp {
 
   static u32 getSampleLength(const RawFile *file, u32 offset, u32 endOffset, bool &loop);
 
+  static constexpr u32 VAG_BLOCK_SIZE = 16;
+  static constexpr u32 VAG_BLOCK_SAMPLES = 28;
+
+  // Decodes blockCount contiguous 16-byte ADPCM blocks into 28 samples each. prev carries the
+  // filter history in and out, so a sample can be decoded across several calls.
+  static void decodeVAGBlocks(const u8 *blocks, size_t blockCount, s16 *out, s32 prev[2]);
+
+  void readLoopInfo() override;
+
  private:
   std::vector<u8> decodeToNativePcm() override;
-  static void decompVAGBlk(s16 *pSmp, const VAGBlk* pVBlk, s32 prev[2]);
+  // Walks the block headers, picking up the loop flags. Returns the number of decodable blocks.
+  u32 walkBlockHeaders(bool warn);
 
  public:
   bool bSetLoopOnConversion{false};
@@ -10,6 +10,7 @@
 #include "base/Types.h"
 #include "LogManager.h"
 #include "VGMInstrSet.h"
+#include "util/Simd.h"
 
 // *************
 // SNES Envelope
@@ -427,40 +428,31 @@ double SNESSamp::compressionRatio() const {
   return ((16.0 / 9.0) * 2); //aka 3.55...;
 }
 
-std::vector<u8> SNESSamp::decodeToNativePcm() {
-  const u32 sampleCount = uncompressedSize() / sizeof(s16);
-  std::vector<u8> samples(sampleCount * sizeof(s16));
-  auto *output = reinterpret_cast<s16*>(samples.data());
-
-  BRRBlk theBlock;
-  s32 prev1 = 0;
-  s32 prev2 = 0;
+void SNESSamp::readLoopInfo() {
+  walkBlockHeaders(false);
+}
 
+u32 SNESSamp::walkBlockHeaders(bool warn) {
   // loopStatus is initiated to -1.  We should default it now to not loop
   setLoopStatus(0);
 
+  const u8 *blocks = reinterpret_cast<const u8 *>(rawFile()->data()) + offset();
+  u32 blockCount = 0;
+
   assert(dataLength % 9 == 0);
   for (u32 k = 0; k + 9 <= dataLength; k += 9)  //for every adpcm chunk
   {
     if (offset() + k + 9 > rawFile()->size()) {
-      L_WARN("Unexpected EOF ({})", (name()));
+      if (warn)
+        L_WARN("Unexpected EOF ({})", (name()));
       break;
     }
 
-    theBlock.flag.range = (readByte(offset() + k) & 0xf0) >> 4;
-    theBlock.flag.filter = (readByte(offset() + k) & 0x0c) >> 2;
-    theBlock.flag.end = (readByte(offset() + k) & 0x01) != 0;
-    theBlock.flag.loop = (readByte(offset() + k) & 0x02) != 0;
+    blockCount++;
 
-    rawFile()->readBytes(offset() + k + 1, 8, theBlock.brr);
-    const size_t blockIndex = k / 9;
-    decompBRRBlk(output + blockIndex * 16,
-                 &theBlock,
-                 &prev1,
-                 &prev2);    //each decompressed pcm block is 32 bytes
-
-    if (theBlock.flag.end) {
-      if (theBlock.flag.loop) {
+    const u8 header = blocks[k];
+    if (header & 0x01) {  // end
+      if (header & 0x02) {  // loop
         if (brrLoopOffset <= offset() + k) {
           setLoopOffset(brrLoopOffset - offset());
           setLoopLength((k + 9) - (brrLoopOffset - offset()));
@@ -470,6 +462,22 @@ std::vector<u8> SNESSamp::decodeToNativePcm() {
       break;
     }
   }
+  return blockCount;
+}
+
+std::vector<u8> SNESSamp::decodeToNativePcm() {
+  const u32 sampleCount = uncompressedSize() / sizeof(s16);
+  std::vector<u8> samples(sampleCount * sizeof(s16));
+  auto *output = reinterpret_cast<s16*>(samples.data());
+
+  s32 prev1 = 0;
+  s32 prev2 = 0;
+
+  // Walk the block headers up to the end block, then decode the whole run in one go
+  const u8 *blocks = reinterpret_cast<const u8 *>(rawFile()->data()) + offset();
+  const u32 blockCount = walkBlockHeaders(true);
+
+  decodeBRRBlocks(blocks, blockCount, output, &prev1, &prev2);
 
   return samples;
 }
@@ -494,47 +502,94 @@ static inline s32 sclamp16(s32 x) {
   return ((x > 32767) ? 32767 : (x < -32768) ? -32768 : x);
 }
 
-void SNESSamp::decompBRRBlk(s16 *pSmp, const BRRBlk *pVBlk, s32 *prev1, s32 *prev2) {
-  bool validHeader = (pVBlk->flag.range < 0xD);
-
-  s32 S1 = *prev1;
-  s32 S2 = *prev2;
+// Expands the 16 nibbles of a BRR block (high nibble first) into the range-scaled values fed
+// to the filter
+static inline void unpackBRRNibbles(const u8 *block, s16 *out) {
+  const u8 range = block[0] >> 4;
+  const bool validHeader = (range < 0xD);
+
+#if VGMTRANS_SSE2
+  // Move each nibble into the top of a 16-bit lane so the arithmetic shift sign-extends it:
+  // ((n << range) >> 1) == (n << 12) >> (13 - range)
+  const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(block + 1));
+  const __m128i mask = _mm_set1_epi8(static_cast<char>(0xF0));
+  const __m128i hi = _mm_and_si128(bytes, mask);
+  const __m128i lo = _mm_and_si128(_mm_slli_epi16(bytes, 4), mask);
+  const __m128i nibbles = _mm_unpacklo_epi8(hi, lo);
+  const __m128i zero = _mm_setzero_si128();
+  __m128i first = _mm_unpacklo_epi8(zero, nibbles);
+  __m128i second = _mm_unpackhi_epi8(zero, nibbles);
+
+  if (validHeader) {
+    const __m128i count = _mm_cvtsi32_si128(13 - range);
+    first = _mm_sra_epi16(first, count);
+    second = _mm_sra_epi16(second, count);
+  } else {
+    // out of range shifts leave only the sign: n & ~0x7FF
+    const __m128i signMask = _mm_set1_epi16(static_cast<short>(0xF800));
+    first = _mm_and_si128(_mm_srai_epi16(first, 15), signMask);
+    second = _mm_and_si128(_mm_srai_epi16(second, 15), signMask);
+  }
 
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), first);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8), second);
+#else
   for (int i = 0; i < 8; i++) {
-    s8 sample1 = pVBlk->brr[i];
+    s8 sample1 = static_cast<s8>(block[1 + i]);
     s8 sample2 = sample1 << 4;
     sample1 >>= 4;
     sample2 >>= 4;
 
     for (int nybble = 0; nybble < 2; nybble++) {
-      s32 out = nybble ? sample2 : sample1;
-      out = validHeader ? ((out << pVBlk->flag.range) >> 1) : (out & ~0x7FF);
+      s32 value = nybble ? sample2 : sample1;
+      value = validHeader ? ((value << range) >> 1) : (value & ~0x7FF);
+      out[i * 2 + nybble] = static_cast<s16>(value);
+    }
+  }
+#endif
+}
+
+void SNESSamp::decodeBRRBlocks(const u8 *blocks, size_t blockCount, s16 *out, s32 *prev1, s32 *prev2) {
+  s32 S1 = *prev1;
+  s32 S2 = *prev2;
+  s16 residual[16];
+
+  for (size_t b = 0; b < blockCount; b++) {
+    const u8 *block = blocks + b * BRR_BLOCK_SIZE;
+    const u8 filter = (block[0] & 0x0c) >> 2;
+    s16 *pSmp = out + b * BRR_BLOCK_SAMPLES;
+
+    unpackBRRNibbles(block, residual);
+
+    // the prediction depends on the previous outputs, so the filter stays scalar
+    for (u32 i = 0; i < BRR_BLOCK_SAMPLES; i++) {
+      s32 sample = residual[i];
 
-      switch (pVBlk->flag.filter) {
+      switch (filter) {
         case 0: // Direct
           break;
 
         case 1: // 15/16
-          out += S1 + ((-S1) >> 4);
+          sample += S1 + ((-S1) >> 4);
           break;
 
         case 2: // 61/32 - 15/16
-          out += (S1 << 1) + ((-((S1 << 1) + S1)) >> 5) - S2 + (S2 >> 4);
+          sample += (S1 << 1) + ((-((S1 << 1) + S1)) >> 5) - S2 + (S2 >> 4);
           break;
 
         case 3: // 115/64 - 13/16
-          out += (S1 << 1) + ((-(S1 + (S1 << 2) + (S1 << 3))) >> 6) - S2 + (((S2 << 1) + S2) >> 4);
+          sample += (S1 << 1) + ((-(S1 + (S1 << 2) + (S1 << 3))) >> 6) - S2 + (((S2 << 1) + S2) >> 4);
           break;
         default:
           break;
       }
 
-      out = sclip15(sclamp16(out));
+      sample = sclip15(sclamp16(sample));
 
       S2 = S1;
-      S1 = out;
+      S1 = sample;
 
-      pSmp[i * 2 + nybble] = out << 1;
+      pSmp[i] = sample << 1;
     }
   }
 
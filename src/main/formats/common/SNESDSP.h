@@ -140,9 +140,20 @@ class SNESSamp
 
   double compressionRatio() const override;
 
+  static constexpr u32 BRR_BLOCK_SIZE = 9;
+  static constexpr u32 BRR_BLOCK_SAMPLES = 16;
+
+  // Decodes blockCount contiguous 9-byte BRR blocks into 16 samples each. prev1/prev2 carry the
+  // filter history in and out, so a sample can be decoded across several calls.
+  static void decodeBRRBlocks(const u8 *blocks, size_t blockCount, s16 *out, s32 *prev1, s32 *prev2);
+
+  void readLoopInfo() override;
+
  private:
   std::vector<u8> decodeToNativePcm() override;
-  static void decompBRRBlk(s16 *pSmp, const BRRBlk *pVBlk, s32 *prev1, s32 *prev2);
+  // Walks the block headers up to the end block, picking up the loop flags. Returns the number
+  // of blocks to decode.
+  u32 walkBlockHeaders(bool warn);
 
  private:
   u32 brrLoopOffset;
@@ -10,9 +10,26 @@
 #include "components/VGMFile.h"
 #include "LogManager.h"
 #include "util/BytePattern.h"
+#include "util/BytePatternSet.h"
+
+#include <cerrno>
+#include <random>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 /* RawFile */
 
+RawFile::~RawFile() {
+    assert(m_liveVGMFiles == 0 && "VGMFiles must be destroyed before the RawFile they read from");
+}
+
 void RawFile::addContainedVGMFile(VGMFileVariant vgmfile) {
     m_vgmfiles.emplace_back(vgmfile);
 }
@@ -44,22 +61,34 @@ bool RawFile::searchBytePattern(const BytePattern &pattern, u32 &nMatchOffset,
     if (nSearchOffset >= size())
         return false;
 
-    if ((nSearchOffset + nSearchSize) > size())
-        nSearchSize = size() - nSearchOffset;
+    if (nSearchSize > size() - nSearchOffset)
+        nSearchSize = static_cast<u32>(size() - nSearchOffset);
 
     if (nSearchSize < pattern.length())
         return false;
 
-    for (size_t offset = nSearchOffset; offset < nSearchOffset + nSearchSize - pattern.length();
-         offset++) {
-        if (matchBytePattern(pattern, offset)) {
-            nMatchOffset = offset;
-            return true;
-        }
-    }
-    return false;
+    // A match may not end on the last byte of the searched range
+    size_t matchOffset;
+    if (!pattern.search(data(), size_t{nSearchOffset} + nSearchSize - 1, matchOffset, nSearchOffset))
+        return false;
+    nMatchOffset = static_cast<u32>(matchOffset);
+    return true;
 }
 
+BytePatternMatches RawFile::searchBytePatterns(const BytePatternSet &patterns) const {
+    // searchBytePattern() never reports a match ending on the last byte of the file;
+    // leave that byte out so both searches agree
+    return BytePatternMatches(patterns, data(), size() > 0 ? size() - 1 : 0);
+}
+
+const MagicIndex &RawFile::magicIndex() const {
+    std::call_once(m_magicIndexOnce, [this] {
+        m_magicIndex = std::make_unique<const MagicIndex>(reinterpret_cast<const u8 *>(data()), size());
+    });
+    return *m_magicIndex;
+}
+
+
 std::string RawFile::readNullTerminatedString(size_t offset, size_t maxLength) const {
   const char* stringPtr = data() + offset;
   size_t length = strnlen(stringPtr, maxLength);
@@ -68,24 +97,208 @@ std::string RawFile::readNullTerminatedString(size_t offset, size_t maxLength) c
 
 /* DiskFile */
 
-DiskFile::DiskFile(const std::filesystem::path& path) : m_data(mio::mmap_source(path.c_str())), m_path(path) {}
+DiskFile::DiskFile(const std::filesystem::path& path)
+    : m_data(std::make_shared<const mio::mmap_source>(path.c_str())), m_path(path) {}
 
 /* VirtFile */
 
-VirtFile::VirtFile(const RawFile &file, size_t offset) : m_name(file.name()), m_lpath(file.path()) {
-    std::copy(file.begin() + offset, file.end(), std::back_inserter(m_data));
+VirtFile::VirtFile(const RawFile &file, size_t offset) : DerivedFile(file.name(), file.path()) {
+    share(file, offset, file.size() - offset);
 }
 
 VirtFile::VirtFile(const RawFile &file, size_t offset, size_t limit)
-    : m_name(file.name()), m_lpath(file.path()) {
-    std::copy_n(file.data() + offset, limit, std::back_inserter(m_data));
+    : DerivedFile(file.name(), file.path()) {
+    share(file, offset, limit);
+}
+
+VirtFile::VirtFile(const RawFile &parent, size_t offset, size_t limit, std::string name,
+                   std::filesystem::path parent_fullpath, const VGMTag& tag)
+    : DerivedFile(std::move(name), std::move(parent_fullpath)) {
+  this->tag = tag;
+  share(parent, offset, limit);
 }
 
 VirtFile::VirtFile(const u8 *data, u32 fileSize, std::string name,
                    std::filesystem::path parent_fullpath, const VGMTag& tag,
                    std::shared_ptr<const VGMMetadataHintProvider> metadataHintProvider)
-    : m_name(std::move(name)), m_lpath(std::move(parent_fullpath)) {
-  std::copy_n(data, fileSize, std::back_inserter(m_data));
+    : DerivedFile(std::move(name), std::move(parent_fullpath)) {
+  adopt(std::vector<u8>(data, data + fileSize));
   this->tag = tag;
   setMetadataHintProvider(std::move(metadataHintProvider));
 }
+
+VirtFile::VirtFile(std::vector<u8> &&data, std::string name, std::filesystem::path parent_fullpath,
+                   const VGMTag& tag,
+                   std::shared_ptr<const VGMMetadataHintProvider> metadataHintProvider)
+    : DerivedFile(std::move(name), std::move(parent_fullpath)) {
+  adopt(std::move(data));
+  this->tag = tag;
+  setMetadataHintProvider(std::move(metadataHintProvider));
+}
+
+void VirtFile::adopt(std::vector<u8> &&buffer) {
+  auto storage = std::make_shared<const std::vector<u8>>(std::move(buffer));
+  m_data = storage->data();
+  m_size = storage->size();
+  m_storage = std::move(storage);
+}
+
+void VirtFile::share(const RawFile &parent, size_t offset, size_t limit) {
+  assert(offset <= parent.size() && limit <= parent.size() - offset);
+  const u8 *begin = reinterpret_cast<const u8 *>(parent.data()) + offset;
+  if (auto storage = parent.sharedStorage()) {
+    m_storage = std::move(storage);
+    m_data = begin;
+    m_size = limit;
+  } else {
+    // The parent's contents die with it, so the slice needs its own copy
+    adopt(std::vector<u8>(begin, begin + limit));
+  }
+}
+
+/* LazyFile */
+
+LazyFile::LazyFile(std::string name, size_t size, Producer producer,
+                   std::filesystem::path parent_fullpath, const VGMTag& tag)
+    : DerivedFile(std::move(name), std::move(parent_fullpath)), m_producer(std::move(producer)),
+      m_size(size) {
+  this->tag = tag;
+}
+
+const std::vector<u8> &LazyFile::contents() const {
+  std::call_once(m_loadOnce, [this] {
+    if (!m_producer || !m_producer(m_data)) {
+      L_ERROR("Failed to load the contents of {}", m_name);
+      m_data.clear();
+      m_failed = true;
+    }
+    // The declared size is what everyone has been told, so hold the contents to it
+    m_data.resize(m_size);
+    // Drop whatever the producer holds on to, such as an open archive
+    m_producer = nullptr;
+    m_loaded.store(true, std::memory_order_release);
+  });
+  return m_data;
+}
+
+bool LazyFile::load() const {
+  contents();
+  return !m_failed;
+}
+
+/* ScratchFile */
+
+namespace {
+
+// Creates a file at path that must not exist yet, accessible by the current user only, and opens
+// it for writing. Sets taken when the name is already in use so the caller can pick another one
+std::FILE *createExclusive(const std::filesystem::path &path, bool &taken) {
+#ifdef _WIN32
+  HANDLE handle = CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_NEW,
+                              FILE_ATTRIBUTE_TEMPORARY, nullptr);
+  if (handle == INVALID_HANDLE_VALUE) {
+    const DWORD err = GetLastError();
+    taken = err == ERROR_FILE_EXISTS || err == ERROR_ALREADY_EXISTS;
+    return nullptr;
+  }
+  const int fd = _open_osfhandle(reinterpret_cast<intptr_t>(handle), _O_WRONLY | _O_BINARY);
+  if (fd == -1) {
+    CloseHandle(handle);
+    return nullptr;
+  }
+  std::FILE *file = _fdopen(fd, "wb");
+  if (!file) {
+    _close(fd);
+  }
+  return file;
+#else
+  const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+  if (fd == -1) {
+    taken = errno == EEXIST;
+    return nullptr;
+  }
+  std::FILE *file = ::fdopen(fd, "wb");
+  if (!file) {
+    ::close(fd);
+  }
+  return file;
+#endif
+}
+
+}  // namespace
+
+ScratchFile::ScratchFile(std::string name, std::filesystem::path parent_fullpath, const VGMTag& tag)
+    : DerivedFile(std::move(name), std::move(parent_fullpath)) {
+  this->tag = tag;
+
+  std::error_code ec;
+  auto dir = std::filesystem::temp_directory_path(ec);
+  if (ec) {
+    L_ERROR("No temporary directory for {}: {}", m_name, ec.message());
+    return;
+  }
+
+  // The temporary directory is shared, so the file is only ever created, never opened if it is
+  // already there: that way nothing another user placed at the name can be followed or truncated
+  constexpr int MAX_ATTEMPTS = 16;
+  std::random_device seed;
+  std::mt19937_64 rng((static_cast<u64>(seed()) << 32) | seed());
+  for (int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt) {
+    auto path = dir / fmt::format("vgmtrans-{:016x}.tmp", rng());
+    bool taken = false;
+    m_writer = createExclusive(path, taken);
+    if (m_writer) {
+      m_scratchPath = std::move(path);
+      return;
+    }
+    if (!taken) {
+      break;
+    }
+  }
+  L_ERROR("Could not create a temporary file for {}", m_name);
+}
+
+ScratchFile::~ScratchFile() {
+  if (m_writer) {
+    std::fclose(m_writer);
+  }
+  m_data.unmap();
+  if (!m_scratchPath.empty()) {
+    std::error_code ec;
+    std::filesystem::remove(m_scratchPath, ec);
+  }
+}
+
+bool ScratchFile::write(const void *data, size_t size) {
+  if (!m_writer) {
+    return false;
+  }
+  return std::fwrite(data, 1, size, m_writer) == size;
+}
+
+bool ScratchFile::finalize() {
+  if (!m_writer) {
+    return false;
+  }
+  const bool written = std::fclose(m_writer) == 0;
+  m_writer = nullptr;
+  if (!written) {
+    return false;
+  }
+
+  std::error_code ec;
+  if (std::filesystem::file_size(m_scratchPath, ec) > 0) {
+    m_data.map(m_scratchPath.c_str(), ec);
+    if (ec) {
+      L_ERROR("Could not map the temporary file for {}: {}", m_name, ec.message());
+      return false;
+    }
+  }
+
+  // The mapping keeps the contents alive, so where the OS allows it the file is unlinked right
+  // away; otherwise it is removed when this is destroyed
+  if (std::filesystem::remove(m_scratchPath, ec)) {
+    m_scratchPath.clear();
+  }
+  return true;
+}
@@ -10,12 +10,19 @@
 #include "components/VGMMetadataHint.h"
 #include "components/VGMTag.h"
 #include "Root.h"
+#include "util/ByteView.h"
+#include "util/MagicIndex.h"
 #include "util/Path.h"
 #include "util/Text.h"
 
 #include <cassert>
 #include <climits>
+#include <atomic>
 #include <filesystem>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <variant>
 #include <vector>
@@ -25,6 +32,8 @@
 class VGMFile;
 class VGMItem;
 class BytePattern;
+class BytePatternMatches;
+class BytePatternSet;
 
 class VGMSeq;
 class VGMInstrSet;
@@ -33,7 +42,7 @@ class VGMMiscFile;
 
 class RawFile {
    public:
-    virtual ~RawFile() = default;
+    virtual ~RawFile();
 
     [[nodiscard]] virtual std::string name() const = 0;
     [[nodiscard]] virtual std::filesystem::path path() const = 0;
@@ -63,25 +72,18 @@ class RawFile {
     template <typename T>
     [[nodiscard]] T get(const size_t ind) const {
         assert(ind + sizeof(T) <= size());
-
-        T value = 0;
-        for (size_t i = 0; i < sizeof(T); i++) {
-            value |= (static_cast<u8>(operator[](ind + i)) << (i * CHAR_BIT));
-        }
-
-        return value;
+        return view().load<T>(ind);
     }
 
     template <typename T>
     [[nodiscard]] T getBE(const size_t ind) const {
         assert(ind + sizeof(T) <= size());
+        return view().loadBE<T>(ind);
+    }
 
-        T value = 0u;
-        for (size_t i = 0; i < sizeof(T); i++) {
-            value |= (static_cast<u8>(operator[](ind + i)) << ((sizeof(T) - i - 1) * CHAR_BIT));
-        }
-
-        return value;
+    // Non-virtual reader over the file contents, for scanning loops
+    [[nodiscard]] ByteView view() const noexcept {
+        return {reinterpret_cast<const u8 *>(data()), size()};
     }
 
     const char *begin() const noexcept { return data(); }
@@ -93,6 +95,9 @@ class RawFile {
         return std::reverse_iterator<const char *>(begin());
     }
     virtual const char *data() const = 0;
+    // Handle that keeps data() valid independently of this file, so a slice of it can outlive
+    // it. Null if the contents can't be shared
+    [[nodiscard]] virtual std::shared_ptr<const void> sharedStorage() const { return nullptr; }
 
     virtual const char &operator[](size_t i) const = 0;
     virtual u8 readByte(size_t offset) const = 0;
@@ -107,6 +112,10 @@ class RawFile {
     bool matchBytePattern(const BytePattern &pattern, size_t offset) const;
     bool searchBytePattern(const BytePattern &pattern, u32 &nMatchOffset,
                            u32 nSearchOffset = 0, u32 nSearchSize = static_cast<u32>(-1)) const;
+    // Finds the first match of every pattern in the set with a single pass over the file
+    BytePatternMatches searchBytePatterns(const BytePatternSet &patterns) const;
+    // Offsets of the common format magic numbers, indexed on first use and shared by all scanners
+    const MagicIndex &magicIndex() const;
 
     [[nodiscard]] const auto &containedVGMFiles() const noexcept {
         return m_vgmfiles;
@@ -141,6 +150,12 @@ class RawFile {
    private:
     std::vector<VGMFileVariant> m_vgmfiles;
     std::shared_ptr<const VGMMetadataHintProvider> m_metadataHintProvider;
+    mutable std::once_flag m_magicIndexOnce;
+    mutable std::unique_ptr<const MagicIndex> m_magicIndex;
+    friend class VGMFile;
+    // VGMFiles parsed out of this file that are still alive. They read from the file until they
+    // are destroyed, so they must all be gone before it is
+    std::atomic<size_t> m_liveVGMFiles = 0;
     enum ProcessFlags { UseLoaders = 1, UseScanners = 2 };
     unsigned m_flags = UseLoaders | UseScanners;
 };
@@ -152,7 +167,7 @@ class DiskFile final : public RawFile {
 
     [[nodiscard]] std::string name() const override { return pathToUtf8String(m_path.filename()); };
     [[nodiscard]] std::filesystem::path path() const override { return m_path; };
-    [[nodiscard]] size_t size() const noexcept override { return m_data.length(); };
+    [[nodiscard]] size_t size() const noexcept override { return m_data->length(); };
     [[nodiscard]] std::string stem() const noexcept override { return pathToUtf8String(m_path.stem()); };
     [[nodiscard]] std::string extension() const override {
       auto pathExtension = pathToUtf8String(m_path.extension());
@@ -163,32 +178,27 @@ class DiskFile final : public RawFile {
       return pathExtension;
     }
 
-    const char *data() const override { return m_data.data(); }
-    const char &operator[](size_t offset) const override { return m_data[offset]; }
-    u8 readByte(size_t offset) const override { return m_data[offset]; }
+    const char *data() const override { return m_data->data(); }
+    [[nodiscard]] std::shared_ptr<const void> sharedStorage() const override { return m_data; }
+    const char &operator[](size_t offset) const override { return (*m_data)[offset]; }
+    u8 readByte(size_t offset) const override { return (*m_data)[offset]; }
     u16 readShort(size_t offset) const override { return get<u16>(offset); }
     u32 readWord(size_t offset) const override { return get<u32>(offset); }
     u16 readShortBE(size_t offset) const override { return getBE<u16>(offset); }
     u32 readWordBE(size_t offset) const override { return getBE<u32>(offset); }
 
    private:
-    mio::mmap_source m_data;
+    std::shared_ptr<const mio::mmap_source> m_data;
     std::filesystem::path m_path;
 };
 
-class VirtFile final : public RawFile {
+// Base of the files that don't exist on disk under their own name, such as archive entries and
+// generated images. They carry the name they were given and the path of the file they came from,
+// and take their stem and extension from those.
+class DerivedFile : public RawFile {
    public:
-    VirtFile() = default;
-    VirtFile(const RawFile &, size_t offset = 0);
-    VirtFile(const RawFile &, size_t offset, size_t limit);
-    VirtFile(const u8 *data, u32 size, std::string name, std::filesystem::path parent_fullpath = "",
-             const VGMTag& tag = VGMTag(),
-             std::shared_ptr<const VGMMetadataHintProvider> metadataHintProvider = nullptr);
-    ~VirtFile() override = default;
-
     [[nodiscard]] std::string name() const override { return m_name; };
     [[nodiscard]] std::filesystem::path path() const override { return m_lpath; };
-    [[nodiscard]] size_t size() const noexcept override {return m_data.size(); };
     [[nodiscard]] std::string stem() const noexcept override {
       auto pathStem = m_lpath.stem();
       if (pathStem.empty()) {
@@ -212,6 +222,108 @@ class VirtFile final : public RawFile {
       return "";
     }
 
+   protected:
+    DerivedFile() = default;
+    DerivedFile(std::string name, std::filesystem::path parent_fullpath)
+        : m_name(std::move(name)), m_lpath(std::move(parent_fullpath)) {}
+
+    std::string m_name;
+    std::filesystem::path m_lpath;
+};
+
+// A file held in memory. It either owns its buffer or is a slice of another file's contents;
+// slices share the parent's storage (see RawFile::sharedStorage) instead of copying it, and
+// stay valid after the parent is destroyed.
+class VirtFile final : public DerivedFile {
+   public:
+    VirtFile() = default;
+    VirtFile(const RawFile &, size_t offset = 0);
+    VirtFile(const RawFile &, size_t offset, size_t limit);
+    VirtFile(const RawFile &parent, size_t offset, size_t limit, std::string name,
+             std::filesystem::path parent_fullpath = "", const VGMTag& tag = VGMTag());
+    VirtFile(const u8 *data, u32 size, std::string name, std::filesystem::path parent_fullpath = "",
+             const VGMTag& tag = VGMTag(),
+             std::shared_ptr<const VGMMetadataHintProvider> metadataHintProvider = nullptr);
+    // Takes ownership of an already assembled buffer without copying it
+    VirtFile(std::vector<u8> &&data, std::string name, std::filesystem::path parent_fullpath = "",
+             const VGMTag& tag = VGMTag(),
+             std::shared_ptr<const VGMMetadataHintProvider> metadataHintProvider = nullptr);
+    ~VirtFile() override = default;
+
+    [[nodiscard]] size_t size() const noexcept override { return m_size; };
+
+    const char *data() const override { return reinterpret_cast<const char *>(m_data); }
+    [[nodiscard]] std::shared_ptr<const void> sharedStorage() const override { return m_storage; }
+    const char &operator[](size_t offset) const override { return data()[offset]; }
+    u8 readByte(size_t offset) const override { return m_data[offset]; }
+    u16 readShort(size_t offset) const override { return get<u16>(offset); }
+    u32 readWord(size_t offset) const override { return get<u32>(offset); }
+    u16 readShortBE(size_t offset) const override { return getBE<u16>(offset); }
+    u32 readWordBE(size_t offset) const override { return getBE<u32>(offset); }
+
+   private:
+    void adopt(std::vector<u8> &&buffer);
+    void share(const RawFile &parent, size_t offset, size_t limit);
+
+    std::shared_ptr<const void> m_storage;
+    const u8 *m_data = nullptr;
+    size_t m_size = 0;
+};
+
+// A file whose contents are produced on first access, e.g. by decompressing an archive entry.
+// The size is known up front, so loaders can check it without triggering the producer. If the
+// file is never read (or is discarded after a fruitless scan) the contents are never held.
+class LazyFile final : public DerivedFile {
+   public:
+    // Fills the buffer with the file contents. Returns false on failure
+    using Producer = std::function<bool(std::vector<u8> &)>;
+
+    LazyFile(std::string name, size_t size, Producer producer,
+             std::filesystem::path parent_fullpath = "", const VGMTag& tag = VGMTag());
+    ~LazyFile() override = default;
+
+    [[nodiscard]] bool isLoaded() const noexcept { return m_loaded.load(std::memory_order_acquire); }
+    // Produces the contents now if that hasn't happened yet. Returns false if the producer
+    // failed; the file then reads as zeros, so callers that can drop it should
+    bool load() const;
+
+    [[nodiscard]] size_t size() const noexcept override { return m_size; };
+
+    const char *data() const override { return reinterpret_cast<const char *>(contents().data()); }
+    const char &operator[](size_t offset) const override { return data()[offset]; }
+    u8 readByte(size_t offset) const override { return contents()[offset]; }
+    u16 readShort(size_t offset) const override { return get<u16>(offset); }
+    u32 readWord(size_t offset) const override { return get<u32>(offset); }
+    u16 readShortBE(size_t offset) const override { return getBE<u16>(offset); }
+    u32 readWordBE(size_t offset) const override { return getBE<u32>(offset); }
+
+   private:
+    const std::vector<u8> &contents() const;
+
+    mutable std::vector<u8> m_data;
+    mutable Producer m_producer;
+    mutable std::once_flag m_loadOnce;
+    mutable std::atomic<bool> m_loaded{false};
+    mutable bool m_failed = false;
+    size_t m_size;
+};
+
+// A file whose contents are produced once, streamed to a temporary file on disk and then mapped
+// into memory. Large generated images (e.g. decompressed disc images) are kept out of the heap,
+// and the OS can page them in and out as they are scanned.
+class ScratchFile final : public DerivedFile {
+   public:
+    ScratchFile(std::string name, std::filesystem::path parent_fullpath = "",
+                const VGMTag& tag = VGMTag());
+    ~ScratchFile() override;
+
+    // Appends to the contents. Only valid before finalize()
+    bool write(const void *data, size_t size);
+    // Ends writing and maps the contents; data() and the readers are only valid afterwards
+    bool finalize();
+
+    [[nodiscard]] size_t size() const noexcept override { return m_data.size(); };
+
     const char *data() const override { return m_data.data(); }
     const char &operator[](size_t offset) const override { return m_data[offset]; }
     u8 readByte(size_t offset) const override { return m_data[offset]; }
@@ -221,7 +333,7 @@ class VirtFile final : public RawFile {
     u32 readWordBE(size_t offset) const override { return getBE<u32>(offset); }
 
    private:
-    std::vector<char> m_data;
-    std::string m_name;
-    std::filesystem::path m_lpath;
+    mio::mmap_source m_data;
+    std::FILE *m_writer = nullptr;
+    std::filesystem::path m_scratchPath;
 };
@@ -11,6 +11,7 @@
 #include "LoaderManager.h"
 #include "LogManager.h"
 
+#include <algorithm>
 #include <memory>
 
 extern "C" {
@@ -65,7 +66,7 @@ static int mem_fseek(core_file *fp, s64 offset, int whence) {
   return 0;
 }
 
-void CHDLoader::apply(const RawFile *file) {
+void CHDLoader::apply(const RawFile *file) const {
   if (file->size() < 8) return;
   if (!std::equal(file->begin(), file->begin() + 8, "MComprHD")) return;
 
@@ -85,22 +86,42 @@ void CHDLoader::apply(const RawFile *file) {
     return;
   }
 
-  std::vector<u8> data(static_cast<size_t>(hdr->logicalbytes));
+  // Hunks are decompressed one at a time straight into a file-backed image, so a whole disc
+  // never has to sit on the heap
+  auto image = std::make_unique<ScratchFile>(file->name(), file->path(), file->tag);
   std::vector<u8> hunkbuf(hdr->hunkbytes);
-  size_t offset = 0;
-  for (u32 h = 0; h < hdr->hunkcount; ++h) {
+  u64 remaining = hdr->logicalbytes;
+  for (u32 h = 0; h < hdr->hunkcount && remaining > 0; ++h) {
     err = chd_read(chd, h, hunkbuf.data());
     if (err != CHDERR_NONE) {
       L_ERROR("CHD read error: {}", chd_error_string(err));
       chd_close(chd);
       return;
     }
-    size_t to_copy = std::min<size_t>(hdr->hunkbytes, data.size() - offset);
-    memcpy(data.data() + offset, hunkbuf.data(), to_copy);
-    offset += to_copy;
+    const size_t toWrite = static_cast<size_t>(std::min<u64>(hdr->hunkbytes, remaining));
+    if (!image->write(hunkbuf.data(), toWrite)) {
+      L_ERROR("Failed to write the decompressed CHD image");
+      chd_close(chd);
+      return;
+    }
+    remaining -= toWrite;
   }
   chd_close(chd);
 
-  enqueue(std::make_unique<VirtFile>(data.data(), static_cast<u32>(data.size()),
-                                     file->name(), file->path(), file->tag));
+  // Any logical bytes not covered by hunks read as zero
+  std::fill(hunkbuf.begin(), hunkbuf.end(), 0);
+  while (remaining > 0 && !hunkbuf.empty()) {
+    const size_t toWrite = static_cast<size_t>(std::min<u64>(hunkbuf.size(), remaining));
+    if (!image->write(hunkbuf.data(), toWrite)) {
+      L_ERROR("Failed to write the decompressed CHD image");
+      return;
+    }
+    remaining -= toWrite;
+  }
+
+  if (!image->finalize()) {
+    L_ERROR("Failed to map the decompressed CHD image");
+    return;
+  }
+  enqueue(std::move(image));
 }
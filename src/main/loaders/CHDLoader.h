@@ -10,5 +10,5 @@
 class CHDLoader : public FileLoader {
  public:
   ~CHDLoader() override = default;
-  void apply(const RawFile *) override;
+  void apply(const RawFile *) const override;
 };
\ No newline at end of file
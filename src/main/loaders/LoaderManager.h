@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -25,18 +26,23 @@ class LoaderManager final {
     m_generators.try_emplace(loader_name, gen);
   }
 
-  std::vector<std::shared_ptr<FileLoader>> loaders() const {
-    std::vector<std::shared_ptr<FileLoader>> tmp(m_generators.size());
-    std::transform(m_generators.begin(), m_generators.end(), tmp.begin(),
-                   [](auto pair) { return pair.second(); });
+  // Every registered loader, spawned on first use and then shared by all loads (see FileLoader)
+  const std::vector<std::shared_ptr<FileLoader>> &loaders() const {
+    std::call_once(m_spawnOnce, [this] {
+      m_loaders.resize(m_generators.size());
+      std::transform(m_generators.begin(), m_generators.end(), m_loaders.begin(),
+                     [](auto pair) { return pair.second(); });
+    });
 
-    return tmp;
+    return m_loaders;
   }
 
  private:
   LoaderManager() = default;
 
   std::unordered_map<std::string, loaderSpawner> m_generators;
+  mutable std::once_flag m_spawnOnce;
+  mutable std::vector<std::shared_ptr<FileLoader>> m_loaders;
 };
 
 namespace vgmtrans::loaders {
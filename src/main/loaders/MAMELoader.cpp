@@ -11,12 +11,14 @@
 #include "KabukiDecrypt.h"
 #include "LoaderManager.h"
 #include "LogManager.h"
+#include "MAMERomDatabase.h"
 #include "Root.h"
 #include "Scanner.h"
 
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <ranges>
 #include <utility>
 #include <vector>
@@ -33,20 +35,26 @@ namespace vgmtrans::loaders {
 LoaderRegistration<MAMELoader> _mame("MAME");
 }
 
-using json = nlohmann::json;
+// An open zip archive, shared by the rom groups that have yet to be assembled from it
+struct MAMEZipArchive {
+  unzFile file = nullptr;
+  std::mutex mutex;
 
-bool MAMERomGroup::getHexAttribute(const std::string& attrName, u32* out) const {
-  auto it = attributes.find(attrName);
-  if (it == attributes.end()) {
-    return false;  // Key not found
+  ~MAMEZipArchive() {
+    if (file)
+      (void)unzClose(file);
   }
+};
 
-  auto strValue = it->second;
-  if (strValue.empty()) {
-    return false;  // Value is empty
+using json = nlohmann::json;
+
+bool MAMERomGroup::getHexAttribute(const std::string& attrName, u32* out) const {
+  auto it = hexAttributes.find(attrName);
+  if (it == hexAttributes.end()) {
+    return false;  // Key not found or value is empty
   }
 
-  *out = static_cast<u32>(std::strtoul(strValue.c_str(), nullptr, 16));
+  *out = it->second;
   return true;
 }
 
@@ -54,21 +62,21 @@ MAMERomGroup* MAMEGame::getRomGroupOfType(const std::string& strType) {
   if (auto group = std::ranges::find_if(
           romgroupentries, [&strType](const auto& romGroup) { return romGroup.type == strType; });
       group != romgroupentries.end()) {
+    // Groups are assembled on first request, so a scanner sees a group that failed to
+    // assemble as missing rather than as zeros
+    if (auto assemble = std::exchange(group->assemble, nullptr); assemble && !assemble()) {
+      group->file = nullptr;
+    }
     return std::addressof(*group);
   }
 
   return nullptr;
 }
 
-MAMELoader::MAMELoader() {
-  bLoadedXml = loadJSON();
-}
-
-MAMELoader::~MAMELoader() = default;
-
 namespace {
 
 const std::filesystem::path kMameJsonFilename = "mame_roms.json";
+const std::filesystem::path kMameDatabaseFilename = "mame_roms.bin";
 
 std::string jsonToString(const json& value) {
   if (value.is_string())
@@ -165,6 +173,13 @@ bool loadRomGroupEntry(const json& romgroupJson, MAMEGame* gameentry) {
     romgroupentry.attributes[key] = jsonToString(value);
   }
 
+  for (const auto& [key, value] : romgroupentry.attributes) {
+    if (!value.empty()) {
+      romgroupentry.hexAttributes.emplace(
+          key, static_cast<u32>(std::strtoul(value.c_str(), nullptr, 16)));
+    }
+  }
+
   auto romsIt = romgroupJson.find("roms");
   if (romsIt == romgroupJson.end() || !romsIt->is_array() || romsIt->empty()) {
     return false;
@@ -223,6 +238,15 @@ std::unique_ptr<MAMEGame> loadGameEntry(const json& gameJson) {
 
 }  // namespace
 
+MAMELoader::MAMELoader() {
+  const auto resourceDir = pRoot->UI_getResourceDirPath();
+  m_romDatabase = MAMERomDatabase::open(resourceDir / kMameDatabaseFilename,
+                                        resourceDir / kMameJsonFilename);
+  bLoadedXml = m_romDatabase || loadJSON();
+}
+
+MAMELoader::~MAMELoader() = default;
+
 bool MAMELoader::loadJSON() {
   try {
     const auto jsonFilePath = pRoot->UI_getResourceDirPath() / kMameJsonFilename;
@@ -277,35 +301,36 @@ bool MAMELoader::loadJSON() {
   }
 }
 
-void MAMELoader::apply(const RawFile* file) {
+void MAMELoader::apply(const RawFile* file) const {
   if (!bLoadedXml || file->extension() != "zip")
     return;
 
   std::string filename = file->stem();
 
   /* Look for the game in our database */
-  GameMap::iterator it = gamemap.find(filename);
-  if (it == gamemap.end()) {
+  // The database is shared by every load, so the rom group files are attached to a copy of the
+  // game entry
+  MAMEGame game;
+  if (!findGame(filename, game)) {
     return;
   }
 
-  MAMEGame* gameentry = it->second.get();
-
   /* Check if we support this format */
-  Format* fmt = Format::formatFromName(gameentry->format);
+  Format* fmt = Format::formatFromName(game.format);
   if (!fmt) {
     return;
   }
 
+  auto archive = std::make_shared<MAMEZipArchive>();
 #if defined(_WIN32) || defined(WIN32)
   zlib_filefunc64_def ffunc{};
   fill_win32_filefunc64W(&ffunc);     // use CreateFileW-based open
-  unzFile cur_file = unzOpen2_64(file->path().c_str(), &ffunc);
+  archive->file = unzOpen2_64(file->path().c_str(), &ffunc);
 #else
-  unzFile cur_file = unzOpen(file->path().c_str());
+  archive->file = unzOpen(file->path().c_str());
 #endif
 
-  if (!cur_file) {
+  if (!archive->file) {
     return;
   }
 
@@ -313,28 +338,100 @@ void MAMELoader::apply(const RawFile* file) {
   // file member
   // Note that this does not check for an error, so the romgroup entry's file member may receive
   // NULL. This must be checked for in Scan().
-  std::vector<std::unique_ptr<VirtFile>> loadedFiles;
-  for (auto& entry : gameentry->romgroupentries) {
-    auto loadedFile = loadRomGroup(entry, gameentry->format, cur_file);
+  // The groups are only assembled from the zip once the scanner asks for them, so groups it has
+  // no use for are never decompressed.
+  std::vector<std::pair<std::unique_ptr<LazyFile>, const MAMERomGroup*>> loadedFiles;
+  for (auto& entry : game.romgroupentries) {
+    auto loadedFile = loadRomGroup(entry, archive);
     entry.file = loadedFile.get();
     if (loadedFile) {
-      loadedFiles.push_back(std::move(loadedFile));
+      entry.assemble = [file = loadedFile.get()] { return file->load(); };
+      loadedFiles.emplace_back(std::move(loadedFile), &entry);
+    }
+  }
+
+  fmt->getScanner().scan(nullptr, &game);
+  for (auto& [loadedFile, entry] : loadedFiles) {
+    // Groups that failed to assemble have been dropped from the game
+    if (entry->file) {
+      enqueue(std::move(loadedFile));
+    }
+  }
+}
+
+bool MAMELoader::findGame(const std::string& name, MAMEGame& game) const {
+  if (m_romDatabase) {
+    return m_romDatabase->findGame(name, game);
+  }
+
+  auto it = gamemap.find(name);
+  if (it == gamemap.end()) {
+    return false;
+  }
+  game = *it->second;
+  return true;
+}
+
+std::unique_ptr<LazyFile> MAMELoader::loadRomGroup(const MAMERomGroup& entry,
+                                                   const std::shared_ptr<MAMEZipArchive>& archive) {
+  // Check that every rom is present and total up their sizes without decompressing anything
+  size_t destFileSize = 0;
+  {
+    std::lock_guard lock(archive->mutex);
+    for (auto& rom : entry.roms) {
+      if (unzLocateFile(archive->file, rom.c_str(), 0) != UNZ_OK) {
+        // file not found
+        return nullptr;
+      }
+
+      unz_file_info info;
+      if (unzGetCurrentFileInfo(archive->file, &info, nullptr, 0, nullptr, 0, nullptr, 0) != UNZ_OK) {
+        // could not get zipped file info
+        return nullptr;
+      }
+      destFileSize += info.uncompressed_size;
     }
   }
 
-  fmt->getScanner().scan(nullptr, gameentry);
-  for (auto& loadedFile : loadedFiles) {
-    enqueue(std::move(loadedFile));
+  DecryptionKeys keys;
+  if (!checkRomGroup(entry, keys)) {
+    return nullptr;
   }
-  for (auto& entry : gameentry->romgroupentries) {
-    entry.file = nullptr;
+
+  auto assemble = [entry, keys, archive](std::vector<u8>& destFile) {
+    std::lock_guard lock(archive->mutex);
+    return assembleRomGroup(entry, keys, archive->file, destFile);
+  };
+  auto newFile = std::make_unique<LazyFile>(fmt::format("romgroup - {}", entry.type.c_str()),
+                                            destFileSize, std::move(assemble));
+  newFile->setUseLoaders(false);
+  newFile->setUseScanners(false);
+  return newFile;
+}
+
+bool MAMELoader::checkRomGroup(const MAMERomGroup& entry, DecryptionKeys& keys) {
+  if (entry.loadmethod == LoadMethod::DEINTERLACE_PAIRS && entry.roms.size() % 2 > 0) {
+    L_ERROR("MAMELoader was going to load a rom group by deinterlacing rom pairs, but there"
+            "an odd number of roms in the group. Aborting.");
+    return false;
   }
 
-  (void)unzClose(cur_file);
+  // Decryption can only go ahead with its keys
+  if (entry.encryption == "kabuki") {
+    return entry.getHexAttribute("kabuki_swap_key1", &keys.kabukiSwapKey1) &&
+           entry.getHexAttribute("kabuki_swap_key2", &keys.kabukiSwapKey2) &&
+           entry.getHexAttribute("kabuki_addr_key", &keys.kabukiAddrKey) &&
+           entry.getHexAttribute("kabuki_xor_key", &keys.kabukiXorKey);
+  }
+  if (entry.encryption == "cps3") {
+    return entry.getHexAttribute("key1", &keys.cps3Key1) &&
+           entry.getHexAttribute("key2", &keys.cps3Key2);
+  }
+  return true;
 }
 
-std::unique_ptr<VirtFile> MAMELoader::loadRomGroup(const MAMERomGroup& entry, const std::string& format,
-                                                   const unzFile& cur_file) {
+bool MAMELoader::assembleRomGroup(const MAMERomGroup& entry, const DecryptionKeys& keys,
+                                  const unzFile& cur_file, std::vector<u8>& destFile) {
   u32 destFileSize = 0;
   std::list<std::vector<u8>> buffers;
   auto roms = entry.roms;
@@ -342,40 +439,40 @@ std::unique_ptr<VirtFile> MAMELoader::loadRomGroup(const MAMERomGroup& entry, co
     int ret = unzLocateFile(cur_file, rom.c_str(), 0);
     if (ret == UNZ_END_OF_LIST_OF_FILE) {
       // file not found
-      return nullptr;
+      return false;
     }
 
     unz_file_info info;
     ret = unzGetCurrentFileInfo(cur_file, &info, nullptr, 0, nullptr, 0, nullptr, 0);
     if (ret != UNZ_OK) {
       // could not get zipped file info
-      return nullptr;
+      return false;
     }
 
     destFileSize += info.uncompressed_size;
     ret = unzOpenCurrentFile(cur_file);
     if (ret != UNZ_OK) {
       // could not open file in zip archive
-      return nullptr;
+      return false;
     }
 
     std::vector<u8> buf(info.uncompressed_size);
     ret = unzReadCurrentFile(cur_file, buf.data(), static_cast<u32>(info.uncompressed_size));
     if (!std::cmp_equal(ret, info.uncompressed_size)) {
       // error reading file in zip archive
-      return nullptr;
+      return false;
     }
 
     ret = unzCloseCurrentFile(cur_file);
     if (ret != UNZ_OK) {
       // could not close file in zip archive
-      return nullptr;
+      return false;
     }
 
     buffers.emplace_back(std::move(buf));
   }
 
-  std::vector<u8> destFile(destFileSize);
+  destFile.assign(destFileSize, 0);
   switch (entry.loadmethod) {
     // append the files
     case LoadMethod::APPEND: {
@@ -446,12 +543,7 @@ std::unique_ptr<VirtFile> MAMELoader::loadRomGroup(const MAMERomGroup& entry, co
     }
 
     case LoadMethod::DEINTERLACE_PAIRS: {
-      if (buffers.size() % 2 > 0) {
-        L_ERROR("MAMELoader was going to load a rom group by deinterlacing rom pairs, but there"
-                "an odd number of roms in the group. Aborting.");
-        return nullptr;
-      }
-
+      // checkRomGroup() rejected groups with an odd number of roms
       u32 curDestOffset = 0;
       u32 curRomOffset = 0;
       auto it = buffers.begin();
@@ -480,33 +572,18 @@ std::unique_ptr<VirtFile> MAMELoader::loadRomGroup(const MAMERomGroup& entry, co
   // If an encryption type is defined, decrypt the data
   if (!entry.encryption.empty()) {
     if (entry.encryption == "kabuki") {
-      u32 swap_key1, swap_key2, addr_key, xor_key;
-      if (!entry.getHexAttribute("kabuki_swap_key1", &swap_key1) ||
-          !entry.getHexAttribute("kabuki_swap_key2", &swap_key2) ||
-          !entry.getHexAttribute("kabuki_addr_key", &addr_key) ||
-          !entry.getHexAttribute("kabuki_xor_key", &xor_key)) {
-        return nullptr;
-      }
       std::vector<u8> decrypt(0x8000);
-      KabukiDecrypter::kabuki_decode(destFile.data(), decrypt.data(), destFile.data(), 0x0000, 0x8000, swap_key1,
-                                     swap_key2, addr_key, xor_key);
+      KabukiDecrypter::kabuki_decode(destFile.data(), decrypt.data(), destFile.data(), 0x0000, 0x8000,
+                                     keys.kabukiSwapKey1, keys.kabukiSwapKey2, keys.kabukiAddrKey,
+                                     keys.kabukiXorKey);
     } else if (entry.encryption == "cps3") {
-      u32 key1, key2;
-      if (!entry.getHexAttribute("key1", &key1) ||
-          !entry.getHexAttribute("key2", &key2)) {
-        return nullptr;
-      }
-
-      if (key1 != 0 && key2 != 0) {
+      if (keys.cps3Key1 != 0 && keys.cps3Key2 != 0) {
         CPS3Decrypt::cps3_decode(reinterpret_cast<u32*>(destFile.data()),
-                                 reinterpret_cast<u32*>(destFile.data()), key1, key2, destFileSize);
+                                 reinterpret_cast<u32*>(destFile.data()), keys.cps3Key1,
+                                 keys.cps3Key2, destFileSize);
       }
     }
   }
 
-  auto newVirtFile = std::make_unique<VirtFile>(destFile.data(), destFileSize,
-                                                fmt::format("romgroup - {}", entry.type.c_str()));
-  newVirtFile->setUseLoaders(false);
-  newVirtFile->setUseScanners(false);
-  return newVirtFile;
+  return true;
 }
@@ -9,6 +9,7 @@
 #include "components/FileLoader.h"
 
 #include <cassert>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -19,7 +20,10 @@
 
 #include <unzip.h>
 
-class VirtFile;
+class LazyFile;
+class MAMERomDatabase;
+class RawFile;
+struct MAMEZipArchive;
 
 enum class LoadMethod { APPEND, APPEND_SWAP16, DEINTERLACE, DEINTERLACE_PAIRS };
 enum class LoadOrder { NORMAL, REVERSE };
@@ -54,8 +58,14 @@ struct MAMERomGroup {
     std::string type;
     std::string encryption;
     std::map<const std::string, std::string> attributes;
+    // Every non-empty attribute value parsed as hex up front, for getHexAttribute
+    std::map<const std::string, u32, std::less<>> hexAttributes;
     std::list<std::string> roms;
-    VirtFile *file{};
+    // The group's contents, assembled from the archive when a scanner first asks for the group.
+    // Null if the group is missing from the archive or could not be assembled
+    RawFile *file{};
+    // Assembles file, returning false on failure. Run by MAMEGame::getRomGroupOfType()
+    std::function<bool()> assemble;
 };
 
 struct MAMEGame {
@@ -73,13 +83,28 @@ class MAMELoader : public FileLoader {
    public:
     MAMELoader();
     ~MAMELoader() override;
-    void apply(const RawFile *theFile) override;
+    void apply(const RawFile *theFile) const override;
 
    private:
-    static std::unique_ptr<VirtFile> loadRomGroup(const MAMERomGroup &romgroup, const std::string &format,
-                                                  const unzFile &cur_file);
+    // The keys a rom group is decrypted with
+    struct DecryptionKeys {
+        u32 kabukiSwapKey1{}, kabukiSwapKey2{}, kabukiAddrKey{}, kabukiXorKey{};
+        u32 cps3Key1{}, cps3Key2{};
+    };
+
+    static std::unique_ptr<LazyFile> loadRomGroup(const MAMERomGroup &romgroup,
+                                                  const std::shared_ptr<MAMEZipArchive> &archive);
+    // Checks the group's load method and encryption can be applied, and reads its keys
+    static bool checkRomGroup(const MAMERomGroup &romgroup, DecryptionKeys &keys);
+    static bool assembleRomGroup(const MAMERomGroup &romgroup, const DecryptionKeys &keys,
+                                 const unzFile &cur_file, std::vector<u8> &destFile);
     bool loadJSON();
+    // Copies the named game's entry from whichever database was loaded
+    bool findGame(const std::string &name, MAMEGame &game) const;
 
+    // The precompiled database, when present and current; gamemap is only parsed from the JSON
+    // otherwise
+    std::unique_ptr<MAMERomDatabase> m_romDatabase;
     GameMap gamemap;
     bool bLoadedXml;
 };
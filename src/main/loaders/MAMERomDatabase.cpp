@@ -0,0 +1,189 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+#include "MAMERomDatabase.h"
+
+#include "LogManager.h"
+#include "MAMELoader.h"
+
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+#include <spdlog/fmt/std.h>
+
+namespace {
+
+constexpr char kMagic[8] = {'V', 'G', 'M', 'T', 'M', 'D', 'B', '\0'};
+constexpr size_t kHeaderSize = 52;
+constexpr size_t kStringRefSize = 8;
+constexpr size_t kGameSize = 32;
+constexpr size_t kRomGroupSize = 36;
+constexpr size_t kAttributeSize = 24;
+constexpr size_t kRomSize = kStringRefSize;
+constexpr u32 kAttributeHasHex = 1;
+
+u64 fnv1a64(const char *data, size_t size) {
+  u64 hash = 0xCBF29CE484222325ull;
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ static_cast<u8>(data[i])) * 0x100000001B3ull;
+  }
+  return hash;
+}
+
+}  // namespace
+
+MAMERomDatabase::MAMERomDatabase(mio::mmap_source file)
+    : m_file(std::move(file)),
+      m_view(reinterpret_cast<const u8 *>(m_file.data()), m_file.size()) {
+}
+
+std::unique_ptr<MAMERomDatabase> MAMERomDatabase::open(const std::filesystem::path &path,
+                                                       const std::filesystem::path &sourceJson) {
+  std::error_code error;
+  if (!std::filesystem::exists(path, error))
+    return nullptr;
+
+  mio::mmap_source file;
+  file.map(path.string(), error);
+  if (error) {
+    L_WARN("Failed to map the MAME ROM database at {}: {}", path, error.message());
+    return nullptr;
+  }
+
+  std::unique_ptr<MAMERomDatabase> database(new MAMERomDatabase(std::move(file)));
+  if (!database->validate(sourceJson))
+    return nullptr;
+  return database;
+}
+
+bool MAMERomDatabase::validate(const std::filesystem::path &sourceJson) {
+  if (!m_view.matches(0, kMagic, sizeof(kMagic)) || !m_view.contains(0, kHeaderSize) ||
+      m_view.load<u32>(8) != VERSION) {
+    L_WARN("The MAME ROM database is not in a supported format. Falling back to JSON");
+    return false;
+  }
+
+  const u32 sourceSize = m_view.load<u32>(12);
+  const u64 sourceHash = m_view.load<u64>(16);
+  m_gameCount = m_view.load<u32>(24);
+  m_gamesOffset = m_view.load<u32>(28);
+  m_romGroupsOffset = m_view.load<u32>(32);
+  m_attributesOffset = m_view.load<u32>(36);
+  m_romsOffset = m_view.load<u32>(40);
+  m_stringsOffset = m_view.load<u32>(44);
+  m_stringsSize = m_view.load<u32>(48);
+
+  // The tables are laid out back to back, in order
+  const bool laidOut = m_gamesOffset == kHeaderSize &&
+                       m_romGroupsOffset == m_gamesOffset + u64{m_gameCount} * kGameSize &&
+                       m_attributesOffset >= m_romGroupsOffset &&
+                       (m_attributesOffset - m_romGroupsOffset) % kRomGroupSize == 0 &&
+                       m_romsOffset >= m_attributesOffset &&
+                       (m_romsOffset - m_attributesOffset) % kAttributeSize == 0 &&
+                       m_stringsOffset >= m_romsOffset &&
+                       (m_stringsOffset - m_romsOffset) % kRomSize == 0 &&
+                       m_view.contains(m_stringsOffset, m_stringsSize);
+  if (!laidOut) {
+    L_WARN("The MAME ROM database is corrupt. Falling back to JSON");
+    return false;
+  }
+  m_romGroupCount = (m_attributesOffset - m_romGroupsOffset) / kRomGroupSize;
+  m_attributeCount = (m_romsOffset - m_attributesOffset) / kAttributeSize;
+  m_romCount = (m_stringsOffset - m_romsOffset) / kRomSize;
+
+  // mame_roms.json stays user-editable, so an edited copy takes precedence over the database
+  std::error_code error;
+  if (std::filesystem::exists(sourceJson, error)) {
+    const auto size = std::filesystem::file_size(sourceJson, error);
+    std::vector<char> source(error ? 0 : size);
+    std::ifstream json(sourceJson, std::ios::binary);
+    json.read(source.data(), static_cast<std::streamsize>(source.size()));
+    if (error || !json || source.size() != sourceSize ||
+        fnv1a64(source.data(), source.size()) != sourceHash) {
+      L_INFO("{} changed since the MAME ROM database was built. Falling back to JSON", sourceJson);
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string_view MAMERomDatabase::string(size_t recordOffset) const {
+  const u32 offset = m_view.load<u32>(recordOffset);
+  const u32 length = m_view.load<u32>(recordOffset + 4);
+  if (offset > m_stringsSize || length > m_stringsSize - offset)
+    return {};
+  return {reinterpret_cast<const char *>(m_view.data()) + m_stringsOffset + offset, length};
+}
+
+bool MAMERomDatabase::findGame(std::string_view name, MAMEGame &game) const {
+  u32 first = 0;
+  u32 count = m_gameCount;
+  while (count > 0) {
+    const u32 step = count / 2;
+    if (string(m_gamesOffset + size_t{first + step} * kGameSize) < name) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+
+  const size_t record = m_gamesOffset + size_t{first} * kGameSize;
+  if (first == m_gameCount || string(record) != name)
+    return false;
+
+  game = MAMEGame();
+  game.name = string(record);
+  game.format = string(record + 8);
+  game.fmt_version_str = string(record + 16);
+
+  const u32 firstGroup = m_view.load<u32>(record + 24);
+  const u32 groupCount = m_view.load<u32>(record + 28);
+  if (firstGroup > m_romGroupCount || groupCount > m_romGroupCount - firstGroup)
+    return false;
+  for (u32 i = 0; i < groupCount; i++) {
+    if (!loadRomGroup(firstGroup + i, game))
+      return false;
+  }
+  return true;
+}
+
+bool MAMERomDatabase::loadRomGroup(u32 index, MAMEGame &game) const {
+  const size_t record = m_romGroupsOffset + size_t{index} * kRomGroupSize;
+  const u8 loadMethod = m_view.load<u8>(record + 16);
+  const u8 loadOrder = m_view.load<u8>(record + 17);
+  const u32 firstAttribute = m_view.load<u32>(record + 20);
+  const u32 attributeCount = m_view.load<u32>(record + 24);
+  const u32 firstRom = m_view.load<u32>(record + 28);
+  const u32 romCount = m_view.load<u32>(record + 32);
+  if (loadMethod > static_cast<u8>(LoadMethod::DEINTERLACE_PAIRS) ||
+      loadOrder > static_cast<u8>(LoadOrder::REVERSE) || firstAttribute > m_attributeCount ||
+      attributeCount > m_attributeCount - firstAttribute || firstRom > m_romCount ||
+      romCount > m_romCount - firstRom) {
+    return false;
+  }
+
+  auto &group = game.romgroupentries.emplace_back();
+  group.type = string(record);
+  group.encryption = string(record + 8);
+  group.loadmethod = static_cast<LoadMethod>(loadMethod);
+  group.load_order = static_cast<LoadOrder>(loadOrder);
+
+  for (u32 i = 0; i < attributeCount; i++) {
+    const size_t attribute = m_attributesOffset + size_t{firstAttribute + i} * kAttributeSize;
+    std::string key(string(attribute));
+    if (m_view.load<u32>(attribute + 20) & kAttributeHasHex) {
+      group.hexAttributes.emplace(key, m_view.load<u32>(attribute + 16));
+    }
+    group.attributes.emplace(std::move(key), string(attribute + 8));
+  }
+
+  for (u32 i = 0; i < romCount; i++) {
+    group.roms.emplace_back(string(m_romsOffset + size_t{firstRom + i} * kRomSize));
+  }
+  return true;
+}
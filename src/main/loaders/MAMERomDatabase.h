@@ -0,0 +1,69 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+// Binary form of mame_roms.json, compiled at build time by build-aux/build-mame-db.py.
+// The file is memory-mapped and queried in place: games are found with a binary search and only
+// the matching entry is turned into a MAMEGame, so opening the database costs next to nothing.
+//
+// Layout, all integers little-endian. A string is a (u32 offset, u32 length) pair into the
+// string pool.
+//   Header     "VGMTMDB\0", u32 version, u32 size and u64 FNV-1a hash of the source JSON,
+//              u32 game count, u32 offsets of the game, rom group, attribute, rom and string
+//              tables, u32 string pool size
+//   Game       string name, format, fmt_version, u32 first rom group, u32 rom group count
+//   RomGroup   string type, encryption, u8 LoadMethod, u8 LoadOrder, u16 padding,
+//              u32 first attribute, u32 attribute count, u32 first rom, u32 rom count
+//   Attribute  string key, value, u32 value parsed as hex, u32 flags (1: hex value is valid)
+//   Rom        string
+// Games are sorted by name and the attributes of each rom group by key.
+
+#pragma once
+#include "base/Types.h"
+#include "util/ByteView.h"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "mio.hpp"
+
+struct MAMEGame;
+
+class MAMERomDatabase {
+ public:
+  static constexpr u32 VERSION = 1;
+
+  // Maps the database at path. Returns null if it can't be used: it is missing, malformed, or
+  // was compiled from a different revision of sourceJson (only checked if that file exists)
+  static std::unique_ptr<MAMERomDatabase> open(const std::filesystem::path &path,
+                                               const std::filesystem::path &sourceJson);
+
+  [[nodiscard]] size_t gameCount() const { return m_gameCount; }
+
+  // Fills game with the entry named name. Returns false if there is no such game
+  bool findGame(std::string_view name, MAMEGame &game) const;
+
+ private:
+  explicit MAMERomDatabase(mio::mmap_source file);
+
+  bool validate(const std::filesystem::path &sourceJson);
+  [[nodiscard]] std::string_view string(size_t recordOffset) const;
+  [[nodiscard]] bool loadRomGroup(u32 index, MAMEGame &game) const;
+
+  mio::mmap_source m_file;
+  ByteView m_view;
+  u32 m_gameCount = 0;
+  u32 m_gamesOffset = 0;
+  u32 m_romGroupsOffset = 0;
+  u32 m_attributesOffset = 0;
+  u32 m_romsOffset = 0;
+  u32 m_stringsOffset = 0;
+  u32 m_stringsSize = 0;
+  u32 m_romGroupCount = 0;
+  u32 m_attributeCount = 0;
+  u32 m_romCount = 0;
+};
@@ -9,7 +9,11 @@
 #include "base/Types.h"
 #include "components/PSFFile.h"
 #include "LogManager.h"
+#include "util/ByteView.h"
+#include "util/Parallel.h"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -19,7 +23,7 @@ namespace vgmtrans::loaders {
 LoaderRegistration<PSF2Loader> _psf2("PSF2");
 }
 
-void PSF2Loader::apply(const RawFile *file) {
+void PSF2Loader::apply(const RawFile *file) const {
     /* Don't bother on a file too small */
     if (file->size() < 0x10) {
       return;
@@ -32,85 +36,95 @@ void PSF2Loader::apply(const RawFile *file) {
   }
 }
 
-static u32 get32lsb(const u8 *src) {
-    return (((static_cast<u32>(src[0])) & 0xFF) << 0) | (((static_cast<u32>(src[1])) & 0xFF) << 8) |
-           (((static_cast<u32>(src[2])) & 0xFF) << 16) | (((static_cast<u32>(src[3])) & 0xFF) << 24);
-}
+int PSF2Loader::psf2_decompress_file(const RawFile *file, unsigned fileoffset, unsigned filesize,
+                                     unsigned blocksize, std::vector<u8> &dest) {
+  if (blocksize == 0) {
+    L_ERROR("Invalid PSF2 block size");
+    return -1;
+  }
 
-int PSF2Loader::psf2_decompress_block(const RawFile *file, unsigned fileoffset,
-                                      unsigned blocknumber, unsigned numblocks,
-                                      unsigned char *decompressedblock, unsigned blocksize) {
-  unsigned long destlen;
-  std::vector<u8> blocks(numblocks * 4);
+  const ByteView view = file->view();
+  const size_t blockcount = (static_cast<size_t>(filesize) + blocksize - 1) / blocksize;
+  if (!view.contains(fileoffset, blockcount * 4)) {
+    L_ERROR("PSF2 block table is out of range");
+    return -1;
+  }
 
-  file->readBytes(fileoffset, numblocks * 4, blocks.data());
-  unsigned long current_block = get32lsb(blocks.data() + (blocknumber * 4));
-  std::vector<u8> zblock(current_block);
+  // Resolve where every compressed block lives in one pass over the size table
+  std::vector<size_t> blockOffsets(blockcount + 1);
+  blockOffsets[0] = fileoffset + blockcount * 4;
+  for (size_t i = 0; i < blockcount; i++) {
+    blockOffsets[i + 1] = blockOffsets[i] + view.load<u32>(fileoffset + i * 4);
+  }
+  if (blockOffsets[blockcount] > view.size()) {
+    L_ERROR("PSF2 block data is out of range");
+    return -1;
+  }
 
-  int tempOffset = fileoffset + numblocks * 4;
-  for (u32 i = 0; i < blocknumber; i++)
-    tempOffset += get32lsb(blocks.data() + (i * 4));
-  file->readBytes(tempOffset, current_block, zblock.data());
+  // Every block but the last inflates to exactly blocksize bytes, so each one can be written
+  // straight to its final position in the destination buffer. Files of only a few blocks
+  // inflate faster than threads start, so only larger ones are split over the scan threads.
+  constexpr size_t kMinParallelBlocks = 8;
+  const unsigned threads = blockcount < kMinParallelBlocks ? 1 : pRoot->scanThreadCount();
+  dest.resize(filesize);
+  std::atomic<bool> failed{false};
+  vgmtrans::parallelFor(blockcount, threads, [&](size_t i) {
+    if (failed.load(std::memory_order_relaxed)) {
+      return;
+    }
 
-  destlen = blocksize;
-  if (uncompress(decompressedblock, &destlen, zblock.data(), current_block) != Z_OK) {
+    const u8 *zblock = view.data() + blockOffsets[i];
+    const uLong zsize = static_cast<uLong>(blockOffsets[i + 1] - blockOffsets[i]);
+    const size_t destOffset = i * blocksize;
+    const size_t length = std::min<size_t>(blocksize, filesize - destOffset);
+
+    uLongf destlen = blocksize;
+    int result;
+    if (length == blocksize) {
+      result = uncompress(dest.data() + destOffset, &destlen, zblock, zsize);
+    } else {
+      // The trailing block may inflate to more than is kept of it
+      std::vector<u8> dblock(blocksize);
+      result = uncompress(dblock.data(), &destlen, zblock, zsize);
+      std::copy_n(dblock.data(), length, dest.data() + destOffset);
+    }
+    if (result != Z_OK) {
+      failed = true;
+    }
+  });
+
+  if (failed) {
     L_ERROR("Decompression failed");
     return -1;
   }
-
   return 0;
 }
 
-int PSF2Loader::psf2unpack(const RawFile *file, unsigned long fileoffset, unsigned long dircount) {
+int PSF2Loader::psf2unpack(const RawFile *file, unsigned long fileoffset, unsigned long dircount) const {
   char filename[37];
-  unsigned long offset = 0;
-  unsigned long filesize = 0;
-  unsigned long buffersize = 0;
-
-  int r;
-
   memset(filename, 0, std::size(filename));
 
   for (u32 i = 0; i < dircount; i++) {
-    file->readBytes(i * 48 + fileoffset, 36, filename);
-    file->readBytes(i * 48 + fileoffset + 36, 4, &offset);
-    file->readBytes(i * 48 + fileoffset + 36 + 4, 4, &filesize);
-    file->readBytes(i * 48 + fileoffset + 36 + 4 + 4, 4, &buffersize);
+    const size_t entryOffset = i * 48 + fileoffset;
+    file->readBytes(entryOffset, 36, filename);
+    const u32 offset = file->get<u32>(entryOffset + 36);
+    const u32 filesize = file->get<u32>(entryOffset + 36 + 4);
+    const u32 buffersize = file->get<u32>(entryOffset + 36 + 4 + 4);
     if ((filesize == 0) && (buffersize == 0)) {
-      file->readBytes(offset + 0x10, 4, &filesize);
+      const u32 subdircount = file->get<u32>(offset + 0x10);
 
-      r = psf2unpack(file, offset + 0x14, filesize);
-      if (r) {
+      if (psf2unpack(file, offset + 0x14, subdircount)) {
         L_ERROR("Directory decompression failed");
         return -1;
       }
     } else {
-      u32 blockcount = ((filesize + buffersize) - 1) / buffersize;
-
-      u32 actualFileSize = filesize;
-      std::vector<u8> newdataBuf(actualFileSize);
-      u32 k = 0;
-
-      std::vector<u8> dblock(buffersize);
-
-      for (u32 j = 0; j < blockcount; j++) {
-        r = psf2_decompress_block(file, offset + 0x10, j, blockcount, dblock.data(), buffersize);
-
-        if (r) {
-          //string.Format("File %s failed to decompress",filename);
-          return -1;
-        }
-        if (filesize > buffersize) {
-          filesize -= buffersize;
-          memcpy(newdataBuf.data() + k, dblock.data(), buffersize);
-          k += buffersize;
-        } else {
-          memcpy(newdataBuf.data() + k, dblock.data(), filesize);
-          k += filesize;
-        }
+      std::vector<u8> newdataBuf;
+      if (psf2_decompress_file(file, offset + 0x10, filesize, buffersize, newdataBuf)) {
+        //string.Format("File %s failed to decompress",filename);
+        return -1;
       }
 
-      enqueue(std::make_unique<VirtFile>(newdataBuf.data(), actualFileSize, filename, file->path()));
+      enqueue(std::make_unique<VirtFile>(std::move(newdataBuf), filename, file->path()));
     }
   }
 
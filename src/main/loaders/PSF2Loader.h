@@ -8,13 +8,16 @@
 #include "components/FileLoader.h"
 #include "LoaderManager.h"
 
+#include <vector>
+
 class PSF2Loader final : public FileLoader {
  public:
     ~PSF2Loader() override = default;
-    void apply(const RawFile *) override;
+    void apply(const RawFile *) const override;
 
    private:
-    static int psf2_decompress_block(const RawFile *file, unsigned fileoffset, unsigned blocknumber,
-                                     unsigned numblocks, unsigned char *decompressedblock, unsigned blocksize);
-    int psf2unpack(const RawFile *file, unsigned long fileoffset, unsigned long dircount);
+    // Inflates a file's blocks in parallel into dest, which is sized to filesize
+    static int psf2_decompress_file(const RawFile *file, unsigned fileoffset, unsigned filesize,
+                                    unsigned blocksize, std::vector<u8> &dest);
+    int psf2unpack(const RawFile *file, unsigned long fileoffset, unsigned long dircount) const;
 };
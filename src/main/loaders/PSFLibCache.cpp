@@ -0,0 +1,138 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+#include "PSFLibCache.h"
+
+#include <algorithm>
+#include <system_error>
+
+namespace vgmtrans::psf {
+
+/* Image */
+
+void Image::overlay(u32 addr, const u8 *bytes, size_t size) {
+  if (!size)
+    return;
+  written.push_back({addr, addr + static_cast<u32>(size)});
+  if (data.empty()) {
+    start = addr;
+    end = addr + static_cast<u32>(size);
+    data.assign(bytes, bytes + size);
+    return;
+  }
+  u32 new_start = std::min(start, addr);
+  u32 new_end = std::max(end, addr + static_cast<u32>(size));
+  if (new_start != start) {
+    data.insert(data.begin(), start - new_start, 0);
+    start = new_start;
+  }
+  if (new_end > end) {
+    data.resize(new_end - start, 0);
+    end = new_end;
+  }
+  std::copy(bytes, bytes + size, data.begin() + (addr - start));
+}
+
+void Image::overlay(const Image &other) {
+  // Only the written ranges are copied, so the other image's zero-filled gaps don't clobber
+  // what is already here
+  for (const auto &extent : other.written) {
+    overlay(extent.begin, other.data.data() + (extent.begin - other.start),
+            extent.end - extent.begin);
+  }
+}
+
+void Image::compact() {
+  std::ranges::sort(written, {}, &Extent::begin);
+  std::vector<Extent> merged;
+  for (const auto &extent : written) {
+    if (!merged.empty() && extent.begin <= merged.back().end) {
+      merged.back().end = std::max(merged.back().end, extent.end);
+    } else {
+      merged.push_back(extent);
+    }
+  }
+  written = std::move(merged);
+}
+
+/* LibraryCache */
+
+LibraryCache &LibraryCache::get() {
+  static LibraryCache cache;
+  return cache;
+}
+
+std::shared_ptr<const Image> LibraryCache::load(const std::filesystem::path &path,
+                                                const std::function<Image()> &load) {
+  std::error_code ec;
+  auto key = std::filesystem::canonical(path, ec);
+  std::filesystem::file_time_type mtime;
+  if (!ec) {
+    mtime = std::filesystem::last_write_time(key, ec);
+  }
+  if (ec) {
+    // Can't identify the file reliably, so don't cache it. Opening it will report the error
+    return std::make_shared<const Image>(load());
+  }
+
+  {
+    std::lock_guard lock(m_mutex);
+    if (auto it = m_entries.find(key); it != m_entries.end()) {
+      if (it->second.mtime == mtime) {
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lruPos);
+        return it->second.image;
+      }
+      // The library changed on disk since it was cached
+      m_size -= it->second.image->footprint();
+      m_lru.erase(it->second.lruPos);
+      m_entries.erase(it);
+    }
+  }
+
+  // Resolve without holding the lock; a library loads its own libraries through the cache
+  Image image = load();
+  image.compact();
+  auto shared = std::make_shared<const Image>(std::move(image));
+
+  std::lock_guard lock(m_mutex);
+  if (shared->footprint() > m_capacity) {
+    return shared;
+  }
+  if (auto it = m_entries.find(key); it != m_entries.end()) {
+    m_size -= it->second.image->footprint();
+    m_lru.erase(it->second.lruPos);
+    m_entries.erase(it);
+  }
+  m_lru.push_front(key);
+  m_entries.emplace(std::move(key), Entry{mtime, shared, m_lru.begin()});
+  m_size += shared->footprint();
+  evict();
+  return shared;
+}
+
+void LibraryCache::setCapacity(size_t bytes) {
+  std::lock_guard lock(m_mutex);
+  m_capacity = bytes;
+  evict();
+}
+
+void LibraryCache::clear() {
+  std::lock_guard lock(m_mutex);
+  m_entries.clear();
+  m_lru.clear();
+  m_size = 0;
+}
+
+void LibraryCache::evict() {
+  while (m_size > m_capacity && !m_lru.empty()) {
+    auto it = m_entries.find(m_lru.back());
+    m_size -= it->second.image->footprint();
+    m_entries.erase(it);
+    m_lru.pop_back();
+  }
+}
+
+}  // namespace vgmtrans::psf
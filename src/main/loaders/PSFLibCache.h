@@ -0,0 +1,79 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+#pragma once
+
+#include "base/Types.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vgmtrans::psf {
+
+// A PSF memory image assembled from a file's exe and those of its libraries
+struct Image {
+  struct Extent {
+    u32 begin;
+    u32 end;
+  };
+
+  u32 start = 0;
+  u32 end = 0;
+  std::vector<u8> data;
+  // Address ranges that were actually written, as opposed to zero-filled gaps
+  std::vector<Extent> written;
+
+  void overlay(u32 addr, const u8 *bytes, size_t size);
+  // Applies another image as if each of its writes were replayed onto this one
+  void overlay(const Image &other);
+  // Sorts and merges the written ranges
+  void compact();
+  [[nodiscard]] size_t footprint() const noexcept {
+    return data.size() + written.size() * sizeof(Extent);
+  }
+};
+
+// Process-wide cache of fully resolved library images, keyed by canonical path and last write
+// time. A minipsf set typically shares one large library, so it is inflated and assembled once
+// rather than once per track. The least recently used images are evicted past the memory cap.
+class LibraryCache {
+ public:
+  static constexpr size_t DEFAULT_CAPACITY = 128 * 1024 * 1024;
+
+  static LibraryCache &get();
+
+  // Returns the cached image of the library at path, or resolves it with load and caches it.
+  // Exceptions thrown by load are propagated and nothing is cached
+  std::shared_ptr<const Image> load(const std::filesystem::path &path,
+                                    const std::function<Image()> &load);
+
+  void setCapacity(size_t bytes);
+  void clear();
+
+ private:
+  struct Entry {
+    std::filesystem::file_time_type mtime;
+    std::shared_ptr<const Image> image;
+    std::list<std::filesystem::path>::iterator lruPos;
+  };
+
+  LibraryCache() = default;
+  void evict();
+
+  std::mutex m_mutex;
+  std::map<std::filesystem::path, Entry> m_entries;
+  // Most recently used first
+  std::list<std::filesystem::path> m_lru;
+  size_t m_size = 0;
+  size_t m_capacity = DEFAULT_CAPACITY;
+};
+
+}  // namespace vgmtrans::psf
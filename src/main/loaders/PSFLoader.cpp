@@ -11,6 +11,7 @@
 #include "LoaderManager.h"
 #include "LogManager.h"
 #include "PSFFile.h"
+#include "PSFLibCache.h"
 #include "PSFMetadataHints.h"
 
 #include <algorithm>
@@ -28,36 +29,10 @@ LoaderRegistration<PSFLoader> psf{"PSF"};
 
 namespace {
 
-struct Image {
-  u32 start = 0;
-  u32 end = 0;
-  std::vector<u8> data;
-};
+using vgmtrans::psf::Image;
 
 constexpr int MAX_RECURSION = 10;
 
-void overlay(Image &img, u32 addr, const u8 *data, size_t size) {
-  if (!size)
-    return;
-  if (img.data.empty()) {
-    img.start = addr;
-    img.end = addr + static_cast<u32>(size);
-    img.data.assign(data, data + size);
-    return;
-  }
-  u32 new_start = std::min(img.start, addr);
-  u32 new_end = std::max(img.end, addr + static_cast<u32>(size));
-  if (new_start != img.start) {
-    img.data.insert(img.data.begin(), img.start - new_start, 0);
-    img.start = new_start;
-  }
-  if (new_end > img.end) {
-    img.data.resize(new_end - img.start, 0);
-    img.end = new_end;
-  }
-  std::copy(data, data + size, img.data.begin() + (addr - img.start));
-}
-
 void load_with_libs(const PSFFile &psf, const std::filesystem::path &basepath, Image &img,
                     int depth = 0) {
   if (depth >= MAX_RECURSION)
@@ -66,9 +41,14 @@ void load_with_libs(const PSFFile &psf, const std::filesystem::path &basepath, I
   auto tryOpenLib = [&](const std::string& libname) {
     auto newpath = basepath / libname;
     auto doLoad = [&](const std::filesystem::path& p) {
-      DiskFile libfile(p);
-      PSFFile libpsf(libfile);
-      load_with_libs(libpsf, p.parent_path(), img, depth + 1);
+      auto lib = vgmtrans::psf::LibraryCache::get().load(p, [&] {
+        DiskFile libfile(p);
+        PSFFile libpsf(libfile);
+        Image libimg;
+        load_with_libs(libpsf, p.parent_path(), libimg, depth + 1);
+        return libimg;
+      });
+      img.overlay(*lib);
     };
     try {
       doLoad(newpath);
@@ -96,9 +76,8 @@ void load_with_libs(const PSFFile &psf, const std::filesystem::path &basepath, I
       throw std::runtime_error(fmt::format("Unsupported PSF version {:#x}",
                                            static_cast<unsigned>(psf.version())));
     }
-    overlay(img, addr,
-            reinterpret_cast<const u8 *>(psf.exe().data()) + *off,
-            psf.exe().size() - *off);
+    img.overlay(addr, reinterpret_cast<const u8 *>(psf.exe().data()) + *off,
+                psf.exe().size() - *off);
   }
 
   for (int i = 2;; ++i) {
@@ -111,7 +90,7 @@ void load_with_libs(const PSFFile &psf, const std::filesystem::path &basepath, I
 
 } // namespace
 
-void PSFLoader::apply(const RawFile *file) {
+void PSFLoader::apply(const RawFile *file) const {
   if (file->size() <= 16)
     return;
   if (std::equal(file->begin(), file->begin() + 3, "PSF")) {
@@ -122,7 +101,7 @@ void PSFLoader::apply(const RawFile *file) {
   }
 }
 
-void PSFLoader::psf_read_exe(const RawFile *file) {
+void PSFLoader::psf_read_exe(const RawFile *file) const {
   try {
     PSFFile psf(*file);
     Image img;
@@ -135,7 +114,7 @@ void PSFLoader::psf_read_exe(const RawFile *file) {
         metadataProvider = std::make_shared<IndexedMetadataHintProvider>(std::move(hints));
       }
 
-      enqueue(std::make_unique<VirtFile>(img.data.data(), img.data.size(), file->name(),
+      enqueue(std::make_unique<VirtFile>(std::move(img.data), file->name(),
                                          file->path(), tag, std::move(metadataProvider)));
     }
   } catch (std::exception &e) {
@@ -11,8 +11,8 @@ class PSFFile;
 class PSFLoader : public FileLoader {
    public:
     ~PSFLoader() override = default;
-    void apply(const RawFile *) override;
+    void apply(const RawFile *) const override;
 
    private:
-    void psf_read_exe(const RawFile *file);
+    void psf_read_exe(const RawFile *file) const;
 };
@@ -12,6 +12,8 @@
 #include "LogManager.h"
 
 #include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include "unarr.h"
@@ -22,7 +24,25 @@ LoaderRegistration<RSNLoader> _rsn("RSN");
 
 #define FILE_SIGNATURE_SIZE 7
 
-void RSNLoader::apply(const RawFile *file) {
+namespace {
+
+// An open rar archive, shared by the entries that have yet to be decompressed from it
+struct RarArchive {
+  ar_stream *stream = nullptr;
+  ar_archive *ar = nullptr;
+  std::mutex mutex;
+
+  ~RarArchive() {
+    if (ar)
+      ar_close_archive(ar);
+    if (stream)
+      ar_close(stream);
+  }
+};
+
+}  // namespace
+
+void RSNLoader::apply(const RawFile *file) const {
 
   if (file->size() < FILE_SIGNATURE_SIZE)
     return;
@@ -35,31 +55,43 @@ void RSNLoader::apply(const RawFile *file) {
     return;
   }
 
+  auto archive = std::make_shared<RarArchive>();
   auto path = file->path();
 #ifdef _WIN32
-  auto stream = ar_open_file_w(path.c_str());
+  archive->stream = ar_open_file_w(path.c_str());
 #else
-  auto stream = ar_open_file(path.c_str());
+  archive->stream = ar_open_file(path.c_str());
 #endif
-  ar_archive *ar = ar_open_rar_archive(stream);
-
-  while (ar_parse_entry(ar)) {
-    size_t size = ar_entry_get_size(ar);
-    const char *raw_filename = ar_entry_get_name(ar);
-    if (raw_filename) {
-      L_INFO("Decompressing file from rar archive: {}", raw_filename);
-    } else {
+  if (archive->stream) {
+    archive->ar = ar_open_rar_archive(archive->stream);
+  }
+  if (!archive->ar) {
+    L_ERROR("Could not open rar archive: {}", file->name());
+    return;
+  }
+
+  // Only the entry headers are read here. Each entry is decompressed when it is first accessed,
+  // so at most one entry that turns out to hold nothing is in memory at a time
+  while (ar_parse_entry(archive->ar)) {
+    const char *raw_filename = ar_entry_get_name(archive->ar);
+    if (!raw_filename) {
       continue;
     }
-    std::vector<u8> buffer(size);
-    if (!ar_entry_uncompress(ar, buffer.data(), size)) {
-      L_ERROR("Error decompressing file from rar archive: {}", raw_filename);
-      ar_close_archive(ar);
-      ar_close(stream);
-      return;
-    }
-    enqueue(std::make_unique<VirtFile>(buffer.data(), static_cast<u32>(size), raw_filename, "", file->tag));
+    const size_t size = ar_entry_get_size(archive->ar);
+    const off64_t entryOffset = ar_entry_get_offset(archive->ar);
+    std::string filename = raw_filename;
+
+    auto decompress = [archive, entryOffset, filename, size](std::vector<u8> &buffer) {
+      std::lock_guard lock(archive->mutex);
+      L_INFO("Decompressing file from rar archive: {}", filename);
+      buffer.resize(size);
+      if (!ar_parse_entry_at(archive->ar, entryOffset) ||
+          !ar_entry_uncompress(archive->ar, buffer.data(), size)) {
+        L_ERROR("Error decompressing file from rar archive: {}", filename);
+        return false;
+      }
+      return true;
+    };
+    enqueue(std::make_unique<LazyFile>(filename, size, std::move(decompress), "", file->tag));
   }
-  ar_close_archive(ar);
-  ar_close(stream);
 }
@@ -11,6 +11,6 @@
 class RSNLoader: public FileLoader {
 public:
   RSNLoader() = default;
-  void apply(const RawFile *theFile) override;
+  void apply(const RawFile *theFile) const override;
 
 };
@@ -10,10 +10,10 @@
 #include "LoaderManager.h"
 #include "LogManager.h"
 
-#include <array>
 #include <cstring>
 #include <memory>
 #include <string>
+#include <vector>
 
 // SPC2 file specs available here: http://blog.kevtris.org/blogfiles/spc2_file_specification_v1.txt
 
@@ -21,7 +21,7 @@ namespace vgmtrans::loaders {
 LoaderRegistration<SPC2Loader> _spc2{"SP2"};
 }
 
-void SPC2Loader::apply(const RawFile* file) {
+void SPC2Loader::apply(const RawFile* file) const {
   // Constants
   constexpr size_t HEADER_SIZE = 16;
   constexpr size_t SPC_DATA_BLOCK_SIZE = 1024;
@@ -60,7 +60,7 @@ void SPC2Loader::apply(const RawFile* file) {
     file->readBytes(spcBlockOffset, SPC_DATA_BLOCK_SIZE, spcDataBlock);
 
     // Reconstruct the SPC file's RAM
-    std::array<u8, SPC_FILE_SIZE> spcFile{};
+    std::vector<u8> spcFile(SPC_FILE_SIZE);
 
     // Extract spc file name
     // Find the length of the string up to the first null byte or 28 characters, whichever comes
@@ -93,6 +93,6 @@ void SPC2Loader::apply(const RawFile* file) {
     std::copy(spcDataBlock + 512, spcDataBlock + 640, spcFile.data() + SPC_HEADER_SIZE + SPC_RAM_SIZE);
 
     // Save the reconstructed SPC file
-    enqueue(std::make_unique<VirtFile>(spcFile.data(), SPC_FILE_SIZE, originalSpcFilename, "", file->tag));
+    enqueue(std::make_unique<VirtFile>(std::move(spcFile), originalSpcFilename, "", file->tag));
   }
 }
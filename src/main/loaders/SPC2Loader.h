@@ -12,6 +12,6 @@ class SPC2Loader : public FileLoader {
 public:
   SPC2Loader() = default;
   ~SPC2Loader() override = default;
-  void apply(const RawFile *) override;
+  void apply(const RawFile *) const override;
 };
 
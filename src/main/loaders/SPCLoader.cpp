@@ -16,7 +16,7 @@ namespace vgmtrans::loaders {
 LoaderRegistration<SPCLoader> _spc{"SPC"};
 }
 
-void SPCLoader::apply(const RawFile *file) {
+void SPCLoader::apply(const RawFile *file) const {
   if (file->size() < 0x10180) {
     return;
   }
@@ -31,7 +31,8 @@ void SPCLoader::apply(const RawFile *file) {
 
     auto tag = SPCFile::tagFromSPCFile(spc);
     std::string name = fmt::format("{} - ram", file->name());
-    enqueue(std::make_unique<VirtFile>(spc.ram().data(), spc.ram().size(), name, file->path(), tag));
+    // The RAM image is stored verbatim after the header, so expose it as a slice of the file
+    enqueue(std::make_unique<VirtFile>(*file, 0x100, spc.ram().size(), name, file->path(), tag));
   } catch (const std::exception& e) {
     L_ERROR(e.what());
   }
@@ -10,5 +10,5 @@
 class SPCLoader : public FileLoader {
  public:
     ~SPCLoader() override = default;
-    void apply(const RawFile *) override;
+    void apply(const RawFile *) const override;
 };
@@ -8,13 +8,155 @@
 // Heavily inspired by SigScan at GameDeception.net
 
 #include "BytePattern.h"
+#include "Simd.h"
 
 #include <assert.h>
 #include <cstring>
 #include <memory>
 
+
+namespace {
+
+/**
+ * Rough likelihood of a byte value appearing in console code and sound data (higher is more
+ * common). Zero and 0xff padding dominate, followed by small operands and ASCII.
+ */
+int byteCommonness(u8 b) {
+  if (b == 0x00)
+    return 6;
+  if (b == 0xff)
+    return 5;
+  if (b < 0x10 || b > 0xf0)
+    return 4;
+  if (b < 0x40)
+    return 3;
+  if (b < 0x80)
+    return 2;
+  return 1;
+}
+
+/**
+ * Each search implementation tests the two rare bytes at every candidate offset in
+ * [begin, end) and runs the full masked compare on offsets where both match.
+ */
+struct CandidateFilter {
+  const u8 *buf;
+  size_t buf_len;
+  size_t idx1;
+  size_t idx2;
+  u8 byte1;
+  u8 byte2;
+};
+
+bool searchScalar(const BytePattern &ptn, const CandidateFilter &f, size_t begin, size_t end,
+                  size_t &match_offset) {
+  size_t i = begin;
+  while (i < end) {
+    // memchr is vectorized by the C library on most platforms
+    const void *hit = memchr(f.buf + i + f.idx1, f.byte1, end - i);
+    if (hit == nullptr)
+      return false;
+    i = static_cast<size_t>(static_cast<const u8 *>(hit) - f.buf) - f.idx1;
+    if (f.buf[i + f.idx2] == f.byte2 && ptn.match(f.buf + i, f.buf_len - i)) {
+      match_offset = i;
+      return true;
+    }
+    i++;
+  }
+  return false;
+}
+
+#if VGMTRANS_X86
+
+bool verifyCandidates(const BytePattern &ptn, const CandidateFilter &f, size_t base,
+                      unsigned mask, size_t &match_offset) {
+  while (mask != 0) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long bit;
+    _BitScanForward(&bit, mask);
+#else
+    unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+    const size_t i = base + bit;
+    if (ptn.match(f.buf + i, f.buf_len - i)) {
+      match_offset = i;
+      return true;
+    }
+    mask &= mask - 1;
+  }
+  return false;
+}
+
+bool searchSSE2(const BytePattern &ptn, const CandidateFilter &f, size_t begin, size_t end,
+                size_t &match_offset) {
+  const __m128i first = _mm_set1_epi8(static_cast<char>(f.byte1));
+  const __m128i second = _mm_set1_epi8(static_cast<char>(f.byte2));
+  size_t i = begin;
+  for (; i + 16 <= end; i += 16) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(f.buf + i + f.idx1));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(f.buf + i + f.idx2));
+    const __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, second));
+    const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(eq));
+    if (mask != 0 && verifyCandidates(ptn, f, i, mask, match_offset))
+      return true;
+  }
+  return searchScalar(ptn, f, i, end, match_offset);
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("avx2")))
+#endif
+bool searchAVX2(const BytePattern &ptn, const CandidateFilter &f, size_t begin, size_t end,
+                size_t &match_offset) {
+  const __m256i first = _mm256_set1_epi8(static_cast<char>(f.byte1));
+  const __m256i second = _mm256_set1_epi8(static_cast<char>(f.byte2));
+  size_t i = begin;
+  for (; i + 32 <= end; i += 32) {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(f.buf + i + f.idx1));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(f.buf + i + f.idx2));
+    const __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, second));
+    const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(eq));
+    if (mask != 0 && verifyCandidates(ptn, f, i, mask, match_offset))
+      return true;
+  }
+  return searchSSE2(ptn, f, i, end, match_offset);
+}
+
+bool cpuHasAVX2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+    return false;
+  __cpuidex(info, 1, 0);
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  if (!osxsave || (_xgetbv(0) & 0x6) != 0x6)
+    return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif  // VGMTRANS_X86
+
+using SearchFn = bool (*)(const BytePattern &, const CandidateFilter &, size_t, size_t, size_t &);
+
+SearchFn selectSearchFn() {
+#if VGMTRANS_X86
+  if (cpuHasAVX2())
+    return searchAVX2;
+  return searchSSE2;
+#else
+  return searchScalar;
+#endif
+}
+
+}  // namespace
+
 BytePattern::BytePattern() :
-    ptn_len(0) {
+    ptn_len(0), rare_idx1(npos), rare_idx2(npos) {
 }
 
 BytePattern::BytePattern(const char *pattern, size_t length) :
@@ -25,6 +167,7 @@ BytePattern::BytePattern(const char *pattern, size_t length) :
       memcpy(ptn_str.get(), pattern, length);
     }
   }
+  findRareBytes();
 }
 
 BytePattern::BytePattern(const char *pattern, const char *mask, size_t length) :
@@ -42,10 +185,11 @@ BytePattern::BytePattern(const char *pattern, const char *mask, size_t length) :
       }
     }
   }
+  findRareBytes();
 }
 
 BytePattern::BytePattern(const BytePattern &obj) :
-    ptn_len(obj.ptn_len) {
+    ptn_len(obj.ptn_len), rare_idx1(obj.rare_idx1), rare_idx2(obj.rare_idx2) {
   if (obj.ptn_str != NULL) {
     ptn_str = std::make_unique<char[]>(ptn_len);
     memcpy(ptn_str.get(), obj.ptn_str.get(), ptn_len);
@@ -63,6 +207,8 @@ BytePattern& BytePattern::operator=(const BytePattern& obj) {
   }
 
   ptn_len = obj.ptn_len;
+  rare_idx1 = obj.rare_idx1;
+  rare_idx2 = obj.rare_idx2;
   ptn_str.reset();
   ptn_mask.reset();
 
@@ -110,11 +256,42 @@ bool BytePattern::search(const void *buf, size_t buf_len, size_t &match_offset,
   if (search_offset + ptn_len > buf_len)
     return false;
 
-  for (size_t i = search_offset; i <= buf_len - ptn_len; i++) {
-    if (match((const char *) buf + i, ptn_len)) {
-      match_offset = i;
-      return true;
+  if (rare_idx1 == npos) {
+    // Fully masked: matches anywhere
+    match_offset = search_offset;
+    return true;
+  }
+
+  static const SearchFn searchFn = selectSearchFn();
+  const CandidateFilter filter{static_cast<const u8 *>(buf), buf_len, rare_idx1, rare_idx2,
+                               static_cast<u8>(ptn_str[rare_idx1]), static_cast<u8>(ptn_str[rare_idx2])};
+  return searchFn(*this, filter, search_offset, buf_len - ptn_len + 1, match_offset);
+}
+
+void BytePattern::findRareBytes() {
+  rare_idx1 = npos;
+  rare_idx2 = npos;
+  if (ptn_str == NULL)
+    return;
+
+  int rank1 = 0;
+  int rank2 = 0;
+  for (size_t i = 0; i < ptn_len; i++) {
+    if (ptn_mask != NULL && ptn_mask[i] == '?')
+      continue;
+
+    const int rank = byteCommonness(static_cast<u8>(ptn_str[i]));
+    if (rare_idx1 == npos || rank < rank1) {
+      rare_idx2 = rare_idx1;
+      rank2 = rank1;
+      rare_idx1 = i;
+      rank1 = rank;
+    } else if (rare_idx2 == npos || rank < rank2) {
+      rare_idx2 = i;
+      rank2 = rank;
     }
   }
-  return false;
+
+  if (rare_idx2 == npos)
+    rare_idx2 = rare_idx1;
 }
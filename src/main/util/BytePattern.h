@@ -7,6 +7,9 @@
 #include <memory>
 
 class BytePattern {
+ public:
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
  private:
   /** The pattern to scan for */
   std::unique_ptr<char[]> ptn_str;
@@ -23,6 +26,16 @@ class BytePattern {
   /** The length of ptn_str and ptn_mask (not including a terminating null for ptn_mask) */
   size_t ptn_len;
 
+  /**
+   * Positions of the two least common unmasked bytes, used to filter candidate offsets
+   * before the full masked compare. Equal when the pattern has a single unmasked byte;
+   * npos when it has none.
+   */
+  size_t rare_idx1;
+  size_t rare_idx2;
+
+  void findRareBytes();
+
  public:
   BytePattern();
   BytePattern(const char *pattern, size_t length);
@@ -36,4 +49,8 @@ class BytePattern {
   bool match(const void *buf, size_t buf_len) const;
   bool search(const void *buf, size_t buf_len, size_t &match_offset, size_t search_offset = 0) const;
   inline size_t length() const { return ptn_len; }
+  inline bool isValid() const { return ptn_str != nullptr; }
+  /** Whether the byte at index is ignored by the mask ('?') */
+  inline bool isWildcard(size_t index) const { return ptn_mask != nullptr && ptn_mask[index] == '?'; }
+  inline u8 byteAt(size_t index) const { return static_cast<u8>(ptn_str[index]); }
 };
@@ -0,0 +1,176 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+#include "BytePatternSet.h"
+
+#include "BytePattern.h"
+
+namespace {
+constexpr u32 kNoState = static_cast<u32>(-1);
+}
+
+BytePatternSet::BytePatternSet(std::initializer_list<const BytePattern *> patterns) {
+  m_patterns.reserve(patterns.size());
+
+  // Build a trie of the anchors
+  std::vector<std::vector<u32>> ownOutputs(1);
+  addState();
+  for (const BytePattern *pattern : patterns) {
+    const size_t index = m_patterns.size();
+    m_index.emplace(pattern, index);
+
+    size_t anchorOffset = 0;
+    size_t anchorLength = 0;
+    if (pattern->isValid()) {
+      size_t runStart = 0;
+      for (size_t i = 0; i <= pattern->length(); i++) {
+        if (i < pattern->length() && !pattern->isWildcard(i)) {
+          continue;
+        }
+        if (i - runStart > anchorLength) {
+          anchorOffset = runStart;
+          anchorLength = i - runStart;
+        }
+        runStart = i + 1;
+      }
+    }
+    m_patterns.push_back({pattern, anchorOffset, anchorLength});
+
+    if (anchorLength == 0) {
+      m_unanchored.push_back(index);
+      continue;
+    }
+
+    u32 state = 0;
+    for (size_t i = anchorOffset; i < anchorOffset + anchorLength; i++) {
+      const size_t slot = state * 256 + pattern->byteAt(i);
+      u32 next = m_transitions[slot];
+      if (next == kNoState) {
+        next = addState();
+        m_transitions[slot] = next;
+        ownOutputs.emplace_back();
+      }
+      state = next;
+    }
+    ownOutputs[state].push_back(static_cast<u32>(index));
+  }
+
+  // Resolve failure links breadth-first, turning the trie into a complete DFA and merging each
+  // state's outputs with those of its failure state
+  const size_t stateCount = ownOutputs.size();
+  std::vector<u32> fail(stateCount, 0);
+  std::vector<std::vector<u32>> outputs(stateCount);
+  std::vector<u32> queue;
+  queue.reserve(stateCount);
+
+  for (size_t b = 0; b < 256; b++) {
+    u32 &next = m_transitions[b];
+    if (next == kNoState) {
+      next = 0;
+    } else {
+      queue.push_back(next);
+    }
+  }
+
+  for (size_t head = 0; head < queue.size(); head++) {
+    const u32 state = queue[head];
+    outputs[state] = ownOutputs[state];
+    const auto &inherited = outputs[fail[state]];
+    outputs[state].insert(outputs[state].end(), inherited.begin(), inherited.end());
+
+    for (size_t b = 0; b < 256; b++) {
+      u32 &next = m_transitions[state * 256 + b];
+      const u32 fallback = m_transitions[fail[state] * 256 + b];
+      if (next == kNoState) {
+        next = fallback;
+      } else {
+        fail[next] = fallback;
+        queue.push_back(next);
+      }
+    }
+  }
+
+  m_outputStart.reserve(stateCount + 1);
+  for (const auto &stateOutputs : outputs) {
+    m_outputStart.push_back(static_cast<u32>(m_outputs.size()));
+    m_outputs.insert(m_outputs.end(), stateOutputs.begin(), stateOutputs.end());
+  }
+  m_outputStart.push_back(static_cast<u32>(m_outputs.size()));
+}
+
+u32 BytePatternSet::addState() {
+  const u32 state = static_cast<u32>(m_transitions.size() / 256);
+  m_transitions.resize(m_transitions.size() + 256, kNoState);
+  return state;
+}
+
+size_t BytePatternSet::indexOf(const BytePattern &pattern) const {
+  auto it = m_index.find(&pattern);
+  return it != m_index.end() ? it->second : npos;
+}
+
+std::vector<size_t> BytePatternSet::search(const void *buf, size_t buf_len,
+                                           size_t search_offset) const {
+  std::vector<size_t> offsets(m_patterns.size(), npos);
+  if (buf == nullptr || search_offset >= buf_len) {
+    return offsets;
+  }
+
+  for (size_t index : m_unanchored) {
+    size_t match_offset;
+    if (m_patterns[index].pattern->search(buf, buf_len, match_offset, search_offset)) {
+      offsets[index] = match_offset;
+    }
+  }
+
+  size_t remaining = m_patterns.size() - m_unanchored.size();
+  const u8 *data = static_cast<const u8 *>(buf);
+  u32 state = 0;
+  for (size_t i = search_offset; i < buf_len && remaining > 0; i++) {
+    state = m_transitions[state * 256 + data[i]];
+    for (u32 o = m_outputStart[state]; o < m_outputStart[state + 1]; o++) {
+      const u32 index = m_outputs[o];
+      if (offsets[index] != npos) {
+        continue;
+      }
+
+      // Hits arrive in order of anchor end, so the first verified hit is the earliest match
+      const Entry &entry = m_patterns[index];
+      const size_t anchorEnd = entry.anchorOffset + entry.anchorLength;
+      if (i + 1 < search_offset + anchorEnd) {
+        continue;
+      }
+      const size_t start = i + 1 - anchorEnd;
+      if (entry.pattern->match(data + start, buf_len - start)) {
+        offsets[index] = start;
+        remaining--;
+      }
+    }
+  }
+  return offsets;
+}
+
+BytePatternMatches::BytePatternMatches(const BytePatternSet &set, const void *buf, size_t buf_len)
+    : m_set(set), m_buf(buf), m_bufLength(buf_len), m_offsets(set.search(buf, buf_len)) {
+}
+
+bool BytePatternMatches::find(const BytePattern &pattern, u32 &match_offset) const {
+  const size_t index = m_set.indexOf(pattern);
+  if (index == BytePatternSet::npos) {
+    size_t offset;
+    if (!pattern.search(m_buf, m_bufLength, offset)) {
+      return false;
+    }
+    match_offset = static_cast<u32>(offset);
+    return true;
+  }
+
+  if (m_offsets[index] == BytePatternSet::npos) {
+    return false;
+  }
+  match_offset = static_cast<u32>(m_offsets[index]);
+  return true;
+}
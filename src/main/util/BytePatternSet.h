@@ -0,0 +1,74 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+// Multi-pattern search over a set of BytePatterns.
+// Every pattern is anchored on its longest run of unmasked bytes. The anchors are compiled into
+// an Aho-Corasick automaton so that a single pass over a buffer locates the first occurrence of
+// every pattern in the set; each anchor hit is then verified against the full masked pattern.
+
+#pragma once
+#include "base/Types.h"
+
+#include <cstddef>
+#include <initializer_list>
+#include <unordered_map>
+#include <vector>
+
+class BytePattern;
+class BytePatternMatches;
+
+class BytePatternSet {
+ public:
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  // The set references the patterns; they must outlive it (typically they are static members)
+  BytePatternSet(std::initializer_list<const BytePattern *> patterns);
+
+  // Returns the offset of the first match of each pattern at or after search_offset, indexed
+  // in the order the patterns were given. Patterns with no match are set to npos.
+  std::vector<size_t> search(const void *buf, size_t buf_len, size_t search_offset = 0) const;
+
+  // Position of the pattern in the set, or npos if it was not part of it
+  size_t indexOf(const BytePattern &pattern) const;
+  const BytePattern &pattern(size_t index) const { return *m_patterns[index].pattern; }
+  size_t size() const { return m_patterns.size(); }
+
+ private:
+  struct Entry {
+    const BytePattern *pattern;
+    size_t anchorOffset;
+    size_t anchorLength;
+  };
+
+  u32 addState();
+
+  std::vector<Entry> m_patterns;
+  std::unordered_map<const BytePattern *, size_t> m_index;
+  // Patterns without any fixed byte to anchor on; these are searched individually
+  std::vector<size_t> m_unanchored;
+
+  // Dense DFA: m_transitions[state * 256 + byte] is the next state
+  std::vector<u32> m_transitions;
+  // Patterns whose anchor ends at each state, including those reachable through failure links
+  std::vector<u32> m_outputStart;
+  std::vector<u32> m_outputs;
+};
+
+// First-match results of a BytePatternSet search, usable as a drop-in for repeated
+// RawFile::searchBytePattern calls. Patterns that weren't part of the set fall back to a
+// regular linear search over the same buffer.
+class BytePatternMatches {
+ public:
+  BytePatternMatches(const BytePatternSet &set, const void *buf, size_t buf_len);
+
+  bool find(const BytePattern &pattern, u32 &match_offset) const;
+
+ private:
+  const BytePatternSet &m_set;
+  const void *m_buf;
+  size_t m_bufLength;
+  std::vector<size_t> m_offsets;
+};
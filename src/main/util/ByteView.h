@@ -0,0 +1,113 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+// Non-owning, non-virtual view over a byte buffer for scanner hot loops.
+// RawFile's readers are virtual and assemble values a byte at a time. A ByteView (see
+// RawFile::view) loads values with a single inlineable memcpy instead. The read* functions
+// return std::nullopt when a value would run past the end of the view, while the load*
+// functions leave range checking to the caller.
+
+#pragma once
+#include "base/Types.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+
+class ByteView {
+ public:
+  constexpr ByteView() noexcept = default;
+  constexpr ByteView(const u8 *data, size_t size) noexcept : m_data(data), m_size(size) {}
+
+  [[nodiscard]] const u8 *data() const noexcept { return m_data; }
+  [[nodiscard]] size_t size() const noexcept { return m_size; }
+  [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+  // True if [offset, offset + length) lies within the view
+  [[nodiscard]] bool contains(size_t offset, size_t length) const noexcept {
+    return offset <= m_size && length <= m_size - offset;
+  }
+
+  template <typename T>
+  [[nodiscard]] T load(size_t offset) const noexcept {
+    static_assert(std::is_integral_v<T>);
+    T value;
+    memcpy(&value, m_data + offset, sizeof(T));
+    if constexpr (std::endian::native == std::endian::big) {
+      value = byteSwap(value);
+    }
+    return value;
+  }
+
+  template <typename T>
+  [[nodiscard]] T loadBE(size_t offset) const noexcept {
+    static_assert(std::is_integral_v<T>);
+    T value;
+    memcpy(&value, m_data + offset, sizeof(T));
+    if constexpr (std::endian::native == std::endian::little) {
+      value = byteSwap(value);
+    }
+    return value;
+  }
+
+  template <typename T>
+  [[nodiscard]] std::optional<T> read(size_t offset) const noexcept {
+    if (!contains(offset, sizeof(T)))
+      return std::nullopt;
+    return load<T>(offset);
+  }
+
+  template <typename T>
+  [[nodiscard]] std::optional<T> readBE(size_t offset) const noexcept {
+    if (!contains(offset, sizeof(T)))
+      return std::nullopt;
+    return loadBE<T>(offset);
+  }
+
+  [[nodiscard]] std::optional<u8> readByte(size_t offset) const noexcept { return read<u8>(offset); }
+  [[nodiscard]] std::optional<u16> readShort(size_t offset) const noexcept { return read<u16>(offset); }
+  [[nodiscard]] std::optional<u32> readWord(size_t offset) const noexcept { return read<u32>(offset); }
+  [[nodiscard]] std::optional<u16> readShortBE(size_t offset) const noexcept { return readBE<u16>(offset); }
+  [[nodiscard]] std::optional<u32> readWordBE(size_t offset) const noexcept { return readBE<u32>(offset); }
+
+  // True if the view holds exactly `length` bytes of `bytes` at offset
+  [[nodiscard]] bool matches(size_t offset, const void *bytes, size_t length) const noexcept {
+    return contains(offset, length) && memcmp(m_data + offset, bytes, length) == 0;
+  }
+
+  [[nodiscard]] std::optional<ByteView> subview(size_t offset, size_t length) const noexcept {
+    if (!contains(offset, length))
+      return std::nullopt;
+    return ByteView(m_data + offset, length);
+  }
+
+  template <typename T>
+  static constexpr T byteSwap(T value) noexcept {
+    using U = std::make_unsigned_t<T>;
+#if defined(__GNUC__) || defined(__clang__)
+    if constexpr (sizeof(T) == 2) {
+      return static_cast<T>(__builtin_bswap16(static_cast<U>(value)));
+    } else if constexpr (sizeof(T) == 4) {
+      return static_cast<T>(__builtin_bswap32(static_cast<U>(value)));
+    } else if constexpr (sizeof(T) == 8) {
+      return static_cast<T>(__builtin_bswap64(static_cast<U>(value)));
+    }
+#endif
+    U in = static_cast<U>(value);
+    U out = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+      out = static_cast<U>((out << 8) | (in & 0xFF));
+      in = static_cast<U>(in >> 8);
+    }
+    return static_cast<T>(out);
+  }
+
+ private:
+  const u8 *m_data = nullptr;
+  size_t m_size = 0;
+};
@@ -0,0 +1,103 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+#include "MagicIndex.h"
+#include "Simd.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+namespace {
+
+constexpr size_t kMagicLength = 4;
+
+u32 loadKey(const u8 *p) {
+  u32 key;
+  memcpy(&key, p, sizeof(key));
+  return key;
+}
+
+struct MagicKeys {
+  std::array<u32, MagicIndex::magics.size()> keys{};
+  // Distinct leading bytes of the magics, used to find candidate offsets
+  std::array<u8, MagicIndex::magics.size()> leads{};
+  size_t leadCount = 0;
+
+  MagicKeys() {
+    for (size_t m = 0; m < MagicIndex::magics.size(); m++) {
+      const auto magic = MagicIndex::magics[m];
+      assert(magic.size() == kMagicLength);
+      keys[m] = loadKey(reinterpret_cast<const u8 *>(magic.data()));
+      const u8 lead = static_cast<u8>(magic[0]);
+      if (std::find(leads.begin(), leads.begin() + leadCount, lead) == leads.begin() + leadCount) {
+        leads[leadCount++] = lead;
+      }
+    }
+  }
+};
+
+const MagicKeys &magicKeys() {
+  static const MagicKeys keys;
+  return keys;
+}
+
+}  // namespace
+
+MagicIndex::MagicIndex(const u8 *data, size_t size) {
+  if (data == nullptr || size < kMagicLength) {
+    return;
+  }
+
+  const MagicKeys &mk = magicKeys();
+  const size_t last = size - kMagicLength;  // last offset a magic can start at
+
+  auto check = [&](size_t i) {
+    const u32 key = loadKey(data + i);
+    for (size_t m = 0; m < mk.keys.size(); m++) {
+      if (key == mk.keys[m]) {
+        m_offsets[m].push_back(static_cast<u32>(i));
+        return;
+      }
+    }
+  };
+
+  size_t i = 0;
+#if VGMTRANS_SSE2
+  // Compare 16 offsets at a time against every leading byte; the full key is only checked at
+  // offsets where one of them matched
+  __m128i leads[magics.size()];
+  for (size_t l = 0; l < mk.leadCount; l++) {
+    leads[l] = _mm_set1_epi8(static_cast<char>(mk.leads[l]));
+  }
+  for (; i + 16 <= last + 1; i += 16) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    __m128i hits = _mm_cmpeq_epi8(block, leads[0]);
+    for (size_t l = 1; l < mk.leadCount; l++) {
+      hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, leads[l]));
+    }
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+    while (mask != 0) {
+      check(i + std::countr_zero(mask));
+      mask &= mask - 1;
+    }
+  }
+#endif
+  for (; i <= last; i++) {
+    check(i);
+  }
+}
+
+const std::vector<u32> &MagicIndex::offsets(std::string_view magic) const {
+  const auto it = std::find(magics.begin(), magics.end(), magic);
+  assert(it != magics.end() && "magic is not part of the index");
+  if (it == magics.end()) {
+    static const std::vector<u32> none;
+    return none;
+  }
+  return m_offsets[it - magics.begin()];
+}
@@ -0,0 +1,38 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+// Index of the offsets of a fixed set of 4-byte magic numbers within a buffer.
+// Many scanners look for a format signature at every offset of a file. The index finds all of
+// the registered signatures in one pass so those scanners only visit the offsets that matter.
+// RawFile builds one on first use (RawFile::magicIndex) and shares it between scanners.
+
+#pragma once
+#include "base/Types.h"
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+class MagicIndex {
+ public:
+  // The magic numbers gathered by the index, as they appear in the file
+  static constexpr std::array<std::string_view, 5> magics = {
+    "pQES",  // PS1 SEQ ("SEQp" stored little-endian)
+    "pBAV",  // PS1 VAB ("VABp" stored little-endian)
+    "SDAT",  // NDS sound data archive
+    "IECS",  // PS2 "SCEI" chunk headers, stored little-endian
+    "AKAO",  // Square Akao sequences and sample collections
+  };
+
+  MagicIndex(const u8 *data, size_t size);
+
+  // Ascending offsets of every occurrence of the magic, which must be one of `magics`
+  [[nodiscard]] const std::vector<u32> &offsets(std::string_view magic) const;
+
+ private:
+  std::array<std::vector<u32>, magics.size()> m_offsets;
+};
@@ -0,0 +1,81 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+// Set of u32 values (typically file offsets) stored as a bitmap split into fixed-size pages.
+// Pages are only allocated for the regions that are actually used, and a dense directory maps
+// page numbers to them, so lookups cost a couple of indexed loads and no hashing. clear() keeps
+// the pages around for the next use.
+
+#pragma once
+#include "base/Types.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+class PagedBitset {
+ public:
+  // Adds value to the set. Returns true if it wasn't in the set yet
+  bool insert(u32 value) {
+    u64 &word = wordFor(value);
+    const u64 mask = bitFor(value);
+    if (word & mask)
+      return false;
+    word |= mask;
+    return true;
+  }
+
+  [[nodiscard]] bool contains(u32 value) const noexcept {
+    const u32 page = value / PAGE_BITS;
+    if (page < m_firstPage || page - m_firstPage >= m_directory.size())
+      return false;
+    const u32 slot = m_directory[page - m_firstPage];
+    return slot != NO_PAGE && (m_pages[slot][(value % PAGE_BITS) / 64] & bitFor(value));
+  }
+
+  void clear() noexcept {
+    for (size_t i = 0; i < m_usedPages; ++i) {
+      m_pages[i].fill(0);
+    }
+    m_usedPages = 0;
+    m_directory.clear();
+  }
+
+ private:
+  static constexpr u32 PAGE_BITS = 4096;
+  static constexpr u32 NO_PAGE = static_cast<u32>(-1);
+  using Page = std::array<u64, PAGE_BITS / 64>;
+
+  static constexpr u64 bitFor(u32 value) noexcept { return u64{1} << (value % 64); }
+
+  u64 &wordFor(u32 value) {
+    const u32 page = value / PAGE_BITS;
+    if (m_directory.empty()) {
+      m_firstPage = page;
+      m_directory.push_back(NO_PAGE);
+    } else if (page < m_firstPage) {
+      m_directory.insert(m_directory.begin(), m_firstPage - page, NO_PAGE);
+      m_firstPage = page;
+    } else if (page - m_firstPage >= m_directory.size()) {
+      m_directory.resize(page - m_firstPage + 1, NO_PAGE);
+    }
+
+    u32 &slot = m_directory[page - m_firstPage];
+    if (slot == NO_PAGE) {
+      if (m_usedPages == m_pages.size()) {
+        m_pages.emplace_back();
+      }
+      slot = static_cast<u32>(m_usedPages++);
+    }
+    return m_pages[slot][(value % PAGE_BITS) / 64];
+  }
+
+  std::vector<u32> m_directory;
+  u32 m_firstPage = 0;
+  // Zeroed pages past m_usedPages are kept for reuse
+  std::vector<Page> m_pages;
+  size_t m_usedPages = 0;
+};
@@ -0,0 +1,78 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace vgmtrans {
+
+// Number of worker threads to use when the caller doesn't specify one.
+inline unsigned defaultThreadCount() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+namespace detail {
+inline thread_local bool t_inParallelFor = false;
+}
+
+// Invokes fn(i) for every i in [0, count), spreading the calls over up to maxThreads threads
+// (the calling thread included). Indices are handed out in ascending order, but calls may
+// complete in any order. If any call throws, the remaining indices are still processed and the
+// first captured exception is rethrown once every thread has finished.
+// A parallelFor nested in another one runs serially on the calling worker, so nested
+// parallelism never uses more threads than the outermost loop was given.
+template <typename Fn>
+void parallelFor(size_t count, unsigned maxThreads, Fn&& fn) {
+  const size_t threadCount = std::min<size_t>(count, std::max(1u, maxThreads));
+  if (threadCount <= 1 || detail::t_inParallelFor) {
+    for (size_t i = 0; i < count; ++i) {
+      fn(i);
+    }
+    return;
+  }
+
+  std::atomic<size_t> nextIndex{0};
+  std::exception_ptr firstError;
+  std::mutex errorMutex;
+
+  auto worker = [&]() {
+    const bool wasInParallelFor = std::exchange(detail::t_inParallelFor, true);
+    for (size_t i = nextIndex++; i < count; i = nextIndex++) {
+      try {
+        fn(i);
+      } catch (...) {
+        std::lock_guard lock(errorMutex);
+        if (!firstError) {
+          firstError = std::current_exception();
+        }
+      }
+    }
+    detail::t_inParallelFor = wasInParallelFor;
+  };
+
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(threadCount - 1);
+    for (size_t t = 1; t < threadCount; ++t) {
+      threads.emplace_back(worker);
+    }
+    worker();
+  }
+
+  if (firstError) {
+    std::rethrow_exception(firstError);
+  }
+}
+
+}  // namespace vgmtrans
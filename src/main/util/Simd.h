@@ -0,0 +1,28 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+#pragma once
+
+// SSE2 code paths are compiled in when the target guarantees SSE2 (any x86-64 build, or a
+// 32-bit build compiled for it). Code using them keeps a scalar fallback under #else.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VGMTRANS_SSE2 1
+#include <emmintrin.h>
+#else
+#define VGMTRANS_SSE2 0
+#endif
+
+// Wider x86 instruction sets can only be used behind a runtime CPU check. They are available
+// to such code on the same targets as SSE2, which it falls back to.
+#if VGMTRANS_SSE2
+#define VGMTRANS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#else
+#define VGMTRANS_X86 0
+#endif
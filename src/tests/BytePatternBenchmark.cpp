@@ -0,0 +1,153 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+// Compares RawFile::searchBytePattern, which runs on the vectorized BytePattern::search, with
+// the per-offset BytePattern::match loop it replaced. Usage: bytepattern-bench [size in MiB]
+// Exits with a non-zero status if any search result differs from the reference loop.
+
+#include "BytePattern.h"
+#include "RawFile.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct NamedPattern {
+  const char *name;
+  BytePattern pattern;
+};
+
+// Scanner-style patterns: SPC700 driver code with operand addresses masked out
+std::vector<NamedPattern> makePatterns() {
+  std::vector<NamedPattern> patterns;
+  patterns.push_back({"note length table", BytePattern("\xc0\x60\x30\x18\x0c\x06\x03\x01", "xxxxxxxx", 8)});
+  patterns.push_back({"masked code, 32 bytes",
+                      BytePattern("\xf6\x6b\x0f\xc4\x0d\xfc\xf6\x6b"
+                                  "\x0f\xc4\x0e\x2f\xd8\xf6\x6b\x0f"
+                                  "\xc4\x0f\xfc\xf6\x6b\x0f\xc4\x10"
+                                  "\x2f\xcb\xf6\x6b\x0f\xc5\x4b\x01",
+                                  "x??x?xx?"
+                                  "?x?x?x??"
+                                  "x?xx??x?"
+                                  "x?x??x??",
+                                  32)});
+  patterns.push_back({"common bytes", BytePattern("\x00\x00\xff\x00\x01", "xxxx?", 5)});
+  patterns.push_back({"single fixed byte", BytePattern("\x8f\x00\x00", "x??", 3)});
+  return patterns;
+}
+
+// ROM-like contents: zero and 0xff padding runs between stretches of code-like bytes
+std::vector<u8> makeRom(size_t size, const std::vector<NamedPattern> &patterns) {
+  std::mt19937 rng(0x5eed);
+  std::vector<u8> rom(size);
+  size_t pos = 0;
+  while (pos < size) {
+    const size_t run = std::min<size_t>(size - pos, 16 + rng() % 4096);
+    const u32 kind = rng() % 4;
+    for (size_t i = 0; i < run; i++) {
+      rom[pos + i] = kind == 0 ? 0x00 : kind == 1 ? 0xff : static_cast<u8>(rng() % 0xf0);
+    }
+    pos += run;
+  }
+
+  // Plant a few copies of each pattern in the second half, including one touching the end
+  for (const auto &[name, pattern] : patterns) {
+    for (int copy = 0; copy < 3; copy++) {
+      const size_t at = copy == 2 ? size - pattern.length()
+                                  : size / 2 + rng() % (size / 2 - pattern.length());
+      for (size_t i = 0; i < pattern.length(); i++) {
+        if (!pattern.isWildcard(i))
+          rom[at + i] = pattern.byteAt(i);
+      }
+    }
+  }
+  return rom;
+}
+
+// The search loop RawFile::searchBytePattern used before it delegated to BytePattern::search
+bool referenceSearch(const RawFile &file, const BytePattern &pattern, u32 &matchOffset,
+                     u32 searchOffset) {
+  if (searchOffset >= file.size() || file.size() - searchOffset < pattern.length())
+    return false;
+  for (size_t offset = searchOffset; offset < file.size() - pattern.length(); offset++) {
+    if (file.matchBytePattern(pattern, offset)) {
+      matchOffset = static_cast<u32>(offset);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Finds every match by restarting the search just past the previous one
+template <typename Search>
+std::vector<u32> findAll(Search search) {
+  std::vector<u32> matches;
+  u32 offset = 0;
+  u32 match;
+  while (search(match, offset)) {
+    matches.push_back(match);
+    offset = match + 1;
+  }
+  return matches;
+}
+
+template <typename Fn>
+double timeMs(Fn fn) {
+  const auto start = std::chrono::steady_clock::now();
+  fn();
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t sizeMiB = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 16;
+  const auto patterns = makePatterns();
+  std::vector<u8> rom = makeRom(std::max<size_t>(sizeMiB, 1) * 1024 * 1024, patterns);
+  VirtFile file(std::move(rom), "rom.bin");
+
+  int failures = 0;
+  std::printf("%zu MiB ROM\n", file.size() / (1024 * 1024));
+  for (const auto &[name, pattern] : patterns) {
+    std::vector<u32> expected;
+    std::vector<u32> actual;
+    const double referenceMs = timeMs([&] {
+      expected = findAll([&](u32 &match, u32 offset) {
+        return referenceSearch(file, pattern, match, offset);
+      });
+    });
+    const double searchMs = timeMs([&] {
+      actual = findAll([&](u32 &match, u32 offset) {
+        return file.searchBytePattern(pattern, match, offset);
+      });
+    });
+
+    const bool same = actual == expected;
+    failures += same ? 0 : 1;
+    std::printf("%-22s %6zu matches  match loop %9.2f ms  search %8.2f ms  %5.1fx%s\n", name,
+                expected.size(), referenceMs, searchMs, referenceMs / std::max(searchMs, 0.001),
+                same ? "" : "  MISMATCH");
+  }
+
+  // Bounded searches must not report matches running past the end of the range
+  const BytePattern &bounded = patterns[0].pattern;
+  u32 first = 0;
+  if (file.searchBytePattern(bounded, first)) {
+    u32 match;
+    const bool cutShort = file.searchBytePattern(bounded, match, first, static_cast<u32>(bounded.length()));
+    const bool oneSpare = file.searchBytePattern(bounded, match, first, static_cast<u32>(bounded.length() + 1));
+    if (cutShort || !oneSpare || match != first) {
+      std::printf("bounded search returned the wrong result\n");
+      failures++;
+    }
+  }
+
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,244 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+// Compares the FFT "wds" and TriAce "SLZ" scanner loops reading through ByteView with the same
+// loops reading through the virtual, byte-at-a-time RawFile accessors they replaced.
+// Usage: byteview-bench [size in MiB]
+// Also checks ByteView's little and big endian loads against values assembled by hand, and that
+// the checked readers refuse every read running past the end of the view. Exits with a non-zero
+// status on any mismatch.
+
+#include "ByteView.h"
+#include "RawFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+// RawFile::get and RawFile::getBE as they were before they read through a ByteView
+template <typename T>
+T referenceGet(const RawFile &file, size_t ind) {
+  T value = 0;
+  for (size_t i = 0; i < sizeof(T); i++) {
+    value |= static_cast<T>(static_cast<T>(static_cast<u8>(file[ind + i])) << (i * CHAR_BIT));
+  }
+  return value;
+}
+
+template <typename T>
+T referenceGetBE(const RawFile &file, size_t ind) {
+  T value = 0;
+  for (size_t i = 0; i < sizeof(T); i++) {
+    value |= static_cast<T>(static_cast<T>(static_cast<u8>(file[ind + i])) << ((sizeof(T) - i - 1) * CHAR_BIT));
+  }
+  return value;
+}
+
+void put32(std::vector<u8> &buf, size_t at, u32 value) {
+  memcpy(buf.data() + at, &value, sizeof(value));
+}
+
+void plantWds(std::vector<u8> &corpus, size_t at, u32 hdrSize) {
+  memcpy(corpus.data() + at, "dwds", 4);
+  put32(corpus, at + 0x10, hdrSize);
+  put32(corpus, at + 0x14, 0x8000);
+  memset(corpus.data() + at + hdrSize, 0, std::min<size_t>(0x10, corpus.size() - at - hdrSize));
+}
+
+// Mostly zeros with random bytes in between, and planted wds and SLZ headers that pass the
+// scanners' checks. The last wds header is as close to the end as the scanner looks, with its
+// zeroed sample section ending on the last byte
+std::vector<u8> makeCorpus(size_t size) {
+  std::mt19937 rng(0x5eed);
+  std::vector<u8> corpus(size);
+  for (auto &byte : corpus) {
+    byte = rng() % 4 == 0 ? static_cast<u8>(rng()) : 0;
+  }
+
+  for (int i = 0; i < 2000; i++) {
+    const size_t at = rng() % (size - 0x100);
+    if (i % 2 == 0) {
+      plantWds(corpus, at, 0x20);
+    } else {
+      memcpy(corpus.data() + at, "SLZ", 3);
+      corpus[at + 3] = static_cast<u8>(rng() % 4);
+      put32(corpus, at + 4, 0x1000);
+      put32(corpus, at + 8, 0x2000);
+      put32(corpus, at + 12, 0x1000);
+      corpus[at + 0x11] = 0xff;
+      corpus[at + 0x12] = 0xff;
+    }
+  }
+  plantWds(corpus, size - 0x31, 0x21);
+  return corpus;
+}
+
+// The candidate checks of FFTScanner::searchForFFTwds
+std::vector<u32> referenceWdsScan(const RawFile &file) {
+  std::vector<u32> hits;
+  for (u32 i = 0; i + 0x30 < file.size(); i++) {
+    const u32 sig = referenceGetBE<u32>(file, i);
+    if (sig != 0x64776473 && sig != 0x77647320)
+      continue;
+    if (referenceGet<u32>(file, i + 0x14) > 0x100000)
+      continue;
+    const u32 hdrSize = referenceGet<u32>(file, i + 0x10);
+    if (hdrSize > file.size() - i || file.size() - i - hdrSize < 0x10)
+      continue;
+    bool zeros = true;
+    for (size_t z = 0; z < 0x10; z += 4) {
+      zeros &= referenceGet<u32>(file, i + hdrSize + z) == 0;
+    }
+    if (zeros)
+      hits.push_back(i);
+  }
+  return hits;
+}
+
+std::vector<u32> wdsScan(const RawFile &file) {
+  std::vector<u32> hits;
+  const ByteView view = file.view();
+  for (u32 i = 0; i + 0x30 < view.size(); i++) {
+    const u32 sig = view.loadBE<u32>(i);
+    if (sig != 0x64776473 && sig != 0x77647320)
+      continue;
+    if (view.load<u32>(i + 0x14) > 0x100000)
+      continue;
+    const u32 hdrSize = view.load<u32>(i + 0x10);
+    static constexpr u8 zeros[0x10] = {};
+    if (view.matches(static_cast<size_t>(i) + hdrSize, zeros, sizeof(zeros)))
+      hits.push_back(i);
+  }
+  return hits;
+}
+
+// The candidate checks of TriAcePS1Scanner::searchForSLZSeq
+template <typename GetBE, typename Get16, typename Get32>
+std::vector<u32> slzScan(size_t size, GetBE getBE, Get16 get16, Get32 get32) {
+  std::vector<u32> hits;
+  for (u32 i = 0; i + 0x40 < size; i++) {
+    const u32 sig = getBE(i);
+    if (sig >> 8 != 0x534C5A || (sig & 0xFF) > 0x03)
+      continue;
+    if (get16(i + 0x11) != 0xFFFF)
+      continue;
+    const u32 size1 = get32(i + 4);
+    const u32 size2 = get32(i + 8);
+    const u32 size3 = get32(i + 12);
+    if (size1 > 0x30000 || size2 > 0x30000 || size3 > 0x30000)
+      continue;
+    if (size1 > size2 || size3 > size2)
+      continue;
+    hits.push_back(i);
+  }
+  return hits;
+}
+
+template <typename Fn>
+double timeMs(Fn fn) {
+  const auto start = std::chrono::steady_clock::now();
+  fn();
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename T>
+bool checkLoads(const ByteView &view) {
+  for (size_t offset = 0; offset + sizeof(T) <= view.size(); offset++) {
+    using U = std::make_unsigned_t<T>;
+    U le = 0;
+    U be = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+      le |= static_cast<U>(static_cast<U>(view.data()[offset + i]) << (i * CHAR_BIT));
+      be = static_cast<U>((be << CHAR_BIT) | view.data()[offset + i]);
+    }
+    if (view.load<T>(offset) != static_cast<T>(le) || view.loadBE<T>(offset) != static_cast<T>(be) ||
+        view.read<T>(offset) != static_cast<T>(le) || view.readBE<T>(offset) != static_cast<T>(be)) {
+      std::printf("%zu-byte load at %zu differs from the value assembled by hand\n", sizeof(T), offset);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Every read that would run past the end must be refused, including offsets near SIZE_MAX
+template <typename T>
+bool checkEdges(const ByteView &view) {
+  constexpr size_t far = std::numeric_limits<size_t>::max();
+  const size_t last = view.size() - sizeof(T);
+  const bool ok = view.read<T>(last).has_value() && view.readBE<T>(last).has_value() &&
+                  !view.read<T>(last + 1) && !view.readBE<T>(last + 1) && !view.read<T>(view.size()) &&
+                  !view.read<T>(far) && !view.readBE<T>(far - sizeof(T) + 1) &&
+                  !ByteView(view.data(), sizeof(T) - 1).read<T>(0);
+  if (!ok) {
+    std::printf("%zu-byte read at the end of the view was not range checked\n", sizeof(T));
+  }
+  return ok;
+}
+
+bool checkView() {
+  std::vector<u8> bytes(37);
+  for (size_t i = 0; i < bytes.size(); i++) {
+    bytes[i] = static_cast<u8>(0x80 + i * 7);
+  }
+  const ByteView view(bytes.data(), bytes.size());
+  bool ok = checkLoads<u8>(view) && checkLoads<u16>(view) && checkLoads<u32>(view) &&
+            checkLoads<u64>(view) && checkLoads<s16>(view) && checkLoads<s32>(view);
+  ok &= checkEdges<u8>(view) && checkEdges<u16>(view) && checkEdges<u32>(view) && checkEdges<u64>(view);
+
+  const u8 tail[] = {bytes[35], bytes[36]};
+  if (!view.matches(35, tail, 2) || view.matches(36, tail, 2) || view.matches(38, tail, 0) ||
+      !view.subview(35, 2) || view.subview(36, 2) || view.subview(2, std::numeric_limits<size_t>::max())) {
+    std::printf("matches or subview at the end of the view was not range checked\n");
+    ok = false;
+  }
+  return ok;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t sizeMiB = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+  VirtFile file(makeCorpus(std::max<size_t>(sizeMiB, 1) * 1024 * 1024), "corpus.bin");
+
+  int failures = checkView() ? 0 : 1;
+  std::printf("%zu MiB corpus\n", file.size() / (1024 * 1024));
+
+  std::vector<u32> expected;
+  std::vector<u32> actual;
+  double referenceMs = timeMs([&] { expected = referenceWdsScan(file); });
+  double viewMs = timeMs([&] { actual = wdsScan(file); });
+  bool same = actual == expected;
+  failures += same ? 0 : 1;
+  std::printf("%-16s %5zu hits  RawFile reads %8.2f ms  ByteView %8.2f ms  %5.1fx%s\n", "FFT wds scan",
+              expected.size(), referenceMs, viewMs, referenceMs / std::max(viewMs, 0.001), same ? "" : "  MISMATCH");
+
+  const ByteView view = file.view();
+  referenceMs = timeMs([&] {
+    expected = slzScan(
+        file.size(), [&](size_t i) { return referenceGetBE<u32>(file, i); },
+        [&](size_t i) { return referenceGet<u16>(file, i); }, [&](size_t i) { return referenceGet<u32>(file, i); });
+  });
+  viewMs = timeMs([&] {
+    actual = slzScan(
+        view.size(), [&](size_t i) { return view.loadBE<u32>(i); }, [&](size_t i) { return view.load<u16>(i); },
+        [&](size_t i) { return view.load<u32>(i); });
+  });
+  same = actual == expected;
+  failures += same ? 0 : 1;
+  std::printf("%-16s %5zu hits  RawFile reads %8.2f ms  ByteView %8.2f ms  %5.1fx%s\n", "TriAce SLZ scan",
+              expected.size(), referenceMs, viewMs, referenceMs / std::max(viewMs, 0.001), same ? "" : "  MISMATCH");
+
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
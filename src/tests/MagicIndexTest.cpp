@@ -0,0 +1,125 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+// Checks MagicIndex, which looks for candidate offsets 16 bytes at a time with SSE2 where
+// available, against a memcmp at every offset. Buffers of every length up to a few blocks cover
+// the switch from the vector loop to the per-offset tail, and magics are planted across 16-byte
+// block boundaries, at the first and last possible offset, and back to back.
+// Exits with a non-zero status on the first mismatch.
+
+#include "MagicIndex.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr size_t MAGIC_LENGTH = 4;
+
+std::vector<u32> referenceOffsets(const u8 *data, size_t size, std::string_view magic) {
+  std::vector<u32> offsets;
+  for (size_t i = 0; i + MAGIC_LENGTH <= size; i++) {
+    if (memcmp(data + i, magic.data(), MAGIC_LENGTH) == 0) {
+      offsets.push_back(static_cast<u32>(i));
+    }
+  }
+  return offsets;
+}
+
+void plant(std::vector<u8> &buf, size_t at, std::string_view magic) {
+  if (at + MAGIC_LENGTH <= buf.size()) {
+    memcpy(buf.data() + at, magic.data(), MAGIC_LENGTH);
+  }
+}
+
+// Random bytes drawn mostly from the magics' own letters, so leading bytes and partial matches
+// are common, with magics planted at the offsets the vector loop handles differently
+std::vector<u8> makeBuffer(size_t size, std::mt19937 &rng) {
+  static constexpr char letters[] = "pQESBAVDTICKO";
+  std::vector<u8> buf(size);
+  for (auto &byte : buf) {
+    byte = rng() % 2 ? static_cast<u8>(letters[rng() % (sizeof(letters) - 1)]) : static_cast<u8>(rng());
+  }
+
+  auto magic = [&rng] { return MagicIndex::magics[rng() % MagicIndex::magics.size()]; };
+  if (size >= MAGIC_LENGTH) {
+    plant(buf, 0, magic());
+    plant(buf, size - MAGIC_LENGTH, magic());
+    // Around the offset where the vector loop hands over to the per-offset tail: straddling the
+    // last two blocks, straddling the last block and the tail, or starting the tail
+    const size_t tail = (size - MAGIC_LENGTH + 1) / 16 * 16;
+    static constexpr size_t before[] = {18, 2, 1, 0};
+    const size_t back = before[rng() % std::size(before)];
+    if (tail >= back) {
+      plant(buf, tail - back, magic());
+    }
+  }
+  for (size_t block = 0; block + 16 < size; block += 16) {
+    if (rng() % 3 == 0) {
+      plant(buf, block + 13 + rng() % 3, magic());
+    }
+  }
+  for (size_t i = 0; i < size / 64; i++) {
+    const size_t at = rng() % size;
+    plant(buf, at, magic());
+    plant(buf, at + MAGIC_LENGTH, magic());
+  }
+  return buf;
+}
+
+bool matchesReference(const u8 *data, size_t size) {
+  const MagicIndex index(data, size);
+  for (std::string_view magic : MagicIndex::magics) {
+    if (index.offsets(magic) != referenceOffsets(data, size, magic)) {
+      std::printf("%zu-byte buffer: offsets of %.4s differ from the reference\n", size, magic.data());
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(0x5eed);
+
+  if (!MagicIndex(nullptr, 64).offsets("AKAO").empty()) {
+    std::printf("an index over no data has offsets\n");
+    return EXIT_FAILURE;
+  }
+
+  // Every length through several blocks, and a few long buffers. Each buffer is also indexed from
+  // a copy one byte into its storage, so the loads are not aligned. In the copy, a magic is cut
+  // off by the end of the buffer while the byte after the end completes it, which an index that
+  // looked past the end would report
+  std::vector<size_t> sizes;
+  for (size_t size = 0; size <= 100; size++) {
+    sizes.push_back(size);
+  }
+  for (int i = 0; i < 200; i++) {
+    sizes.push_back(100 + rng() % 65536);
+  }
+
+  for (size_t size : sizes) {
+    const std::vector<u8> buf = makeBuffer(size, rng);
+    std::vector<u8> shifted(size + 2);
+    std::copy(buf.begin(), buf.end(), shifted.begin() + 1);
+    if (size >= MAGIC_LENGTH - 1) {
+      const std::string_view cut = MagicIndex::magics[size % MagicIndex::magics.size()];
+      std::copy(cut.begin(), cut.end(), shifted.end() - MAGIC_LENGTH);
+    }
+    if (!matchesReference(buf.data(), size) || !matchesReference(shifted.data() + 1, size)) {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
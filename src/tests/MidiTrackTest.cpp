@@ -0,0 +1,410 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+// Checks the flat MidiTrack event buffer against the bytes written by the heap-allocated
+// MidiEvent subclasses it replaced: once for tracks built through every add and insert entry
+// point, and once for a merge of two sequences carrying text, marker and bank select events.
+// Also checks that the note offs left pending by addNoteByDur are still found after the track is
+// sorted and events are prepended to it. Exits with a non-zero status on any mismatch.
+
+#include "MidiFile.h"
+#include "MidiMerge.h"
+#include "VGMColl.h"
+#include "VGMSeq.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// What makeEveryEvent() wrote before the change
+constexpr u8 REFERENCE_EVERY_EVENT[] = {
+  0x4d, 0x54, 0x68, 0x64, 0x00, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00, 0x02,
+  0x00, 0x60, 0x4d, 0x54, 0x72, 0x6b, 0x00, 0x00, 0x01, 0x7b, 0x00, 0xf0,
+  0x05, 0x7e, 0x7f, 0x09, 0x01, 0xf7, 0x00, 0xff, 0x51, 0x03, 0x07, 0xa1,
+  0x20, 0x00, 0xff, 0x58, 0x04, 0x04, 0x01, 0x18, 0x08, 0x00, 0xff, 0x03,
+  0x04, 0x61, 0x64, 0x64, 0x73, 0x00, 0xff, 0x03, 0x0b, 0x65, 0x76, 0x65,
+  0x72, 0x79, 0x20, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x06, 0xf0, 0x05, 0x7e,
+  0x7f, 0x09, 0x03, 0xf7, 0x06, 0xf0, 0x0a, 0x41, 0x10, 0x42, 0x12, 0x40,
+  0x00, 0x7f, 0x00, 0x41, 0xf7, 0x06, 0xf0, 0x08, 0x43, 0x10, 0x4c, 0x00,
+  0x00, 0x7e, 0x00, 0xf7, 0x06, 0xff, 0x21, 0x01, 0x01, 0x00, 0xb0, 0x00,
+  0x01, 0x00, 0xb0, 0x20, 0x02, 0x00, 0xc0, 0x0a, 0x06, 0xf0, 0x07, 0x7f,
+  0x7f, 0x04, 0x01, 0x00, 0x6e, 0xf7, 0x00, 0xf0, 0x07, 0x7f, 0x7f, 0x04,
+  0x01, 0x03, 0x6f, 0xf7, 0x00, 0xb0, 0x5b, 0x28, 0x00, 0xb0, 0x07, 0x64,
+  0x00, 0xb0, 0x27, 0x05, 0x00, 0xb0, 0x0a, 0x14, 0x06, 0xb0, 0x0b, 0x5a,
+  0x00, 0xb0, 0x2b, 0x07, 0x00, 0xb0, 0x5b, 0x1e, 0x00, 0xb0, 0x01, 0x0c,
+  0x00, 0xb0, 0x02, 0x0d, 0x00, 0xb0, 0x40, 0x7f, 0x06, 0xb0, 0x7e, 0x00,
+  0x00, 0xb0, 0x44, 0x7f, 0x00, 0xb0, 0x41, 0x7f, 0x00, 0xb0, 0x05, 0x14,
+  0x00, 0xb0, 0x25, 0x15, 0x00, 0xb0, 0x54, 0x3c, 0x06, 0xb0, 0x65, 0x00,
+  0x00, 0xb0, 0x64, 0x00, 0x00, 0xb0, 0x26, 0x32, 0x00, 0xb0, 0x06, 0x0c,
+  0x00, 0xb0, 0x65, 0x00, 0x00, 0xb0, 0x64, 0x01, 0x00, 0xb0, 0x26, 0x10,
+  0x00, 0xb0, 0x06, 0x40, 0x00, 0xb0, 0x65, 0x00, 0x00, 0xb0, 0x64, 0x01,
+  0x00, 0xb0, 0x26, 0x00, 0x00, 0xb0, 0x06, 0x38, 0x00, 0xb0, 0x65, 0x00,
+  0x00, 0xb0, 0x64, 0x02, 0x00, 0xb0, 0x26, 0x00, 0x00, 0xb0, 0x06, 0x41,
+  0x00, 0xb0, 0x65, 0x00, 0x00, 0xb0, 0x64, 0x02, 0x00, 0xb0, 0x26, 0x00,
+  0x00, 0xb0, 0x06, 0x3d, 0x00, 0xb0, 0x65, 0x00, 0x00, 0xb0, 0x64, 0x05,
+  0x00, 0xb0, 0x26, 0x40, 0x00, 0xb0, 0x06, 0x00, 0x00, 0xb0, 0x65, 0x00,
+  0x00, 0xb0, 0x64, 0x01, 0x00, 0xb0, 0x26, 0x60, 0x00, 0xb0, 0x06, 0x40,
+  0x00, 0xe0, 0x00, 0x20, 0x00, 0xd0, 0x32, 0x06, 0x90, 0x3c, 0x64, 0x00,
+  0xff, 0x01, 0x04, 0x74, 0x65, 0x78, 0x74, 0x06, 0x80, 0x3c, 0x40, 0x00,
+  0x90, 0x3e, 0x5a, 0x00, 0x90, 0x40, 0x50, 0x0c, 0x80, 0x3e, 0x40, 0x18,
+  0x80, 0x40, 0x40, 0x60, 0xff, 0x51, 0x03, 0x06, 0x1a, 0x80, 0x42, 0xff,
+  0x2f, 0x00, 0x7e, 0xff, 0x51, 0x03, 0x06, 0xdd, 0xd0, 0x81, 0x40, 0xff,
+  0x51, 0x03, 0x0a, 0x2c, 0x2b, 0x81, 0x40, 0xff, 0x58, 0x04, 0x03, 0x01,
+  0x18, 0x08, 0x00, 0xff, 0x03, 0x0b, 0x73, 0x65, 0x63, 0x6f, 0x6e, 0x64,
+  0x20, 0x70, 0x61, 0x72, 0x74, 0x4d, 0x54, 0x72, 0x6b, 0x00, 0x00, 0x01,
+  0x74, 0x00, 0xff, 0x51, 0x03, 0x07, 0xa1, 0x20, 0x00, 0xff, 0x58, 0x04,
+  0x04, 0x01, 0x18, 0x08, 0x00, 0xff, 0x03, 0x07, 0x69, 0x6e, 0x73, 0x65,
+  0x72, 0x74, 0x73, 0x00, 0xff, 0x03, 0x0b, 0x65, 0x76, 0x65, 0x72, 0x79,
+  0x20, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x81, 0x40, 0xff, 0x51, 0x03, 0x06,
+  0x1a, 0x80, 0x3a, 0xf0, 0x05, 0x7e, 0x7f, 0x09, 0x01, 0xf7, 0x0a, 0xf0,
+  0x05, 0x7e, 0x7f, 0x09, 0x03, 0xf7, 0x0a, 0xf0, 0x0a, 0x41, 0x10, 0x42,
+  0x12, 0x40, 0x00, 0x7f, 0x00, 0x41, 0xf7, 0x0a, 0xf0, 0x08, 0x43, 0x10,
+  0x4c, 0x00, 0x00, 0x7e, 0x00, 0xf7, 0x0a, 0xff, 0x21, 0x01, 0x02, 0x0a,
+  0xb1, 0x00, 0x03, 0x0a, 0xb1, 0x5d, 0x29, 0x0a, 0xb1, 0x27, 0x06, 0x00,
+  0xb1, 0x07, 0x65, 0x0a, 0xf0, 0x07, 0x7f, 0x7f, 0x04, 0x01, 0x04, 0x70,
+  0xf7, 0x00, 0xf0, 0x07, 0x7f, 0x7f, 0x04, 0x01, 0x00, 0x71, 0xf7, 0x0a,
+  0xb1, 0x0a, 0x64, 0x0a, 0xb1, 0x2b, 0x08, 0x00, 0xb1, 0x0b, 0x5b, 0x0a,
+  0xb1, 0x5b, 0x1f, 0x0a, 0xb1, 0x01, 0x0f, 0x0a, 0xb1, 0x02, 0x0e, 0x04,
+  0xff, 0x51, 0x03, 0x06, 0xdd, 0xd0, 0x06, 0xb1, 0x40, 0x00, 0x0a, 0xb1,
+  0x41, 0x00, 0x0a, 0xb1, 0x25, 0x09, 0x00, 0xb1, 0x05, 0x08, 0x0a, 0xb1,
+  0x54, 0x37, 0x0a, 0xb1, 0x7e, 0x00, 0x0a, 0xb1, 0x44, 0x00, 0x0a, 0xe1,
+  0x00, 0x50, 0x0a, 0xd1, 0x3c, 0x0a, 0xb1, 0x65, 0x00, 0x00, 0xb1, 0x64,
+  0x00, 0x00, 0xb1, 0x26, 0x00, 0x00, 0xb1, 0x06, 0x02, 0x0a, 0xb1, 0x65,
+  0x00, 0x00, 0xb1, 0x64, 0x01, 0x00, 0xb1, 0x26, 0x00, 0x00, 0xb1, 0x06,
+  0x50, 0x00, 0xb1, 0x65, 0x00, 0x00, 0xb1, 0x64, 0x01, 0x00, 0xb1, 0x26,
+  0x70, 0x00, 0xb1, 0x06, 0x3f, 0x0a, 0xb1, 0x65, 0x00, 0x00, 0xb1, 0x64,
+  0x02, 0x00, 0xb1, 0x26, 0x00, 0x00, 0xb1, 0x06, 0x42, 0x00, 0xb1, 0x65,
+  0x00, 0x00, 0xb1, 0x64, 0x02, 0x00, 0xb1, 0x26, 0x00, 0x00, 0xb1, 0x06,
+  0x42, 0x0a, 0xb1, 0x65, 0x00, 0x00, 0xb1, 0x64, 0x01, 0x00, 0xb1, 0x26,
+  0x40, 0x00, 0xb1, 0x06, 0x40, 0x00, 0xb1, 0x65, 0x00, 0x00, 0xb1, 0x64,
+  0x05, 0x00, 0xb1, 0x26, 0x20, 0x00, 0xb1, 0x06, 0x00, 0x4c, 0xff, 0x51,
+  0x03, 0x0a, 0x2c, 0x2b, 0x18, 0x91, 0x32, 0x5a, 0x64, 0x81, 0x32, 0x40,
+  0x14, 0x91, 0x32, 0x64, 0x30, 0xff, 0x58, 0x04, 0x03, 0x01, 0x18, 0x08,
+  0x00, 0x81, 0x32, 0x40, 0x00, 0xff, 0x03, 0x0b, 0x73, 0x65, 0x63, 0x6f,
+  0x6e, 0x64, 0x20, 0x70, 0x61, 0x72, 0x74, 0x81, 0x04, 0xff, 0x01, 0x09,
+  0x6c, 0x61, 0x74, 0x65, 0x20, 0x74, 0x65, 0x78, 0x74, 0x3c, 0xff, 0x2f,
+  0x00,
+};
+
+// What the merge in checkMerge() wrote before the change
+constexpr u8 REFERENCE_MERGE[] = {
+  0x4d, 0x54, 0x68, 0x64, 0x00, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00, 0x02,
+  0x00, 0x60, 0x4d, 0x54, 0x72, 0x6b, 0x00, 0x00, 0x00, 0x65, 0x00, 0xff,
+  0x51, 0x03, 0x07, 0xa1, 0x20, 0x00, 0xb0, 0x00, 0x00, 0x00, 0xb0, 0x20,
+  0x00, 0x00, 0xb0, 0x00, 0x01, 0x00, 0xc0, 0x04, 0x00, 0x90, 0x3c, 0x64,
+  0x00, 0xff, 0x03, 0x05, 0x66, 0x69, 0x72, 0x73, 0x74, 0x00, 0xff, 0x01,
+  0x0a, 0x66, 0x69, 0x72, 0x73, 0x74, 0x20, 0x70, 0x61, 0x72, 0x74, 0x30,
+  0x80, 0x3c, 0x40, 0x30, 0x90, 0x3e, 0x64, 0x00, 0xff, 0x01, 0x0a, 0x66,
+  0x69, 0x72, 0x73, 0x74, 0x20, 0x74, 0x65, 0x78, 0x74, 0x30, 0x80, 0x3e,
+  0x40, 0x30, 0xff, 0x51, 0x03, 0x06, 0x1a, 0x80, 0x00, 0xff, 0x2f, 0x00,
+  0x00, 0xff, 0x01, 0x0b, 0x73, 0x65, 0x63, 0x6f, 0x6e, 0x64, 0x20, 0x70,
+  0x61, 0x72, 0x74, 0x4d, 0x54, 0x72, 0x6b, 0x00, 0x00, 0x00, 0x64, 0x00,
+  0xff, 0x51, 0x03, 0x07, 0xa1, 0x20, 0x00, 0xff, 0x01, 0x0a, 0x66, 0x69,
+  0x72, 0x73, 0x74, 0x20, 0x70, 0x61, 0x72, 0x74, 0x81, 0x40, 0xff, 0x51,
+  0x03, 0x06, 0x1a, 0x80, 0x00, 0xb1, 0x00, 0x02, 0x00, 0xb1, 0x20, 0x00,
+  0x00, 0xc1, 0x07, 0x00, 0x91, 0x43, 0x5a, 0x00, 0xff, 0x03, 0x06, 0x73,
+  0x65, 0x63, 0x6f, 0x6e, 0x64, 0x00, 0xff, 0x01, 0x0b, 0x73, 0x65, 0x63,
+  0x6f, 0x6e, 0x64, 0x20, 0x70, 0x61, 0x72, 0x74, 0x30, 0x81, 0x43, 0x40,
+  0x30, 0x91, 0x45, 0x5a, 0x00, 0xff, 0x01, 0x0b, 0x73, 0x65, 0x63, 0x6f,
+  0x6e, 0x64, 0x20, 0x74, 0x65, 0x78, 0x74, 0x30, 0x81, 0x45, 0x40, 0x30,
+  0xff, 0x2f, 0x00,
+};
+
+// A sequence that converts to a fixed MIDI file, so MidiFile and the merge can run without a
+// sequence driver behind them
+class TestSeq : public VGMSeq {
+ public:
+  using Build = void (*)(MidiFile &midi);
+
+  explicit TestSeq(Build build = nullptr) : VGMSeq("Test", nullptr, 0, 0, "test"), m_build(build) {}
+
+  using VGMSeq::convertToMidi;
+  std::unique_ptr<MidiFile> convertToMidi(const VGMColl *, const ConversionContext &) override {
+    auto midi = std::make_unique<MidiFile>(this);
+    m_build(*midi);
+    return midi;
+  }
+
+ private:
+  Build m_build;
+};
+
+// Calls each add and insert function of MidiTrack once, in time order on the first track and out
+// of order on the second
+void makeEveryEvent(MidiFile &midi) {
+  midi.setPPQN(96);
+
+  MidiTrack &global = midi.globalTrack;
+  global.addTempo(500000);
+  global.addTimeSig(4, 2, 24);
+  global.addSeqName("every event");
+  global.setDelta(192);
+  global.addTempoBPM(150.0);
+  global.insertTempo(450000, 384);
+  global.insertTempoBPM(90.0, 576);
+  global.insertTimeSig(3, 2, 24, 768);
+  global.insertGlobalTranspose(672, 2);
+  global.insertSeqName("second part", 768);
+
+  MidiTrack *track = midi.addTrack();
+  auto step = [track] { track->addDelta(6); };
+  track->addTrackName("adds");
+  track->addGMReset();
+  step();
+  track->addGM2Reset();
+  step();
+  track->addGSReset();
+  step();
+  track->addXGReset();
+  step();
+  track->addMidiPort(1);
+  track->addBankSelect(0, 1);
+  track->addBankSelectFine(0, 2);
+  track->addProgramChange(0, 10);
+  step();
+  track->addControllerEvent(0, 91, 40);
+  track->addVol(0, 100);
+  track->addVolumeFine(0, 5);
+  track->addMasterVol(0, 110);
+  track->addMasterVol(0, 111, 3);
+  track->addPan(0, 20);
+  step();
+  track->addExpression(0, 90);
+  track->addExpressionFine(0, 7);
+  track->addReverb(0, 30);
+  track->addModulation(0, 12);
+  track->addBreath(0, 13);
+  track->addSustain(0, 127);
+  step();
+  track->addPortamento(0, true);
+  track->addPortamentoTime(0, 20);
+  track->addPortamentoTimeFine(0, 21);
+  track->addPortamentoControl(0, 60);
+  track->addMono(0);
+  track->addLegatoPedal(0, true);
+  step();
+  track->addPitchBend(0, -0x1000);
+  track->addChannelPressure(0, 50);
+  track->addPitchBendRange(0, 1250);
+  track->addFineTuning(0, 0x40, 0x10);
+  track->addFineTuning(0, -12.5);
+  track->addCoarseTuning(0, 0x41, 0);
+  track->addCoarseTuning(0, -3.0);
+  track->addModulationDepthRange(0, 0, 64);
+  track->addModulationDepthRange(0, 0.75);
+  step();
+  track->addText("text");
+  track->addMarker(0, "marker", 1, 2);
+  track->addMarker(0, "high marker", 3, 4, PRIORITY_HIGH);
+  track->addNoteOn(0, 60, 100);
+  step();
+  track->addNoteOff(0, 60);
+  track->addNoteByDur(0, 62, 90, 12);
+  track->addNoteByDur_TriAce(0, 64, 80, 24);
+  step();
+  track->addNoteByDur_TriAce(0, 64, 80, 30);
+  track->addDelta(192);
+  track->addEndOfTrack();
+
+  MidiTrack *inserts = midi.insertTrack(1);
+  inserts->insertTrackName("inserts", 0);
+  inserts->insertEndOfTrack(960);
+  inserts->insertNoteByDur(1, 48, 100, 48, 720);
+  inserts->insertNoteOn(1, 50, 90, 600);
+  inserts->insertNoteOff(1, 50, 700);
+  inserts->insertText("late text", 900);
+  inserts->insertMarker(1, "inserted marker", 5, 6, PRIORITY_LOW, 600);
+  inserts->insertModulationDepthRange(1, 0.5, 500);
+  inserts->insertModulationDepthRange(1, 0, 32, 500);
+  inserts->insertCoarseTuning(1, 2.0, 490);
+  inserts->insertCoarseTuning(1, 0x42, 0, 490);
+  inserts->insertFineTuning(1, 25.0, 480);
+  inserts->insertFineTuning(1, 0x3f, 0x70, 480);
+  inserts->insertPitchBendRange(1, 200, 470);
+  inserts->insertChannelPressure(1, 60, 460);
+  inserts->insertPitchBend(1, 0x0800, 450);
+  inserts->insertLegatoPedal(1, false, 440);
+  inserts->insertMono(1, 430);
+  inserts->insertPortamentoControl(1, 55, 420);
+  inserts->insertPortamentoTimeFine(1, 9, 410);
+  inserts->insertPortamentoTime(1, 8, 410);
+  inserts->insertPortamento(1, false, 400);
+  inserts->insertSustain(1, 0, 390);
+  inserts->insertBreath(1, 14, 380);
+  inserts->insertModulation(1, 15, 370);
+  inserts->insertReverb(1, 31, 360);
+  inserts->insertExpressionFine(1, 8, 350);
+  inserts->insertExpression(1, 91, 350);
+  inserts->insertPan(1, 100, 340);
+  inserts->insertMasterVol(1, 112, 4, 330);
+  inserts->insertMasterVol(1, 113, 330);
+  inserts->insertVolumeFine(1, 6, 320);
+  inserts->insertVol(1, 101, 320);
+  inserts->insertControllerEvent(1, 93, 41, 310);
+  inserts->insertBankSelect(1, 3, 300);
+  inserts->insertMidiPort(2, 290);
+  inserts->insertXGReset(280);
+  inserts->insertGSReset(270);
+  inserts->insertGM2Reset(260);
+  inserts->insertGMReset(250);
+}
+
+void makeFirstPart(MidiFile &midi) {
+  midi.setPPQN(48);
+  midi.globalTrack.insertTempo(500000, 0);
+  midi.globalTrack.insertText("first part", 0);
+  midi.globalTrack.addMarker(0, "first loop", 0, 0);
+
+  MidiTrack *track = midi.addTrack();
+  track->addTrackName("first");
+  track->addBankSelect(0, 1);
+  track->addProgramChange(0, 4);
+  track->addMarker(0, "first track marker", 1, 0);
+  track->addNoteByDur(0, 60, 100, 24);
+  track->addDelta(48);
+  track->addText("first text");
+  track->addNoteByDur(0, 62, 100, 24);
+  track->addDelta(48);
+  track->addEndOfTrack();
+}
+
+void makeSecondPart(MidiFile &midi) {
+  midi.setPPQN(96);
+  midi.globalTrack.insertTempo(400000, 0);
+  midi.globalTrack.insertText("second part", 0);
+  midi.globalTrack.insertMarker(0, "second loop", 0, 0, PRIORITY_MIDDLE, 96);
+
+  MidiTrack *track = midi.addTrack();
+  track->addTrackName("second");
+  track->addProgramChange(1, 7);
+  track->addNoteByDur(1, 67, 90, 48);
+  track->addDelta(96);
+  track->addText("second text");
+  track->addMarker(1, "second track marker", 2, 0);
+  track->addNoteByDur(1, 69, 90, 48);
+  track->addDelta(96);
+  track->addEndOfTrack();
+}
+
+bool report(const char *what, bool same) {
+  if (!same) {
+    std::printf("%s: mismatch\n", what);
+  }
+  return same;
+}
+
+bool writesReference(MidiFile &midi, std::span<const u8> reference) {
+  std::vector<u8> buf;
+  midi.writeMidiToBuffer(buf);
+  return std::ranges::equal(buf, reference);
+}
+
+// The pending note offs of the track, as (key, absTime) pairs; empty if any index is stale
+std::vector<std::pair<s8, u32>> pendingNoteOffs(MidiTrack &track) {
+  std::vector<std::pair<s8, u32>> noteOffs;
+  for (size_t index : track.previousDurNoteOffs()) {
+    if (index >= track.events().size()) {
+      return {};
+    }
+    const MidiEvent &event = track.event(index);
+    if (event.kind != MidiEvent::Kind::Note || event.note.noteDown) {
+      return {};
+    }
+    noteOffs.emplace_back(event.note.key, event.absTime);
+  }
+  return noteOffs;
+}
+
+bool checkPendingNoteOffs() {
+  TestSeq seq;
+  MidiFile midi(&seq);
+  MidiTrack *track = midi.addTrack();
+  bool ok = true;
+
+  // Overlapping notes leave their note offs pending, in the order they were added
+  track->addNoteByDur(0, 60, 100, 96);
+  track->addDelta(10);
+  track->addNoteByDur(0, 62, 100, 96);
+  track->addDelta(10);
+  track->addNoteByDur(0, 64, 100, 96);
+  track->insertVol(0, 100, 5);
+  track->insertNoteOn(0, 40, 100, 0);
+  track->insertNoteOff(0, 40, 200);
+  using Pending = std::vector<std::pair<s8, u32>>;
+  ok &= report("pending note offs after adding", pendingNoteOffs(*track) == Pending{{60, 96}, {62, 106}, {64, 116}});
+
+  track->sortEvents();
+  ok &= report("pending note offs after sorting", pendingNoteOffs(*track) == Pending{{60, 96}, {62, 106}, {64, 116}});
+
+  const MidiEvent bankSelects[] = {
+    MidiEvent::makeController(0, 0, 0, 1, PRIORITY_HIGH, MIDIEVENT_BANKSELECT),
+    MidiEvent::makeController(0, 0, 32, 0, PRIORITY_HIGH, MIDIEVENT_BANKSELECTFINE),
+  };
+  track->prependEvents(bankSelects);
+  ok &= report("pending note offs after prepending",
+               pendingNoteOffs(*track) == Pending{{60, 96}, {62, 106}, {64, 116}});
+
+  // Adding a note later on drops the note offs that have passed, and drivers may move the last one
+  track->setDelta(100);
+  track->addNoteByDur(0, 65, 100, 20);
+  ok &= report("pending note offs after purging", pendingNoteOffs(*track) == Pending{{62, 106}, {64, 116}, {65, 120}});
+  track->event(track->previousDurNoteOffs().back()).absTime = 130;
+  track->sortEvents();
+  ok &= report("moved note off", pendingNoteOffs(*track) == Pending{{62, 106}, {64, 116}, {65, 130}});
+  return ok;
+}
+
+// Merges the two parts back to back, moving the second one up two banks. Marker and text names
+// live in each track's blob area, so they must survive the global tracks being appended
+bool checkMerge() {
+  TestSeq first(makeFirstPart);
+  TestSeq second(makeSecondPart);
+  VGMColl firstColl("first");
+  VGMColl secondColl("second");
+  firstColl.attachSeq(&first);
+  secondColl.attachSeq(&second);
+
+  conversion::MidiMergeOptions options;
+  options.bankOffsets = {0, 2};
+  auto merged = conversion::mergeMidiSequences({{&firstColl, "first"}, {&secondColl, "second"}}, options);
+  if (!report("merge", merged != nullptr)) {
+    return false;
+  }
+
+  std::vector<std::string_view> names;
+  for (const MidiEvent &event : merged->globalTrack.events()) {
+    if (event.kind == MidiEvent::Kind::Marker || event.kind == MidiEvent::Kind::Text) {
+      names.push_back(merged->globalTrack.text(event));
+    }
+  }
+  const std::vector<std::string_view> expected = {"first part", "first loop", "second part", "second loop"};
+  bool ok = report("merged global text and markers", names == expected);
+  ok &= report("merged sequences", writesReference(*merged, REFERENCE_MERGE));
+  return ok;
+}
+
+}  // namespace
+
+int main() {
+  bool ok = true;
+
+  TestSeq seq;
+  MidiFile everyEvent(&seq);
+  makeEveryEvent(everyEvent);
+  ok &= report("every add and insert entry point", writesReference(everyEvent, REFERENCE_EVERY_EVENT));
+
+  ok &= checkPendingNoteOffs();
+  ok &= checkMerge();
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,173 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+// Times MidiFile::writeMidiToBuffer and MidiFile::saveMidiFile on a generated sequence of 16
+// tracks plus a global tempo track. Usage: midi-writer-bench [event count]
+// A small sequence is first written and compared with the bytes the serializer produced before
+// tracks were sorted once and merged with the global track while writing. Exits with a non-zero
+// status if that output differs, or if the file and buffer writers disagree.
+
+#include "MidiFile.h"
+#include "VGMSeq.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace {
+
+// What the serializer wrote for makeSmallSequence() when every track was copied and re-sorted
+// together with the global track. The tempo change at tick 96 ties with events in both tracks
+constexpr u8 REFERENCE_MIDI[] = {
+  0x4d, 0x54, 0x68, 0x64, 0x00, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00, 0x02,
+  0x00, 0x30, 0x4d, 0x54, 0x72, 0x6b, 0x00, 0x00, 0x00, 0x45, 0x00, 0xff,
+  0x51, 0x03, 0x07, 0xa1, 0x20, 0x00, 0xff, 0x58, 0x04, 0x04, 0x02, 0x18,
+  0x08, 0x00, 0xc0, 0x05, 0x00, 0xb0, 0x07, 0x64, 0x00, 0x90, 0x3c, 0x64,
+  0x00, 0xff, 0x03, 0x04, 0x6c, 0x65, 0x61, 0x64, 0x18, 0x80, 0x3c, 0x40,
+  0x18, 0x90, 0x40, 0x5a, 0x30, 0xff, 0x51, 0x03, 0x06, 0x1a, 0x80, 0x00,
+  0xe0, 0x00, 0x60, 0x00, 0x80, 0x40, 0x40, 0x00, 0x90, 0x43, 0x50, 0x18,
+  0x80, 0x43, 0x40, 0x00, 0xff, 0x2f, 0x00, 0x4d, 0x54, 0x72, 0x6b, 0x00,
+  0x00, 0x00, 0x32, 0x00, 0xff, 0x51, 0x03, 0x07, 0xa1, 0x20, 0x00, 0xff,
+  0x58, 0x04, 0x04, 0x02, 0x18, 0x08, 0x00, 0x91, 0x28, 0x64, 0x30, 0xb1,
+  0x40, 0x7f, 0x00, 0x81, 0x28, 0x40, 0x30, 0xff, 0x51, 0x03, 0x06, 0x1a,
+  0x80, 0x00, 0xb1, 0x0a, 0x20, 0x00, 0x91, 0x24, 0x6e, 0x60, 0x81, 0x24,
+  0x40, 0x00, 0xff, 0x2f, 0x00,
+};
+
+// A test-only sequence, since MidiFile takes its PPQN and track mode from the VGMSeq it converts
+class BenchSeq : public VGMSeq {
+ public:
+  BenchSeq() : VGMSeq("Bench", nullptr, 0, 0, "bench") {}
+};
+
+void makeSmallSequence(MidiFile &midi) {
+  midi.setPPQN(48);
+
+  MidiTrack &global = midi.globalTrack;
+  global.insertTempo(500000, 0);
+  global.insertTimeSig(4, 4, 24, 0);
+  global.insertTempo(400000, 96);
+
+  MidiTrack *lead = midi.addTrack();
+  lead->addTrackName("lead");
+  lead->addProgramChange(0, 5);
+  lead->addVol(0, 100);
+  lead->addNoteByDur(0, 60, 100, 24);
+  lead->addDelta(48);
+  lead->addNoteByDur(0, 64, 90, 48);
+  lead->addDelta(48);
+  lead->addPitchBend(0, 0x1000);
+  lead->addNoteOn(0, 67, 80);
+  lead->addDelta(24);
+  lead->addNoteOff(0, 67);
+  lead->addEndOfTrack();
+
+  MidiTrack *bass = midi.addTrack();
+  bass->insertNoteByDur(1, 36, 110, 96, 96);
+  bass->insertPan(1, 32, 96);
+  bass->insertNoteOn(1, 40, 100, 0);
+  bass->insertNoteOff(1, 40, 48);
+  bass->insertSustain(1, 127, 48);
+  bass->insertEndOfTrack(192);
+}
+
+// Roughly eventCount events spread over 16 tracks, plus 500 tempo changes in the global track
+void makeLargeSequence(MidiFile &midi, size_t eventCount) {
+  std::mt19937 rng(0x5eed);
+  midi.setPPQN(48);
+
+  u32 tempoTime = 0;
+  for (int i = 0; i < 500; i++) {
+    midi.globalTrack.insertTempo(400000 + rng() % 200000, tempoTime);
+    tempoTime += rng() % 400;
+  }
+
+  const size_t perTrack = eventCount / 16;
+  for (u8 channel = 0; channel < 16; channel++) {
+    MidiTrack *track = midi.addTrack();
+    track->addProgramChange(channel, channel);
+    size_t added = 1;
+    while (added < perTrack) {
+      switch (rng() % 8) {
+        case 0:
+          track->addVol(channel, rng() % 128);
+          added++;
+          track->addDelta(rng() % 12);
+          break;
+        case 1:
+          track->addPitchBend(channel, static_cast<s16>(rng() % 0x4000 - 0x2000));
+          added++;
+          track->addDelta(rng() % 12);
+          break;
+        default: {
+          // Each note ends before the next one starts, as a note on a live key is reported
+          const u32 duration = 1 + rng() % 48;
+          track->addNoteByDur(channel, static_cast<s8>(24 + rng() % 72), static_cast<s8>(1 + rng() % 127),
+                              duration);
+          added += 2;
+          track->addDelta(duration + 1 + rng() % 12);
+          break;
+        }
+      }
+    }
+    track->addEndOfTrack();
+  }
+}
+
+std::vector<u8> readFile(const std::filesystem::path &path) {
+  std::ifstream in(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+template <typename Fn>
+double timeMs(Fn fn) {
+  const auto start = std::chrono::steady_clock::now();
+  fn();
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t eventCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+  const auto tempPath = std::filesystem::temp_directory_path() / "midi-writer-bench.mid";
+  BenchSeq seq;
+  int failures = 0;
+
+  MidiFile small(&seq);
+  makeSmallSequence(small);
+  std::vector<u8> smallBuf;
+  small.writeMidiToBuffer(smallBuf);
+  if (!std::ranges::equal(smallBuf, REFERENCE_MIDI)) {
+    std::printf("small sequence differs from the reference output\n");
+    failures++;
+  }
+
+  MidiFile large(&seq);
+  makeLargeSequence(large, eventCount);
+  std::vector<u8> buf;
+  const double bufferMs = timeMs([&] { large.writeMidiToBuffer(buf); });
+  const double fileMs = timeMs([&] { large.saveMidiFile(tempPath); });
+  const std::vector<u8> saved = readFile(tempPath);
+  std::filesystem::remove(tempPath);
+
+  size_t events = large.globalTrack.events().size();
+  for (const MidiTrack *track : large.tracks()) {
+    events += track->events().size();
+  }
+  const bool same = saved == buf;
+  failures += same ? 0 : 1;
+  std::printf("%zu events, %zu bytes  writeMidiToBuffer %8.2f ms  saveMidiFile %8.2f ms%s\n", events,
+              buf.size(), bufferMs, fileMs, same ? "" : "  MISMATCH");
+
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
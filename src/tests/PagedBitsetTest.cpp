@@ -0,0 +1,148 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+// Checks PagedBitset against std::set over random insert sequences. Each round inserts values
+// below the first page seen so far, so the page directory has to grow at the front, and some
+// rounds spread values over the whole u32 range. All rounds reuse one set after clear(), so
+// recycled pages must come back empty. Exits with a non-zero status on the first mismatch.
+
+#include "PagedBitset.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+constexpr u32 PAGE_BITS = 4096;
+
+enum class Spread { Clustered, Descending, FarFlung, PageEdges };
+
+const char *spreadName(Spread spread) {
+  switch (spread) {
+    case Spread::Clustered: return "clustered";
+    case Spread::Descending: return "descending";
+    case Spread::FarFlung: return "far-flung";
+    case Spread::PageEdges: return "page edges";
+  }
+  return "";
+}
+
+// Values for one round. Every spread starts high and then goes below its first value, so the
+// directory is extended at the front as well as at the back
+std::vector<u32> makeValues(Spread spread, std::mt19937 &rng) {
+  std::vector<u32> values;
+  const u32 base = 0x100000 + rng() % 0x1000000;
+  switch (spread) {
+    case Spread::Clustered:
+      for (int i = 0; i < 20000; i++) {
+        values.push_back(base - 0x8000 + rng() % 0x20000);
+      }
+      break;
+    case Spread::Descending:
+      for (u32 value = base; value > base - 40 * PAGE_BITS; value -= 1 + rng() % 97) {
+        values.push_back(value);
+      }
+      break;
+    case Spread::FarFlung:
+      values.push_back(base);
+      values.push_back(0);
+      values.push_back(std::numeric_limits<u32>::max());
+      for (int i = 0; i < 2000; i++) {
+        values.push_back(static_cast<u32>(rng()));
+      }
+      break;
+    case Spread::PageEdges:
+      for (u32 page = base / PAGE_BITS + 8; page > base / PAGE_BITS - 8; page--) {
+        for (u32 offset : {0u, 1u, 63u, 64u, 65u, PAGE_BITS - 64, PAGE_BITS - 1}) {
+          values.push_back(page * PAGE_BITS + offset);
+        }
+      }
+      break;
+  }
+
+  // Repeats, which insert must report as already present
+  const size_t count = values.size();
+  for (size_t i = 0; i < count / 4; i++) {
+    values.push_back(values[rng() % count]);
+  }
+  return values;
+}
+
+// The bitset holds exactly the expected values if it contains each of them and nothing else in
+// the pages they fall in, which are the only pages it allocates. A recycled page that was not
+// cleared would show up here. Probes around and outside the range cover the directory lookup
+bool matches(const PagedBitset &bitset, const std::set<u32> &expected, std::mt19937 &rng) {
+  std::set<u32> pages;
+  for (u32 value : expected) {
+    if (!bitset.contains(value)) {
+      std::printf("contains(%u) returned false\n", value);
+      return false;
+    }
+    pages.insert(value / PAGE_BITS);
+  }
+  size_t found = 0;
+  for (u32 page : pages) {
+    for (u32 offset = 0; offset < PAGE_BITS; offset++) {
+      found += bitset.contains(page * PAGE_BITS + offset);
+    }
+  }
+  if (found != expected.size()) {
+    std::printf("%zu values found in the pages of %zu values\n", found, expected.size());
+    return false;
+  }
+
+  std::vector<u32> probes = {0, 1, PAGE_BITS, std::numeric_limits<u32>::max()};
+  if (!expected.empty()) {
+    probes.push_back(*expected.begin() - PAGE_BITS);
+    probes.push_back(*expected.rbegin() + PAGE_BITS);
+  }
+  for (int i = 0; i < 10000; i++) {
+    probes.push_back(static_cast<u32>(rng()));
+  }
+  for (u32 probe : probes) {
+    if (bitset.contains(probe) != expected.contains(probe)) {
+      std::printf("contains(%u) returned %d\n", probe, bitset.contains(probe));
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(0x5eed);
+  PagedBitset bitset;
+  const Spread spreads[] = {Spread::Clustered, Spread::Descending, Spread::FarFlung, Spread::PageEdges};
+
+  for (int round = 0; round < 24; round++) {
+    const Spread spread = spreads[round % 4];
+    std::set<u32> expected;
+    for (u32 value : makeValues(spread, rng)) {
+      const bool inserted = expected.insert(value).second;
+      if (bitset.insert(value) != inserted) {
+        std::printf("round %d (%s): insert(%u) should have returned %d\n", round, spreadName(spread), value,
+                    inserted);
+        return EXIT_FAILURE;
+      }
+    }
+    if (!matches(bitset, expected, rng)) {
+      std::printf("round %d (%s): the set differs from std::set\n", round, spreadName(spread));
+      return EXIT_FAILURE;
+    }
+
+    bitset.clear();
+    if (!matches(bitset, {}, rng)) {
+      std::printf("round %d (%s): values were left behind by clear()\n", round, spreadName(spread));
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
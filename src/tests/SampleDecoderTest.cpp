@@ -0,0 +1,187 @@
+/*
+ * VGMTrans (c) 2002-2026
+ * Licensed under the zlib license,
+ * refer to the included LICENSE.txt file
+ */
+
+// Checks that the batch PSX ADPCM and SNES BRR decoders, which expand the nibbles of a block
+// with SSE2 where available, produce bit-exact output of the per-sample decoders they replaced.
+// Every header byte value is covered, including out-of-range shifts and filters.
+// Exits with a non-zero status on the first mismatch.
+
+#include "PSXSPU.h"
+#include "SNESDSP.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+// The per-block VAG decoder PSXSamp used before decodeVAGBlocks
+void referenceVAGBlock(const u8 *block, s16 *pSmp, s32 prev[2]) {
+  static constexpr s16 COEF[5][2] = {
+    {   0,   0 }, {  60,   0 },
+    { 115, -52 }, {  98, -55 },
+    { 122, -60 }
+  };
+
+  const u8 shift = block[0] & 0x0F;
+  const u8 filt = std::min<u8>(block[0] >> 4, 4);
+  const s16 c0 = COEF[filt][0];
+  const s16 c1 = COEF[filt][1];
+
+  s32 s1 = prev[0];
+  s32 s2 = prev[1];
+  for (int i = 0; i < 28; ++i) {
+    const u8 byte = block[2 + (i >> 1)];
+    const s8 nibble = (i & 1) ? (byte >> 4) : (byte & 0x0F);
+    const s8 sn = static_cast<s8>(nibble << 4) >> 4;
+
+    s32 sample = (static_cast<s32>(sn) << 12) >> shift;
+    sample += ((c0 * s1 + c1 * s2) >> 6);
+    sample = std::clamp(sample, -0x8000, 0x7FFF);
+
+    pSmp[i] = static_cast<s16>(sample);
+    s2 = s1;
+    s1 = sample;
+  }
+  prev[0] = s1;
+  prev[1] = s2;
+}
+
+s32 sclip15(s32 x) {
+  return ((x & 16384) ? (x | ~16383) : (x & 16383));
+}
+
+s32 sclamp16(s32 x) {
+  return ((x > 32767) ? 32767 : (x < -32768) ? -32768 : x);
+}
+
+// The per-block BRR decoder SNESSamp used before decodeBRRBlocks
+void referenceBRRBlock(const u8 *block, s16 *pSmp, s32 *prev1, s32 *prev2) {
+  const u8 range = block[0] >> 4;
+  const u8 filter = (block[0] & 0x0c) >> 2;
+  const bool validHeader = (range < 0xD);
+
+  s32 S1 = *prev1;
+  s32 S2 = *prev2;
+  for (int i = 0; i < 8; i++) {
+    s8 sample1 = static_cast<s8>(block[1 + i]);
+    s8 sample2 = static_cast<s8>(sample1 << 4);
+    sample1 >>= 4;
+    sample2 >>= 4;
+
+    for (int nybble = 0; nybble < 2; nybble++) {
+      s32 out = nybble ? sample2 : sample1;
+      out = validHeader ? ((out << range) >> 1) : (out & ~0x7FF);
+
+      switch (filter) {
+        case 1:
+          out += S1 + ((-S1) >> 4);
+          break;
+        case 2:
+          out += (S1 << 1) + ((-((S1 << 1) + S1)) >> 5) - S2 + (S2 >> 4);
+          break;
+        case 3:
+          out += (S1 << 1) + ((-(S1 + (S1 << 2) + (S1 << 3))) >> 6) - S2 + (((S2 << 1) + S2) >> 4);
+          break;
+        default:
+          break;
+      }
+
+      out = sclip15(sclamp16(out));
+      S2 = S1;
+      S1 = out;
+      pSmp[i * 2 + nybble] = static_cast<s16>(out << 1);
+    }
+  }
+  *prev1 = S1;
+  *prev2 = S2;
+}
+
+// Random blocks whose header bytes cycle through all 256 values, so that every shift/range and
+// filter combination is decoded after a variety of filter histories
+std::vector<u8> makeBlocks(std::mt19937 &rng, size_t blockCount, size_t blockSize) {
+  std::vector<u8> blocks(blockCount * blockSize);
+  for (size_t b = 0; b < blockCount; b++) {
+    u8 *block = blocks.data() + b * blockSize;
+    for (size_t i = 0; i < blockSize; i++)
+      block[i] = static_cast<u8>(rng());
+    block[0] = static_cast<u8>(b);
+  }
+  return blocks;
+}
+
+// Decodes the blocks in runs of varying length, carrying the filter history between runs the
+// way a sample decoded in several calls would
+template <typename Decode>
+std::vector<s16> decodeInRuns(std::mt19937 &rng, const std::vector<u8> &blocks, size_t blockSize,
+                              size_t samplesPerBlock, Decode decode) {
+  const size_t blockCount = blocks.size() / blockSize;
+  std::vector<s16> out(blockCount * samplesPerBlock);
+  s32 prev[2] = {0, 0};
+  for (size_t b = 0; b < blockCount;) {
+    const size_t run = std::min<size_t>(blockCount - b, 1 + rng() % 64);
+    decode(blocks.data() + b * blockSize, run, out.data() + b * samplesPerBlock, prev);
+    b += run;
+  }
+  return out;
+}
+
+bool report(const char *name, const std::vector<s16> &expected, const std::vector<s16> &actual) {
+  const auto [e, a] = std::mismatch(expected.begin(), expected.end(), actual.begin());
+  if (e == expected.end()) {
+    std::printf("%s: %zu samples match\n", name, expected.size());
+    return true;
+  }
+  std::printf("%s: sample %zu decoded as %d, expected %d\n", name,
+              static_cast<size_t>(e - expected.begin()), *a, *e);
+  return false;
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(0x5eed);
+  constexpr size_t kBlocks = 256 * 64;
+  bool ok = true;
+
+  {
+    const auto blocks = makeBlocks(rng, kBlocks, PSXSamp::VAG_BLOCK_SIZE);
+    std::vector<s16> expected(kBlocks * PSXSamp::VAG_BLOCK_SAMPLES);
+    s32 prev[2] = {0, 0};
+    for (size_t b = 0; b < kBlocks; b++) {
+      referenceVAGBlock(blocks.data() + b * PSXSamp::VAG_BLOCK_SIZE,
+                        expected.data() + b * PSXSamp::VAG_BLOCK_SAMPLES, prev);
+    }
+    const auto actual = decodeInRuns(rng, blocks, PSXSamp::VAG_BLOCK_SIZE,
+                                     PSXSamp::VAG_BLOCK_SAMPLES,
+                                     [](const u8 *in, size_t count, s16 *out, s32 history[2]) {
+                                       PSXSamp::decodeVAGBlocks(in, count, out, history);
+                                     });
+    ok &= report("PSX ADPCM", expected, actual);
+  }
+
+  {
+    const auto blocks = makeBlocks(rng, kBlocks, SNESSamp::BRR_BLOCK_SIZE);
+    std::vector<s16> expected(kBlocks * SNESSamp::BRR_BLOCK_SAMPLES);
+    s32 prev1 = 0;
+    s32 prev2 = 0;
+    for (size_t b = 0; b < kBlocks; b++) {
+      referenceBRRBlock(blocks.data() + b * SNESSamp::BRR_BLOCK_SIZE,
+                        expected.data() + b * SNESSamp::BRR_BLOCK_SAMPLES, &prev1, &prev2);
+    }
+    const auto actual = decodeInRuns(rng, blocks, SNESSamp::BRR_BLOCK_SIZE,
+                                     SNESSamp::BRR_BLOCK_SAMPLES,
+                                     [](const u8 *in, size_t count, s16 *out, s32 history[2]) {
+                                       SNESSamp::decodeBRRBlocks(in, count, out, &history[0],
+                                                                 &history[1]);
+                                     });
+    ok &= report("SNES BRR", expected, actual);
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
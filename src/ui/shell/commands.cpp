@@ -8,6 +8,7 @@
 
 #include "base/Types.h"
 #include "DBGVGMRoot.h"
+#include "PcmCache.h"
 #include "RawFile.h"
 #include "SeqTrack.h"
 #include "StitchExport.h"
@@ -699,6 +700,30 @@ void collection_stitch(const std::vector<std::string>& args) {
   }
 }
 
+void pcmcache_stats(const std::vector<std::string>&) {
+  const auto stats = PcmCache::the().stats();
+  const size_t lookups = stats.hits + stats.misses;
+  fmt::print("Hits: {}\nMisses: {}\nHit rate: {:.1f}%\nEvictions: {}\n", stats.hits,
+             stats.misses, lookups ? 100.0 * stats.hits / lookups : 0.0, stats.evictions);
+  fmt::print("Entries: {}\nSize: {} / {} bytes\n", stats.entries, stats.bytes, stats.byteBudget);
+}
+
+void pcmcache_clear(const std::vector<std::string>&) {
+  PcmCache::the().clear();
+  PcmCache::the().resetStats();
+  fmt::println("Cleared the decoded sample cache.");
+}
+
+void pcmcache_budget(const std::vector<std::string>& args) {
+  try {
+    const size_t megabytes = std::stoul(args[2]);
+    PcmCache::the().setByteBudget(megabytes * 1024 * 1024);
+    fmt::println("Decoded sample cache budget set to {} MiB.", megabytes);
+  } catch (...) {
+    fmt::println("Invalid size");
+  }
+}
+
 void cmd_load(const std::vector<std::string>& args) {
   if (args.size() < 2) {
     fmt::println("Usage: load <path>");
@@ -824,6 +849,13 @@ void registerCommands() {
        {"events", "<index> <track_idx>", "List events in a sequence track", 4, sequence_events},
        {"export", "<index> <path>", "Export sequence as MIDI", 4, sequence_export}}};
 
+  commandRegistry["pcmcache"] = {
+      "pcmcache",
+      "Inspect the decoded sample cache",
+      {{"stats", "", "Show hit/miss counters and memory use", 2, pcmcache_stats},
+       {"clear", "", "Drop all cached samples and reset the counters", 2, pcmcache_clear},
+       {"budget", "<MiB>", "Set the maximum size of the cache (0 turns it off)", 3, pcmcache_budget}}};
+
   commandRegistry["help"] = {"help", "Show this help", {}};
   commandRegistry["exit"] = {"exit", "Exit the shell", {}};
   commandRegistry["quit"] = {"quit", "Exit the shell", {}};
@@ -0,0 +1,200 @@
+/**
+ * VGMTrans (c) - 2002-2026
+ * Licensed under the zlib license
+ * See the included LICENSE for more information
+ */
+
+#include "convert.h"
+
+#include "base/Types.h"
+#include "DBGVGMRoot.h"
+#include "RawFile.h"
+#include "VGMColl.h"
+#include "VGMExport.h"
+#include "VGMFile.h"
+#include "util/Parallel.h"
+#include "util/Path.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fmt/base.h>
+#include <fmt/format.h>
+
+namespace {
+
+struct ConvertOptions {
+  std::vector<std::filesystem::path> inputs;
+  std::filesystem::path outputDir;
+  unsigned jobs = vgmtrans::defaultThreadCount();
+  u32 targets = static_cast<u32>(conversion::Target::MIDI) | static_cast<u32>(conversion::Target::SF2);
+};
+
+bool parseTargets(const std::string& list, u32& targets) {
+  targets = 0;
+  std::stringstream stream(list);
+  std::string name;
+  while (std::getline(stream, name, ',')) {
+    if (name == "midi") {
+      targets |= static_cast<u32>(conversion::Target::MIDI);
+    } else if (name == "sf2") {
+      targets |= static_cast<u32>(conversion::Target::SF2);
+    } else if (name == "dls") {
+      targets |= static_cast<u32>(conversion::Target::DLS);
+    } else {
+      fmt::println(stderr, "Unknown format: {}", name);
+      return false;
+    }
+  }
+  return targets != 0;
+}
+
+bool parseConvertArgs(const std::vector<std::string>& args, ConvertOptions& options) {
+  for (size_t i = 1; i < args.size(); ++i) {
+    const std::string& arg = args[i];
+    const bool hasValue = i + 1 < args.size();
+    if ((arg == "-j" || arg == "--jobs") && hasValue) {
+      try {
+        options.jobs = std::max(1u, static_cast<unsigned>(std::stoul(args[++i])));
+      } catch (...) {
+        fmt::println(stderr, "Invalid job count: {}", args[i]);
+        return false;
+      }
+    } else if ((arg == "-o" || arg == "--output") && hasValue) {
+      options.outputDir = args[++i];
+    } else if (arg == "--formats" && hasValue) {
+      if (!parseTargets(args[++i], options.targets)) {
+        return false;
+      }
+    } else if (!arg.empty() && arg[0] == '-') {
+      fmt::println(stderr, "Unknown option: {}", arg);
+      return false;
+    } else {
+      options.inputs.emplace_back(arg);
+    }
+  }
+  return !options.inputs.empty() && !options.outputDir.empty();
+}
+
+// saveAs takes its targets as a template argument; the MIDI and DLS targets also affect the
+// conversion context, so the whole target set has to be passed in a single call. Returns false
+// if any of the files could not be written.
+bool exportCollection(const VGMColl& coll, const std::filesystem::path& dir, u32 targets) {
+  using conversion::Target;
+  using conversion::saveAs;
+
+  if (!coll.seq()) {
+    targets &= ~static_cast<u32>(Target::MIDI);
+  }
+
+  switch (targets) {
+    case 1: return saveAs<Target::MIDI>(coll, dir);
+    case 2: return saveAs<Target::DLS>(coll, dir);
+    case 3: return saveAs<Target::MIDI | Target::DLS>(coll, dir);
+    case 4: return saveAs<Target::SF2>(coll, dir);
+    case 5: return saveAs<Target::MIDI | Target::SF2>(coll, dir);
+    case 6: return saveAs<Target::DLS | Target::SF2>(coll, dir);
+    case 7: return saveAs<Target::MIDI | Target::DLS | Target::SF2>(coll, dir);
+    default: return true;
+  }
+}
+
+}  // namespace
+
+void printConvertUsage() {
+  fmt::println("Usage: vgmtrans-cli convert [--jobs <n>] [--formats <midi,sf2,dls>] -o <dir> <inputs...>");
+  fmt::println("");
+  fmt::println("Loads and scans every input, then exports each collection found in it to");
+  fmt::println("<dir>/<input name>/. Inputs are processed by <n> workers (default: one per core).");
+  fmt::println("The default formats are midi,sf2.");
+}
+
+int cmd_convert(const std::vector<std::string>& args) {
+  ConvertOptions options;
+  if (!parseConvertArgs(args, options)) {
+    printConvertUsage();
+    return 2;
+  }
+
+  // The root and the format matchers aren't thread-safe, so inputs are loaded and scanned one
+  // at a time. Exporting works on detached files and runs concurrently on the workers.
+  std::mutex rootMutex;
+  std::mutex outputMutex;
+  std::atomic<size_t> finished{0};
+  std::atomic<size_t> failed{0};
+  const size_t total = options.inputs.size();
+
+  vgmtrans::parallelFor(total, options.jobs, [&](size_t i) {
+    const std::filesystem::path& input = options.inputs[i];
+    // Open the input here rather than through openRawFile(), which also returns false for a
+    // readable file that holds nothing recognized
+    std::unique_ptr<RawFile> rawFile;
+    std::string openError;
+    try {
+      rawFile = std::make_unique<DiskFile>(input);
+    } catch (const std::exception& e) {
+      openError = e.what();
+    }
+
+    VGMRoot::DetachedFiles files;
+    const bool loaded = rawFile != nullptr;
+    if (loaded) {
+      std::lock_guard lock(rootMutex);
+      dbgRoot.loadRawFile(std::move(rawFile));
+      files = dbgRoot.detachAllFilesAndCollections();
+    }
+
+    size_t exported = 0;
+    size_t notWritten = 0;
+    std::string error;
+    if (loaded && !files.colls.empty()) {
+      try {
+        const auto dir = options.outputDir / makeSafeFileName(pathToUtf8String(input.filename()));
+        std::filesystem::create_directories(dir);
+        for (const auto& coll : files.colls) {
+          if (exportCollection(*coll, dir, options.targets)) {
+            exported++;
+          } else {
+            notWritten++;
+          }
+        }
+      } catch (const std::exception& e) {
+        error = e.what();
+      }
+    }
+
+    // Release this input's files before reporting, so the next one starts from a clean slate
+    files.clear();
+
+    const size_t done = ++finished;
+    std::lock_guard lock(outputMutex);
+    if (!loaded) {
+      failed++;
+      fmt::println("[{}/{}] {}: failed: could not be opened: {}", done, total,
+                   pathToUtf8String(input), openError);
+    } else if (!error.empty()) {
+      failed++;
+      fmt::println("[{}/{}] {}: failed: {}", done, total, pathToUtf8String(input), error);
+    } else if (notWritten != 0) {
+      failed++;
+      fmt::println("[{}/{}] {}: failed: {} of {} collection(s) could not be written", done, total,
+                   pathToUtf8String(input), notWritten, notWritten + exported);
+    } else if (exported == 0) {
+      fmt::println("[{}/{}] {}: no collections found", done, total, pathToUtf8String(input));
+    } else {
+      fmt::println("[{}/{}] {}: exported {} collection(s)", done, total, pathToUtf8String(input),
+                   exported);
+    }
+    std::fflush(stdout);
+  });
+
+  fmt::println("Converted {} of {} input(s).", total - failed, total);
+  return failed == 0 ? 0 : 1;
+}
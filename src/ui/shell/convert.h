@@ -0,0 +1,16 @@
+/**
+ * VGMTrans (c) - 2002-2026
+ * Licensed under the zlib license
+ * See the included LICENSE for more information
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Batch conversion: convert [--jobs <n>] [--formats <midi,sf2,dls>] -o <dir> <inputs...>
+// Each input is loaded and scanned on its own, then all of its collections are exported to
+// <dir>/<input name>/ and the input is released before the worker moves on.
+int cmd_convert(const std::vector<std::string>& args);
+void printConvertUsage();
@@ -0,0 +1,44 @@
+/**
+ * VGMTrans (c) - 2002-2026
+ * Licensed under the zlib license
+ * See the included LICENSE for more information
+ */
+
+#include <string>
+#include <vector>
+
+#include <fmt/base.h>
+
+#include "DBGVGMRoot.h"
+#include "convert.h"
+
+void printHelp() {
+  fmt::println("VGMTrans CLI runs batch jobs over music rips without an interactive session.");
+  fmt::println("");
+  fmt::println("Usage: vgmtrans-cli <command> [args...]");
+  fmt::println("");
+  fmt::println("Commands:");
+  fmt::println("  convert    Export the collections found in each input as MIDI/SF2/DLS");
+  fmt::println("");
+  printConvertUsage();
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<std::string> args(argv + 1, argv + argc);
+  if (args.empty() || args[0] == "-h" || args[0] == "--help" || args[0] == "help") {
+    printHelp();
+    return args.empty() ? 2 : 0;
+  }
+
+  if (!dbgRoot.init()) {
+    fmt::println(stderr, "Failed to init VGMRoot");
+    return 1;
+  }
+
+  if (args[0] == "convert") {
+    return cmd_convert(args);
+  }
+
+  fmt::println(stderr, "Unknown command: {}. Try 'vgmtrans-cli --help'.", args[0]);
+  return 2;
+}
@@ -248,6 +248,8 @@ void pageLargeOutput(const std::string& output) {
 void printHelp() {
   fmt::println("VGMTrans shell is an interactive command-line interface for inspecting loaded music data and exporting it.");
   fmt::println("");
+  fmt::println("Usage: vgmtrans-shell [--scan-threads <n>] [files...]");
+  fmt::println("");
   cmd_help({});
 }
 
@@ -305,7 +307,16 @@ int main(int argc, char* argv[]) {
 
   // Auto-load files passed as arguments
   for (int i = 1; i < argc; ++i) {
-    std::vector<std::string> loadArgs = {"load", argv[i]};
+    std::string arg(argv[i]);
+    if (arg == "--scan-threads" && i + 1 < argc) {
+      try {
+        dbgRoot.setScanThreadCount(static_cast<unsigned>(std::stoul(argv[++i])));
+      } catch (...) {
+        fmt::println(stderr, "Invalid scan thread count: {}", argv[i]);
+      }
+      continue;
+    }
+    std::vector<std::string> loadArgs = {"load", arg};
     cmd_load(loadArgs);
   }
 